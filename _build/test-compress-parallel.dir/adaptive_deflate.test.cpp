@@ -0,0 +1,71 @@
+#include <neo/adaptive_deflate.hpp>
+
+#include <neo/gzip_io.hpp>
+#include <neo/string_io.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+namespace {
+
+std::string make_text() {
+    std::string text;
+    for (auto i = 0; i < 2000; ++i) {
+        text += "Line " + std::to_string(i) + " of some log output that we want to ship\n";
+    }
+    return text;
+}
+
+}  // namespace
+
+TEST_CASE("Lower the level when we cannot meet the target") {
+    std::vector<neo::adaptive_level_decision> decisions;
+
+    neo::adaptive_level_options opts;
+    // An impossibly high target
+    opts.target_bytes_per_second = 1e18;
+    opts.block_size              = 4096;
+    opts.initial.level           = 6;
+
+    neo::string_dynbuf_io   gz_data;
+    neo::adaptive_gzip_sink gz_out{gz_data, opts, [&](const neo::adaptive_level_decision& d) {
+                                       decisions.push_back(d);
+                                   }};
+    const auto              text = make_text();
+    neo::buffer_copy(gz_out, neo::const_buffer(text));
+    gz_out.finish();
+
+    REQUIRE(decisions.size() > 5);
+    CHECK(decisions.front().old_level == 6);
+    CHECK(decisions.front().new_level == 5);
+    CHECK(decisions.back().new_level == 1);
+    CHECK(gz_out.controller().current_level() == 1);
+    CHECK(gz_out.controller().last_decision().has_value());
+
+    neo::string_dynbuf_io plain;
+    neo::gzip_decompress(plain, gz_data);
+    CHECK(plain.string() == text);
+}
+
+TEST_CASE("Raise the level when we have time to spare") {
+    neo::adaptive_level_options opts;
+    // An extremely low target
+    opts.target_bytes_per_second = 1;
+    opts.block_size              = 4096;
+    opts.initial.level           = 1;
+    opts.max_level               = 7;
+
+    neo::gzip_compressor<neo::adaptive_deflate_compressor> comp{
+        neo::adaptive_deflate_compressor{opts}};
+    neo::string_dynbuf_io gz_data;
+    const auto            text = make_text();
+    auto res = neo::buffer_transform(comp, gz_data, neo::const_buffer(text));
+    res += neo::buffer_transform(comp, gz_data, neo::const_buffer(), neo::flush::finish);
+    CHECK(res.done);
+    CHECK(comp.compressor().current_level() == 7);
+
+    neo::string_dynbuf_io plain;
+    neo::gzip_decompress(plain, gz_data);
+    CHECK(plain.string() == text);
+}
@@ -0,0 +1,245 @@
+#include "./adler32.hpp"
+
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define NEO_ADLER32_HAVE_SIMD 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define NEO_ADLER32_TARGET_SSSE3
+#define NEO_ADLER32_TARGET_AVX2
+#else
+#include <cpuid.h>
+#define NEO_ADLER32_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define NEO_ADLER32_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#else
+#define NEO_ADLER32_HAVE_SIMD 0
+#endif
+
+using namespace neo;
+
+namespace {
+
+constexpr std::uint32_t base = detail::adler32_base;
+
+/**
+ * The most bytes that can be summed before the second sum must be reduced
+ * modulo the base to avoid overflowing 32 bits.
+ */
+constexpr std::size_t nmax = 5552;
+
+std::uint32_t
+adler32_scalar(std::uint32_t adler, const std::byte* data, std::size_t size) noexcept {
+    std::uint32_t a = adler & 0xffff;
+    std::uint32_t b = adler >> 16;
+    while (size) {
+        auto n = std::min(size, nmax);
+        size -= n;
+        while (n >= 8) {
+            a += std::uint32_t(data[0]);
+            b += a;
+            a += std::uint32_t(data[1]);
+            b += a;
+            a += std::uint32_t(data[2]);
+            b += a;
+            a += std::uint32_t(data[3]);
+            b += a;
+            a += std::uint32_t(data[4]);
+            b += a;
+            a += std::uint32_t(data[5]);
+            b += a;
+            a += std::uint32_t(data[6]);
+            b += a;
+            a += std::uint32_t(data[7]);
+            b += a;
+            data += 8;
+            n -= 8;
+        }
+        while (n--) {
+            a += std::uint32_t(*data++);
+            b += a;
+        }
+        a %= base;
+        b %= base;
+    }
+    return (b << 16) | a;
+}
+
+#if NEO_ADLER32_HAVE_SIMD
+
+struct cpu_features {
+    bool ssse3 = false;
+    bool avx2  = false;
+};
+
+cpu_features detect_cpu_features() noexcept {
+    cpu_features ret;
+#if defined(_MSC_VER) && !defined(__clang__)
+    int regs[4] = {};
+    ::__cpuid(regs, 0);
+    const int max_leaf = regs[0];
+    ::__cpuid(regs, 1);
+    const auto ecx = static_cast<unsigned int>(regs[2]);
+    unsigned   ebx7 = 0;
+    if (max_leaf >= 7) {
+        ::__cpuidex(regs, 7, 0);
+        ebx7 = static_cast<unsigned int>(regs[1]);
+    }
+    const bool os_saves_ymm = (ecx & (1u << 27)) && (::_xgetbv(0) & 0b110) == 0b110;
+#else
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (!::__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return ret;
+    }
+    unsigned int ebx7 = 0;
+    unsigned int eax7 = 0, ecx7 = 0, edx7 = 0;
+    if (!::__get_cpuid_count(7, 0, &eax7, &ebx7, &ecx7, &edx7)) {
+        ebx7 = 0;
+    }
+    bool os_saves_ymm = false;
+    if (ecx & (1u << 27)) {
+        // OSXSAVE: Check that the OS preserves the SSE and AVX registers
+        unsigned int xcr0_lo = 0, xcr0_hi = 0;
+        __asm__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+        os_saves_ymm = (xcr0_lo & 0b110) == 0b110;
+    }
+#endif
+    ret.ssse3 = ecx & (1u << 9);
+    ret.avx2  = os_saves_ymm && (ebx7 & (1u << 5));
+    return ret;
+}
+
+/**
+ * Adler-32 of 32-byte blocks with SSSE3. For each block, the first sum gains
+ * the sum of the bytes, and the second sum gains each byte weighted by its
+ * distance from the end of the block, plus 32 times the first sum as it was
+ * before the block. The weighted sums use pmaddubsw, and the plain sums use
+ * psadbw. Returns the checksum with the blocks included; the caller handles
+ * the trailing `size % 32` bytes.
+ */
+NEO_ADLER32_TARGET_SSSE3 std::uint32_t
+adler32_ssse3_blocks(std::uint32_t adler, const std::byte* data, std::size_t n_blocks) noexcept {
+    std::uint32_t a = adler & 0xffff;
+    std::uint32_t b = adler >> 16;
+
+    const __m128i tap1
+        = _mm_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17);
+    const __m128i tap2 = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(1);
+
+    while (n_blocks) {
+        auto n = std::min(n_blocks, nmax / 32);
+        n_blocks -= n;
+
+        // The first sum before each block, which is added to the second sum 32 times per block
+        __m128i v_prev_a = _mm_set_epi32(0, 0, 0, static_cast<int>(a * n));
+        __m128i v_b      = _mm_set_epi32(0, 0, 0, static_cast<int>(b));
+        __m128i v_a      = zero;
+        do {
+            const __m128i bytes1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+            const __m128i bytes2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16));
+            v_prev_a             = _mm_add_epi32(v_prev_a, v_a);
+
+            v_a = _mm_add_epi32(v_a, _mm_sad_epu8(bytes1, zero));
+            v_b = _mm_add_epi32(v_b, _mm_madd_epi16(_mm_maddubs_epi16(bytes1, tap1), ones));
+            v_a = _mm_add_epi32(v_a, _mm_sad_epu8(bytes2, zero));
+            v_b = _mm_add_epi32(v_b, _mm_madd_epi16(_mm_maddubs_epi16(bytes2, tap2), ones));
+            data += 32;
+        } while (--n);
+        v_b = _mm_add_epi32(v_b, _mm_slli_epi32(v_prev_a, 5));
+
+        // Sum the lanes
+        v_a = _mm_add_epi32(v_a, _mm_shuffle_epi32(v_a, _MM_SHUFFLE(2, 3, 0, 1)));
+        v_a = _mm_add_epi32(v_a, _mm_shuffle_epi32(v_a, _MM_SHUFFLE(1, 0, 3, 2)));
+        a += static_cast<std::uint32_t>(_mm_cvtsi128_si32(v_a));
+        v_b = _mm_add_epi32(v_b, _mm_shuffle_epi32(v_b, _MM_SHUFFLE(2, 3, 0, 1)));
+        v_b = _mm_add_epi32(v_b, _mm_shuffle_epi32(v_b, _MM_SHUFFLE(1, 0, 3, 2)));
+        b = static_cast<std::uint32_t>(_mm_cvtsi128_si32(v_b));
+
+        a %= base;
+        b %= base;
+    }
+    return (b << 16) | a;
+}
+
+/// Sum the 32-bit lanes of the given vector
+NEO_ADLER32_TARGET_AVX2 std::uint32_t hsum_avx2(__m256i v) noexcept {
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    s         = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+    s         = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+    return static_cast<std::uint32_t>(_mm_cvtsi128_si32(s));
+}
+
+/// The same as adler32_ssse3_blocks(), with each block in a single 256-bit register
+NEO_ADLER32_TARGET_AVX2 std::uint32_t
+adler32_avx2_blocks(std::uint32_t adler, const std::byte* data, std::size_t n_blocks) noexcept {
+    std::uint32_t a = adler & 0xffff;
+    std::uint32_t b = adler >> 16;
+
+    const __m256i tap  = _mm256_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19,
+                                         18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3,
+                                         2, 1);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ones = _mm256_set1_epi16(1);
+
+    while (n_blocks) {
+        auto n = std::min(n_blocks, nmax / 32);
+        n_blocks -= n;
+
+        __m256i v_prev_a = _mm256_setr_epi32(static_cast<int>(a * n), 0, 0, 0, 0, 0, 0, 0);
+        __m256i v_b      = _mm256_setr_epi32(static_cast<int>(b), 0, 0, 0, 0, 0, 0, 0);
+        __m256i v_a      = zero;
+        do {
+            const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+            v_prev_a            = _mm256_add_epi32(v_prev_a, v_a);
+            v_a                 = _mm256_add_epi32(v_a, _mm256_sad_epu8(bytes, zero));
+            const __m256i taps  = _mm256_madd_epi16(_mm256_maddubs_epi16(bytes, tap), ones);
+            v_b                 = _mm256_add_epi32(v_b, taps);
+            data += 32;
+        } while (--n);
+        v_b = _mm256_add_epi32(v_b, _mm256_slli_epi32(v_prev_a, 5));
+
+        a = (a + hsum_avx2(v_a)) % base;
+        b = hsum_avx2(v_b) % base;
+    }
+    return (b << 16) | a;
+}
+
+template <auto Blocks>
+std::uint32_t adler32_simd(std::uint32_t adler, const std::byte* data, std::size_t size) noexcept {
+    if (size < 64) {
+        // Not worth the setup cost
+        return adler32_scalar(adler, data, size);
+    }
+    const auto n_blocks = size / 32;
+    adler               = Blocks(adler, data, n_blocks);
+    return adler32_scalar(adler, data + n_blocks * 32, size % 32);
+}
+
+#endif
+
+using adler32_impl_fn = std::uint32_t (*)(std::uint32_t, const std::byte*, std::size_t) noexcept;
+
+adler32_impl_fn select_adler32_impl() noexcept {
+#if NEO_ADLER32_HAVE_SIMD
+    const auto features = detect_cpu_features();
+    if (features.avx2) {
+        return &adler32_simd<&adler32_avx2_blocks>;
+    }
+    if (features.ssse3) {
+        return &adler32_simd<&adler32_ssse3_blocks>;
+    }
+#endif
+    return &adler32_scalar;
+}
+
+}  // namespace
+
+std::uint32_t
+neo::detail::adler32_update(std::uint32_t adler, const std::byte* data, std::size_t size) noexcept {
+    static const adler32_impl_fn impl = select_adler32_impl();
+    return impl(adler, data, size);
+}
@@ -0,0 +1,617 @@
+/**
+ * Throughput benchmarks for the codecs, checksums, and tar pipelines in this
+ * library, run over a generated corpus.
+ *
+ * Each measurement is written as a single line of JSON, in a stable order, so
+ * that the output of two runs can be compared with `diff` or loaded into a
+ * script. A human-readable summary is written to stderr.
+ *
+ * Usage: neo-compress-bench [--filter <substring>] [--min-time <seconds>]
+ *                           [--corpus-mib <MiB>] [--out <file>] [--list]
+ */
+
+#include <neo/adler32.hpp>
+#include <neo/crc32.hpp>
+#include <neo/deflate.hpp>
+#include <neo/gzip_io.hpp>
+#include <neo/inflate.hpp>
+#include <neo/tar/ustar.hpp>
+#include <neo/tar/util.hpp>
+
+#include <neo/buffer_range.hpp>
+#include <neo/string_io.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct bench_options {
+    std::string filter;
+    double      min_time   = 0.25;
+    std::size_t corpus_mib = 8;
+    std::string out_path;
+    bool        list_only = false;
+};
+
+/// The work done by one run of a benchmark body
+struct work {
+    // Uncompressed bytes processed
+    std::uint64_t bytes = 0;
+    // Calls to the operation under test
+    std::uint64_t calls = 0;
+};
+
+struct measurement {
+    std::string   name;
+    std::uint64_t iterations = 0;
+    std::uint64_t bytes      = 0;
+    std::uint64_t calls      = 0;
+    double        seconds    = 0;
+
+    double mb_per_s() const noexcept { return seconds ? bytes / seconds / 1e6 : 0; }
+    double ns_per_call() const noexcept { return calls ? seconds * 1e9 / calls : 0; }
+};
+
+/**
+ * Runs benchmark bodies and reports the results. A body is run repeatedly
+ * until it has taken at least `min_time` in total.
+ */
+class bench_runner {
+    bench_options _opts;
+    std::ostream& _out;
+
+public:
+    bench_runner(const bench_options& opts, std::ostream& out)
+        : _opts(opts)
+        , _out(out) {}
+
+    bool list_only() const noexcept { return _opts.list_only; }
+
+    bool selected(std::string_view name) const noexcept {
+        return _opts.filter.empty() || name.find(_opts.filter) != name.npos;
+    }
+
+    void run(const std::string& name, const std::function<work()>& body) {
+        if (!selected(name)) {
+            return;
+        }
+        if (_opts.list_only) {
+            _out << name << '\n';
+            return;
+        }
+        using clock = std::chrono::steady_clock;
+        measurement m;
+        m.name = name;
+        // One untimed run to warm the caches and the allocator
+        body();
+        const auto start = clock::now();
+        do {
+            auto w = body();
+            m.bytes += w.bytes;
+            m.calls += w.calls;
+            ++m.iterations;
+            m.seconds = std::chrono::duration<double>(clock::now() - start).count();
+        } while (m.seconds < _opts.min_time);
+        _report(m);
+    }
+
+private:
+    void _report(const measurement& m) {
+        char line[512];
+        std::snprintf(line,
+                      sizeof line,
+                      "{\"name\": \"%s\", \"iterations\": %llu, \"bytes\": %llu, "
+                      "\"calls\": %llu, \"seconds\": %.6f, \"mb_per_s\": %.2f, "
+                      "\"ns_per_call\": %.1f}",
+                      m.name.c_str(),
+                      static_cast<unsigned long long>(m.iterations),
+                      static_cast<unsigned long long>(m.bytes),
+                      static_cast<unsigned long long>(m.calls),
+                      m.seconds,
+                      m.mb_per_s(),
+                      m.ns_per_call());
+        _out << line << std::endl;
+        std::fprintf(stderr,
+                     "%-52s %10.2f MB/s %12.1f ns/call\n",
+                     m.name.c_str(),
+                     m.mb_per_s(),
+                     m.ns_per_call());
+    }
+};
+
+/// A buffer_sink that throws away everything written to it
+class discard_sink {
+    std::vector<std::byte> _area;
+
+public:
+    neo::mutable_buffer prepare(std::size_t n) {
+        if (_area.size() < n) {
+            _area.resize(n);
+        }
+        return neo::mutable_buffer(_area.data(), n);
+    }
+
+    void commit(std::size_t) noexcept {}
+};
+
+/// A buffer_source over a buffer that gives out at most `chunk_size` bytes at a time
+class chunked_source {
+    neo::const_buffer _data;
+    std::size_t       _chunk_size;
+
+public:
+    chunked_source(neo::const_buffer data, std::size_t chunk_size)
+        : _data(data)
+        , _chunk_size(chunk_size) {}
+
+    neo::const_buffer next(std::size_t n) const noexcept {
+        return _data.first(std::min({n, _chunk_size, _data.size()}));
+    }
+
+    void consume(std::size_t n) noexcept { _data += n; }
+};
+
+/// English-like text: Words of skewed frequency, in lines of varying length
+std::string make_text(std::size_t size, std::mt19937_64& rng) {
+    static const char* const words[]
+        = {"the",    "of",      "and",    "to",        "in",       "is",     "that",   "for",
+           "it",     "with",    "as",     "was",       "on",       "be",     "by",     "this",
+           "are",    "from",    "or",     "which",     "buffer",   "stream", "deflate",
+           "header", "archive", "member", "directory", "compress", "output", "window", "block",
+           "input",  "checksum"};
+    constexpr auto n_words = sizeof(words) / sizeof(words[0]);
+    // Squaring a uniform variable favors the words at the front of the list
+    std::uniform_real_distribution<double> pick{0, 1};
+    std::string                            ret;
+    ret.reserve(size + 64);
+    std::size_t line_len = 0;
+    while (ret.size() < size) {
+        const auto u = pick(rng);
+        ret += words[static_cast<std::size_t>(u * u * n_words)];
+        line_len += 1;
+        if (line_len > 8 + rng() % 8) {
+            ret += ".\n";
+            line_len = 0;
+        } else {
+            ret += ' ';
+        }
+    }
+    ret.resize(size);
+    return ret;
+}
+
+/// Binary records, such as from a database or a telemetry log: Moderately compressible
+std::string make_binary(std::size_t size, std::mt19937_64& rng) {
+    std::string   ret;
+    std::uint64_t timestamp = 1'600'000'000'000;
+    std::uint32_t counter   = 0;
+    ret.reserve(size + 32);
+    while (ret.size() < size) {
+        timestamp += rng() % 1000;
+        counter += static_cast<std::uint32_t>(rng() % 4);
+        const float         reading = static_cast<float>(rng() % 10000) / 100.0f;
+        const std::uint16_t kind    = static_cast<std::uint16_t>(rng() % 6);
+        ret.append(reinterpret_cast<const char*>(&timestamp), sizeof timestamp);
+        ret.append(reinterpret_cast<const char*>(&counter), sizeof counter);
+        ret.append(reinterpret_cast<const char*>(&reading), sizeof reading);
+        ret.append(reinterpret_cast<const char*>(&kind), sizeof kind);
+        ret.append(6, '\0');
+    }
+    ret.resize(size);
+    return ret;
+}
+
+/// Uniformly random bytes, which do not compress at all
+std::string make_incompressible(std::size_t size, std::mt19937_64& rng) {
+    std::string ret;
+    ret.resize(size);
+    for (auto& c : ret) {
+        c = static_cast<char>(rng());
+    }
+    return ret;
+}
+
+struct corpus_entry {
+    std::string name;
+    std::string data;
+    // The data compressed as raw DEFLATE, and as gzip, both at the default level
+    std::string deflated;
+    std::string gzipped;
+};
+
+std::string deflate_all(neo::const_buffer in) {
+    neo::deflate_compressor comp;
+    std::string             out;
+    out.resize(in.size() + in.size() / 8 + 1024);
+    auto res = comp(neo::mutable_buffer(out), in, neo::flush::finish);
+    if (!res.done) {
+        throw std::runtime_error("Failed to deflate the benchmark corpus");
+    }
+    out.resize(res.bytes_written);
+    return out;
+}
+
+std::string gzip_all(neo::const_buffer in) {
+    neo::string_dynbuf_io out;
+    neo::gzip_compress(out, in);
+    return std::string(out.read_area_view());
+}
+
+std::vector<corpus_entry> make_corpus(std::size_t size) {
+    std::mt19937_64           rng{1729};
+    std::vector<corpus_entry> ret;
+    ret.push_back({"text", make_text(size, rng), {}, {}});
+    ret.push_back({"binary", make_binary(size, rng), {}, {}});
+    ret.push_back({"incompressible", make_incompressible(size, rng), {}, {}});
+    for (auto& ent : ret) {
+        ent.deflated = deflate_all(neo::const_buffer(ent.data));
+        ent.gzipped  = gzip_all(neo::const_buffer(ent.data));
+    }
+    return ret;
+}
+
+void write_file(const fs::path& path, std::string_view data) {
+    fs::create_directories(path.parent_path());
+    std::ofstream out{path, std::ios::binary};
+    out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    if (!out) {
+        throw std::runtime_error("Failed to write benchmark file " + path.string());
+    }
+}
+
+/**
+ * Create a directory tree of `n_files` files totalling roughly `total_size`
+ * bytes, with a mix of text and binary content. Returns the total size.
+ */
+std::uint64_t make_tree(const fs::path& root, std::size_t n_files, std::size_t total_size) {
+    std::mt19937_64 rng{n_files};
+    std::uint64_t   written   = 0;
+    const auto      file_size = std::max(std::size_t(1), total_size / n_files);
+    for (auto i = 0u; i < n_files; ++i) {
+        // Vary the sizes around the average, and spread the files over some subdirectories
+        const auto size = file_size / 2 + rng() % file_size;
+        const auto data = (i % 3 == 2) ? make_binary(size, rng) : make_text(size, rng);
+        write_file(root / ("dir-" + std::to_string(i % 16)) / ("file-" + std::to_string(i)),
+                   data);
+        written += data.size();
+    }
+    return written;
+}
+
+/// A temporary directory that is removed on destruction
+class temp_dir {
+    fs::path _path;
+
+public:
+    temp_dir() {
+        std::random_device rd;
+        _path = fs::temp_directory_path() / ("neo-compress-bench-" + std::to_string(rd()));
+        fs::create_directories(_path);
+    }
+    ~temp_dir() {
+        std::error_code ec;
+        fs::remove_all(_path, ec);
+    }
+    temp_dir(const temp_dir&) = delete;
+    temp_dir& operator=(const temp_dir&) = delete;
+
+    const fs::path& path() const noexcept { return _path; }
+};
+
+const std::size_t buffer_sizes[] = {1024 * 4, 1024 * 64, 1024 * 1024};
+
+std::string bench_name(std::string_view what,
+                       std::string_view corpus,
+                       std::size_t      buffer_size,
+                       std::string_view param = {}) {
+    auto ret = std::string(what) + "/" + std::string(corpus) + "/" + std::to_string(buffer_size);
+    if (!param.empty()) {
+        ret += "/" + std::string(param);
+    }
+    return ret;
+}
+
+/**
+ * Run a compressor over `in`, handing it at most `out.size()` bytes of input
+ * and output per call, and discarding the output. Returns the number of calls.
+ */
+template <typename Compressor>
+std::uint64_t run_compressor(Compressor& comp, neo::const_buffer in, std::vector<std::byte>& out) {
+    std::uint64_t calls = 0;
+    while (true) {
+        const auto part = in.first(std::min(in.size(), out.size()));
+        const auto f    = part.size() == in.size() ? neo::flush::finish : neo::flush::no_flush;
+        auto       res  = comp(neo::mutable_buffer(out.data(), out.size()), part, f);
+        ++calls;
+        in += res.bytes_read;
+        if (res.done) {
+            return calls;
+        }
+    }
+}
+
+/// The same as run_compressor(), for a decompressor
+template <typename Decompressor>
+std::uint64_t
+run_decompressor(Decompressor& decomp, neo::const_buffer in, std::vector<std::byte>& out) {
+    std::uint64_t calls = 0;
+    while (true) {
+        const auto part = in.first(std::min(in.size(), out.size()));
+        auto       res  = decomp(neo::mutable_buffer(out.data(), out.size()), part);
+        ++calls;
+        in += res.bytes_read;
+        if (res.done) {
+            return calls;
+        }
+        if (res.bytes_read == 0 && res.bytes_written == 0) {
+            throw std::runtime_error("Benchmark data was truncated");
+        }
+    }
+}
+
+void bench_deflate(bench_runner& r, const std::vector<corpus_entry>& corpus) {
+    for (auto& ent : corpus) {
+        for (auto bufsize : buffer_sizes) {
+            for (int level = 0; level <= 9; ++level) {
+                const auto name
+                    = bench_name("deflate", ent.name, bufsize, "level=" + std::to_string(level));
+                r.run(name, [&] {
+                    neo::deflate_compressor comp{neo::deflate_options{.level = level}};
+                    std::vector<std::byte>  out(bufsize);
+                    auto calls = run_compressor(comp, neo::const_buffer(ent.data), out);
+                    return work{ent.data.size(), calls};
+                });
+            }
+        }
+    }
+}
+
+void bench_inflate(bench_runner& r, const std::vector<corpus_entry>& corpus) {
+    for (auto& ent : corpus) {
+        for (auto bufsize : buffer_sizes) {
+            r.run(bench_name("inflate", ent.name, bufsize), [&] {
+                neo::inflate_decompressor decomp;
+                std::vector<std::byte>    out(bufsize);
+                auto calls = run_decompressor(decomp, neo::const_buffer(ent.deflated), out);
+                return work{ent.data.size(), calls};
+            });
+        }
+    }
+}
+
+void bench_gzip_io(bench_runner& r, const std::vector<corpus_entry>& corpus) {
+    for (auto& ent : corpus) {
+        for (auto bufsize : buffer_sizes) {
+            r.run(bench_name("gzip_sink", ent.name, bufsize), [&] {
+                discard_sink   out;
+                neo::gzip_sink gz_out{out};
+                auto           in    = neo::const_buffer(ent.data);
+                std::uint64_t  calls = 0;
+                while (!in.empty()) {
+                    const auto part = in.first(std::min(in.size(), bufsize));
+                    neo::buffer_copy(gz_out, part);
+                    in += part.size();
+                    ++calls;
+                }
+                gz_out.finish();
+                return work{ent.data.size(), calls};
+            });
+            r.run(bench_name("gzip_source", ent.name, bufsize), [&] {
+                neo::gzip_source gz_in{chunked_source{neo::const_buffer(ent.gzipped), bufsize}};
+                std::uint64_t    n_read = 0;
+                std::uint64_t    calls  = 0;
+                while (true) {
+                    auto part = gz_in.next(bufsize);
+                    ++calls;
+                    const auto n = neo::buffer_size(part);
+                    if (n == 0) {
+                        break;
+                    }
+                    gz_in.consume(n);
+                    n_read += n;
+                }
+                if (n_read != ent.data.size()) {
+                    throw std::runtime_error("gzip_source benchmark read the wrong amount of data");
+                }
+                return work{n_read, calls};
+            });
+        }
+    }
+}
+
+// Checksums are stored here so that the compiler cannot discard their computation
+volatile std::uint32_t checksum_sink = 0;
+
+void bench_checksums(bench_runner& r, const std::vector<corpus_entry>& corpus) {
+    // Checksums do not care about the content, but small feeds are common
+    const auto& data = corpus.front().data;
+    const std::size_t sizes[] = {64, 1024, 1024 * 4, 1024 * 64, 1024 * 1024};
+    for (auto bufsize : sizes) {
+        auto feed_all = [&](auto& sum) {
+            auto          in    = neo::const_buffer(data);
+            std::uint64_t calls = 0;
+            while (!in.empty()) {
+                const auto part = in.first(std::min(in.size(), bufsize));
+                sum.feed(part);
+                in += part.size();
+                ++calls;
+            }
+            return work{data.size(), calls};
+        };
+        r.run(bench_name("crc32", "any", bufsize), [&] {
+            neo::crc32 crc;
+            auto       w = feed_all(crc);
+            checksum_sink  = crc.value();
+            return w;
+        });
+        r.run(bench_name("adler32", "any", bufsize), [&] {
+            neo::adler32 adler;
+            auto         w = feed_all(adler);
+            checksum_sink  = adler.value();
+            return w;
+        });
+    }
+}
+
+void bench_ustar_headers(bench_runner& r) {
+    neo::ustar_member_info info;
+    info.set_filename("include/neo/compress/some-long-file-name.hpp");
+    info.set_prefix("packages/neo-compress-0.3.1");
+    info.size     = 123456;
+    info.mtime    = 1'600'000'000;
+    info.typeflag = neo::ustar_member_info::regular_file;
+
+    std::array<std::byte, 512> block{};
+    {
+        neo::ustar_header_encoder enc;
+        enc(neo::mutable_buffer(block), info);
+    }
+
+    constexpr std::uint64_t n_headers = 10'000;
+    r.run("ustar_header_encoder/none/512", [&] {
+        std::array<std::byte, 512> out{};
+        for (auto i = 0u; i < n_headers; ++i) {
+            neo::ustar_header_encoder enc;
+            if (!enc(neo::mutable_buffer(out), info).done()) {
+                throw std::runtime_error("Failed to encode a tar header");
+            }
+        }
+        return work{n_headers * out.size(), n_headers};
+    });
+    r.run("ustar_header_decoder/none/512", [&] {
+        for (auto i = 0u; i < n_headers; ++i) {
+            neo::ustar_header_decoder dec;
+            // `done` marks the end-of-archive block, not a decoded header
+            auto res = dec(neo::const_buffer(block));
+            if (res.done || !res.has_value()) {
+                throw std::runtime_error("Failed to decode a tar header");
+            }
+        }
+        return work{n_headers * block.size(), n_headers};
+    });
+}
+
+void bench_targz(bench_runner& r, const bench_options& opts) {
+    struct tree {
+        std::string name;
+        std::size_t n_files;
+        std::size_t total_size;
+    };
+    const std::size_t corpus_size = opts.corpus_mib * 1024 * 1024;
+    const tree        trees[]     = {
+        {"tiny-files", 2000, 2000 * 200},
+        {"huge-files", 2, corpus_size * 2},
+    };
+
+    for (auto& t : trees) {
+        const auto compress_name = "compress_directory_targz/" + t.name;
+        const auto expand_name   = "expand_directory_targz/" + t.name;
+        if (r.list_only()) {
+            // Listing never runs the bodies
+            r.run(compress_name + "/threads=1", {});
+            r.run(compress_name + "/threads=0", {});
+            r.run(expand_name, {});
+            continue;
+        }
+        if (!r.selected(compress_name + "/threads=1") && !r.selected(compress_name + "/threads=0")
+            && !r.selected(expand_name)) {
+            // Don't bother creating the files
+            continue;
+        }
+        temp_dir   tmp;
+        const auto src    = tmp.path() / "src";
+        const auto size   = make_tree(src, t.n_files, t.total_size);
+        const auto targz  = tmp.path() / "archive.tar.gz";
+        const auto n_objs = static_cast<std::uint64_t>(t.n_files);
+
+        for (unsigned threads : {1u, 0u}) {
+            r.run(compress_name + "/threads=" + std::to_string(threads), [&] {
+                neo::compress_directory_targz(src,
+                                              targz,
+                                              neo::compress_options{.thread_count = threads});
+                return work{size, n_objs};
+            });
+        }
+        if (!fs::exists(targz)) {
+            neo::compress_directory_targz(src, targz);
+        }
+        r.run(expand_name, [&] {
+            const auto dest = tmp.path() / "dest";
+            fs::remove_all(dest);
+            neo::expand_directory_targz(dest, targz);
+            return work{size, n_objs};
+        });
+    }
+}
+
+bench_options parse_args(int argc, char** argv) {
+    bench_options opts;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        auto                   value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("Missing value for " + std::string(arg));
+            }
+            return argv[++i];
+        };
+        if (arg == "--filter") {
+            opts.filter = value();
+        } else if (arg == "--min-time") {
+            opts.min_time = std::stod(value());
+        } else if (arg == "--corpus-mib") {
+            opts.corpus_mib = std::stoul(value());
+        } else if (arg == "--out") {
+            opts.out_path = value();
+        } else if (arg == "--list") {
+            opts.list_only = true;
+        } else {
+            throw std::runtime_error("Unknown argument: " + std::string(arg));
+        }
+    }
+    return opts;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    try {
+        const auto opts = parse_args(argc, argv);
+
+        std::ofstream out_file;
+        if (!opts.out_path.empty()) {
+            out_file.open(opts.out_path);
+            if (!out_file) {
+                throw std::runtime_error("Failed to open " + opts.out_path);
+            }
+        }
+        bench_runner r{opts, opts.out_path.empty() ? std::cout : out_file};
+
+        // A listing only needs the names of the corpus entries
+        const auto corpus = make_corpus(opts.list_only ? 1024 : opts.corpus_mib * 1024 * 1024);
+        bench_deflate(r, corpus);
+        bench_inflate(r, corpus);
+        bench_gzip_io(r, corpus);
+        bench_checksums(r, corpus);
+        bench_ustar_headers(r);
+        bench_targz(r, opts);
+        return 0;
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "Error: %s\n", e.what());
+        return 1;
+    }
+}
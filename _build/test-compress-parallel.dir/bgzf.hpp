@@ -0,0 +1,209 @@
+#pragma once
+
+#include "./compress.hpp"
+#include "./deflate.hpp"
+#include "./gzip.hpp"
+#include "./inflate.hpp"
+
+#include <neo/buffer_sink.hpp>
+#include <neo/const_buffer.hpp>
+#include <neo/transform_io.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <vector>
+
+namespace neo {
+
+/**
+ * Given the beginning of a gzip member, obtain the total size of the member
+ * from the BSIZE value of a BGZF "BC" extra subfield.
+ *
+ * Returns `nullopt` if `header` does not contain the entire gzip header up to
+ * the end of the FEXTRA field, or if the header has no BGZF subfield.
+ */
+std::optional<std::size_t> bgzf_block_size(const_buffer header) noexcept;
+
+/**
+ * An entry in a bgzf_index, mapping an offset in the uncompressed data to the
+ * offset of the block that starts there.
+ */
+struct bgzf_index_entry {
+    std::uint64_t compressed_offset   = 0;
+    std::uint64_t uncompressed_offset = 0;
+};
+
+/**
+ * An index of the blocks of a BGZF file. This is the same information stored
+ * in the `.gzi` files generated by `bgzip -i`, and can be read from and written
+ * to that format.
+ *
+ * As with `.gzi`, there is an entry for the end of each block, and the
+ * beginning of the first block (at zero) is implied.
+ */
+class bgzf_index {
+    std::vector<bgzf_index_entry> _entries;
+
+public:
+    bgzf_index() = default;
+
+    /// Append an entry. Entries must be added in order.
+    void add(const bgzf_index_entry& e);
+
+    const std::vector<bgzf_index_entry>& entries() const noexcept { return _entries; }
+
+    /**
+     * Find the beginning of the block that contains the given uncompressed
+     * offset.
+     */
+    bgzf_index_entry find(std::uint64_t uncompressed_offset) const noexcept;
+
+    /// Write the index in the `.gzi` format
+    void write(std::ostream& out) const;
+
+    /// Read an index in the `.gzi` format
+    static bgzf_index read(std::istream& in);
+
+    /**
+     * Generate an index for the BGZF data in the given stream by reading the
+     * header and trailer of each block. No decompression is performed.
+     */
+    static bgzf_index build(std::istream& in);
+};
+
+/**
+ * Options for a bgzf_compressor
+ */
+struct bgzf_options {
+    /// Parameters for compressing each block
+    deflate_options deflate = {.window_bits = 15};
+};
+
+/**
+ * A compressor that generates BGZF ("Blocked GNU Zip Format") data, as used by
+ * `bgzip` and htslib.
+ *
+ * BGZF data is a series of gzip members, each holding at most 64 KiB of
+ * compressed data, and each having a "BC" FEXTRA subfield that records the
+ * size of the member. BGZF is valid (multi-member) gzip data, but the block
+ * sizes make it possible to seek to any block without decompressing the data
+ * before it. The stream ends with an empty block as an end-of-file marker.
+ *
+ * Flushing the compressor ends the current block. An index of the blocks that
+ * have been written is available from index().
+ */
+class bgzf_compressor {
+    gzip_compressor<deflate_compressor> _gzip;
+    // Used in the rare case that a block does not fit in 64 KiB after compression
+    std::optional<gzip_compressor<deflate_compressor>> _gzip_stored;
+
+    std::vector<std::byte> _block;
+    std::vector<std::byte> _pending;
+    std::size_t            _pending_pos = 0;
+
+    std::uint64_t _compressed_offset   = 0;
+    std::uint64_t _uncompressed_offset = 0;
+    bgzf_index    _index;
+
+    bool _eof_queued = false;
+    bool _done       = false;
+
+    void _queue_block();
+    bool _try_compress(gzip_compressor<deflate_compressor>& gz);
+
+public:
+    /// The largest amount of input that is stored in a single block
+    static constexpr std::size_t max_block_input = 0xff00;
+    /// The largest size of a compressed block
+    static constexpr std::size_t max_block_size = 0x10000;
+
+    explicit bgzf_compressor(const bgzf_options& opts);
+    bgzf_compressor()
+        : bgzf_compressor(bgzf_options()) {}
+
+    compress_result operator()(mutable_buffer out, const_buffer in, flush f = flush::no_flush);
+
+    void reset() noexcept;
+
+    /// The index of the blocks that have been generated so far
+    const bgzf_index& index() const noexcept { return _index; }
+};
+
+template <>
+constexpr std::size_t buffer_transform_dynamic_growth_hint_v<bgzf_compressor>
+    = bgzf_compressor::max_block_size;
+
+/**
+ * @brief Adapt a buffer_sink with BGZF compression.
+ *
+ * @tparam Sink The underlying buffer sink (A file, socket, etc.)
+ */
+template <buffer_sink Sink>
+class bgzf_sink : public buffer_transform_sink<Sink, bgzf_compressor> {
+public:
+    explicit bgzf_sink(Sink&& out, const bgzf_options& opts = {})
+        : bgzf_sink::buffer_transform_sink{NEO_FWD(out), bgzf_compressor{opts}} {}
+
+    /// End the current block, and write it to the underlying sink
+    std::size_t flush() {
+        return buffer_transform(this->transformer(), this->sink(), const_buffer(), neo::flush::sync)
+            .bytes_written;
+    }
+
+    /// Write the final block and the end-of-file marker
+    std::size_t finish() {
+        return buffer_transform(this->transformer(),
+                                this->sink(),
+                                const_buffer(),
+                                neo::flush::finish)
+            .bytes_written;
+    }
+
+    /// The index of the blocks that have been written so far
+    const bgzf_index& index() const noexcept { return this->transformer().index(); }
+};
+
+template <buffer_sink S>
+explicit bgzf_sink(S &&) -> bgzf_sink<S>;
+
+template <buffer_sink S>
+bgzf_sink(S&&, const bgzf_options&) -> bgzf_sink<S>;
+
+/**
+ * @brief A buffer_source that decompresses BGZF data from a seekable stream,
+ * and supports seeking to an offset in the uncompressed data.
+ *
+ * Seeking uses the index given on construction. If no index was given, one is
+ * built by scanning the block headers the first time that seek() is called.
+ * The BGZF data is expected to begin at the start of the stream.
+ */
+class bgzf_source {
+    std::istream*                           _in;
+    std::optional<bgzf_index>               _index;
+    gzip_decompressor<inflate_decompressor> _decomp;
+
+    std::vector<std::byte> _cblock;
+    std::vector<std::byte> _block;
+    std::size_t            _pos = 0;
+
+    std::uint64_t _block_uoffset = 0;
+
+    bool _read_block();
+
+public:
+    explicit bgzf_source(std::istream& in);
+    bgzf_source(std::istream& in, bgzf_index idx);
+
+    const_buffer next(std::size_t n);
+    void         consume(std::size_t n) noexcept;
+
+    /// Move to the given offset in the uncompressed data
+    void seek(std::uint64_t uncompressed_offset);
+
+    /// The current offset in the uncompressed data
+    std::uint64_t tell() const noexcept { return _block_uoffset + _pos; }
+};
+
+}  // namespace neo
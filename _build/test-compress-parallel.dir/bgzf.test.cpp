@@ -0,0 +1,117 @@
+#include "./bgzf.hpp"
+
+#include "./gzip_io.hpp"
+
+#include <neo/string_io.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <sstream>
+
+namespace {
+
+std::string make_lines(int n) {
+    std::string ret;
+    for (auto i = 0; i < n; ++i) {
+        ret += "This is line number " + std::to_string(i) + "\n";
+    }
+    return ret;
+}
+
+}  // namespace
+
+TEST_CASE("Write and read BGZF data") {
+    const auto text = make_lines(20000);
+
+    neo::string_dynbuf_io bgzf_data;
+    neo::bgzf_sink        out{bgzf_data};
+    neo::buffer_copy(out, neo::const_buffer(text));
+    out.finish();
+
+    // The index covers all of the data
+    auto& entries = out.index().entries();
+    REQUIRE(entries.size() > 1);
+    CHECK(entries.back().uncompressed_offset == text.size());
+
+    // The first block records its own size
+    auto data       = std::string(bgzf_data.read_area_view());
+    auto first_size = neo::bgzf_block_size(neo::const_buffer(data));
+    REQUIRE(first_size);
+    CHECK(*first_size == entries[0].compressed_offset);
+
+    // BGZF data is plain multi-member gzip data
+    neo::string_dynbuf_io plain;
+    neo::gzip_decompress(plain,
+                         neo::const_buffer(data),
+                         neo::gzip_decompress_options{.multi_member = true});
+    CHECK(plain.string() == text);
+
+    // Read it back with a bgzf_source
+    std::istringstream    strm{data};
+    neo::bgzf_source      in{strm};
+    neo::string_dynbuf_io decoded;
+    neo::buffer_copy(decoded, in);
+    CHECK(decoded.string() == text);
+}
+
+TEST_CASE("Reject a BGZF block with a corrupted ISIZE") {
+    const auto text = make_lines(20000);
+
+    neo::string_dynbuf_io bgzf_data;
+    neo::bgzf_sink        out{bgzf_data};
+    neo::buffer_copy(out, neo::const_buffer(text));
+    out.finish();
+
+    // Claim that the first block holds 4 GiB of data
+    auto data       = std::string(bgzf_data.read_area_view());
+    auto first_size = neo::bgzf_block_size(neo::const_buffer(data));
+    REQUIRE(first_size);
+    std::fill_n(data.begin() + static_cast<std::ptrdiff_t>(*first_size - 4), 4, '\xff');
+
+    std::istringstream    strm{data};
+    neo::bgzf_source      in{strm};
+    neo::string_dynbuf_io decoded;
+    CHECK_THROWS_AS(neo::buffer_copy(decoded, in), std::runtime_error);
+}
+
+TEST_CASE("Seek in BGZF data") {
+    const auto text = make_lines(20000);
+
+    neo::string_dynbuf_io bgzf_data;
+    neo::bgzf_sink        out{bgzf_data};
+    neo::buffer_copy(out, neo::const_buffer(text));
+    out.finish();
+
+    // Round-trip the index through the .gzi format
+    std::stringstream gzi;
+    out.index().write(gzi);
+    auto idx = neo::bgzf_index::read(gzi);
+    CHECK(idx.entries().size() == out.index().entries().size());
+
+    std::istringstream strm{std::string(bgzf_data.read_area_view())};
+    neo::bgzf_source   in{strm, idx};
+
+    auto read_at = [&](std::uint64_t offset, std::size_t size) {
+        in.seek(offset);
+        CHECK(in.tell() == offset);
+        std::string ret;
+        while (ret.size() < size) {
+            auto part = in.next(size - ret.size());
+            if (part.size() == 0) {
+                break;
+            }
+            ret.append(std::string_view(part));
+            in.consume(part.size());
+        }
+        return ret;
+    };
+
+    CHECK(read_at(0, 10) == text.substr(0, 10));
+    CHECK(read_at(400000, 100) == text.substr(400000, 100));
+    CHECK(read_at(123, 100) == text.substr(123, 100));
+    // A range that spans a block boundary
+    auto boundary = idx.entries()[0].uncompressed_offset;
+    CHECK(read_at(boundary - 50, 100) == text.substr(boundary - 50, 100));
+    CHECK(read_at(text.size(), 10) == "");
+}
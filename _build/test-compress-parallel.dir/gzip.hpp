@@ -0,0 +1,794 @@
+#pragma once
+
+#include <neo/compress.hpp>
+#include <neo/crc32.hpp>
+#include <neo/decompress.hpp>
+#include <neo/dictionary.hpp>
+#include <neo/stream_stats.hpp>
+
+#include <neo/assert.hpp>
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/buffer_sink.hpp>
+#include <neo/buffer_source.hpp>
+#include <neo/const_buffer.hpp>
+#include <neo/ref.hpp>
+#include <neo/switch_coro.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+namespace neo {
+
+namespace detail {
+
+/// Match (de)compressors that can be given a preset dictionary
+template <typename T>
+concept accepts_dictionary = requires(T& algo, const_buffer dict) {
+    algo.set_dictionary(dict);
+};
+
+}  // namespace detail
+
+/**
+ * A gzip_compressor compresses a stream as a gzip stream, using `InnerCompressor`
+ * to compress the actual body data.
+ *
+ * @tparam Stats A stream_stats_policy. With record_stream_stats, stats()
+ * reports the bytes, calls, and yields of the compressor, and the time spent
+ * in the inner compressor and computing the CRC.
+ */
+template <compressor_algorithm InnerCompressor, stream_stats_policy Stats = no_stream_stats>
+class gzip_compressor {
+    [[no_unique_address]] wrap_refs_t<InnerCompressor> _compressor;
+
+    [[no_unique_address]] detail::stream_stats_recorder<Stats::enabled> _stats;
+
+    // Magic [0x1f, 0x8b] compresstion type DEFLATE [0x08]
+    static inline const_buffer _fixed_header = const_buffer{"\x1f\x8b\x08"};
+    // We don't support mtime yet
+    static inline const_buffer _mtime = const_buffer{"\xde\xad\xbe\xef"};
+
+    /**
+     * The input is handed to the inner compressor in pieces of this size, so
+     * that the CRC of each piece is computed while it is still hot in the cache.
+     */
+    static constexpr std::size_t _crc_chunk_size = 1024 * 64;
+
+    /// The size of the "DC" FEXTRA subfield that holds the ID of a preset dictionary
+    static constexpr std::size_t _dict_field_size = 8;
+
+    const_buffer  _header_buf = _fixed_header;
+    const_buffer  _mtime_buf  = _mtime;
+    const_buffer  _extra;
+    const_buffer  _extra_buf;
+    const_buffer  _dictionary;
+    std::uint32_t _dictionary_id  = 0;
+    bool          _has_dictionary = false;
+    crc32         _crc;
+    std::uint32_t _size                   = 0;
+    std::size_t   _num_crc_bytes_written  = 0;
+    std::size_t   _num_size_bytes_written = 0;
+    int           _coro                   = 0;
+
+    /**
+     * Copy `cb` into `out`, advancing `cb` and `out` by the number of bytes copied. Returns
+     * `true` if the entire buffer was copied.
+     */
+    static constexpr bool _put_buf(mutable_buffer& out, const_buffer& cb) noexcept {
+        const auto n_copied = buffer_copy(out, cb);
+        out += n_copied;
+        cb += n_copied;
+        return cb.empty();
+    }
+
+    /**
+     * Depending on the given bool, write a byte into the buffer. Sets the output
+     * bool if the byte was written.
+     */
+    static constexpr bool
+    _put_byte(bool& already_written, mutable_buffer& out, std::byte b) noexcept {
+        if (already_written) {
+            return true;
+        }
+        if (!out.empty()) {
+            out[0] = b;
+            out += 1;
+            already_written = true;
+            return true;
+        }
+        return false;
+    }
+
+    constexpr bool _has_extra_field() const noexcept { return _has_dictionary || !_extra.empty(); }
+
+    constexpr std::size_t _xlen() const noexcept {
+        return _extra.size() + (_has_dictionary ? _dict_field_size : 0);
+    }
+
+public:
+    constexpr gzip_compressor() = default;
+    constexpr explicit gzip_compressor(InnerCompressor&& c)
+        : _compressor(NEO_FWD(c)) {}
+
+    NEO_DECL_UNREF_GETTER(compressor, _compressor);
+
+    /**
+     * Reset the compressor to begin a new gzip stream. The inner compressor is
+     * reset in-place, so any parameters it was given are retained. If a
+     * dictionary was given, it is given to the inner compressor again.
+     */
+    constexpr void reset() noexcept {
+        unref(_compressor).reset();
+        using inner_type = std::remove_cvref_t<decltype(unref(_compressor))>;
+        if constexpr (detail::accepts_dictionary<inner_type>) {
+            if (_has_dictionary) {
+                unref(_compressor).set_dictionary(_dictionary);
+            }
+        }
+        _header_buf             = _fixed_header;
+        _mtime_buf              = _mtime;
+        _extra_buf              = _extra;
+        _crc                    = crc32();
+        _size                   = 0;
+        _num_crc_bytes_written  = 0;
+        _num_size_bytes_written = 0;
+        _coro                   = 0;
+    }
+
+    /**
+     * Set the FEXTRA field to write in the header of the stream. The buffer is
+     * not copied: It must remain valid until the header has been written.
+     * Must be called before any output is generated.
+     */
+    constexpr void set_extra_field(const_buffer extra) noexcept {
+        neo_assert(expects,
+                   _coro == 0,
+                   "gzip_compressor::set_extra_field() called after output was generated");
+        neo_assert(expects,
+                   extra.size() <= 0xffff - _dict_field_size,
+                   "gzip FEXTRA field is too large",
+                   extra.size());
+        _extra     = extra;
+        _extra_buf = extra;
+    }
+
+    /**
+     * Compress using a preset dictionary, such as one from train_dictionary().
+     * The ID of the dictionary is written in a "DC" subfield of the FEXTRA
+     * field, so that a gzip_decompressor can check that it was given the same
+     * dictionary. Other gzip implementations cannot decompress the data.
+     *
+     * The buffer is not copied: It must remain valid for as long as the
+     * compressor is used, as reset() gives it to the inner compressor again.
+     * Must be called before any output is generated.
+     */
+    void set_dictionary(const_buffer dict) {
+        neo_assert(expects,
+                   _coro == 0,
+                   "gzip_compressor::set_dictionary() called after output was generated");
+        unref(_compressor).set_dictionary(dict);
+        _dictionary     = dict;
+        _dictionary_id  = dictionary_id(dict);
+        _has_dictionary = true;
+    }
+
+    /**
+     * Get the statistics recorded since construction. These accumulate across
+     * calls to reset(). The peak allocator usage is that of the inner
+     * compressor, if it records one.
+     */
+    stream_stats stats() const noexcept requires Stats::enabled {
+        auto ret                 = _stats.values();
+        ret.peak_bytes_allocated = detail::peak_bytes_allocated_of(unref(_compressor));
+        return ret;
+    }
+
+    constexpr compress_result
+    operator()(mutable_buffer out, const_buffer in, flush f = flush::no_flush) noexcept {
+        if constexpr (Stats::enabled) {
+            auto res = _stats.timed(&stream_stats::total_time, [&] { return _step(out, in, f); });
+            _stats.record_call(res.bytes_read, res.bytes_written, !res.done);
+            return res;
+        } else {
+            return _step(out, in, f);
+        }
+    }
+
+private:
+/**
+ * Write the entire contents of `Buf` into `Dest`
+ */
+#define FLUSH_BUF(Dest, Buf)                                                                       \
+    NEO_FN_MACRO_BEGIN                                                                             \
+    while (!Buf.empty()) {                                                                         \
+        if (Dest.empty()) {                                                                        \
+            NEO_CORO_YIELD(calc_ret());                                                            \
+        }                                                                                          \
+        auto n_copied = buffer_copy(Dest, Buf);                                                    \
+        Buf += n_copied;                                                                           \
+        Dest += n_copied;                                                                          \
+    }                                                                                              \
+    NEO_FN_MACRO_END
+
+#define PUT_BYTE(Out, Byte)                                                                        \
+    NEO_FN_MACRO_BEGIN                                                                             \
+    if (Out.empty()) {                                                                             \
+        NEO_CORO_YIELD(calc_ret());                                                                \
+    }                                                                                              \
+    Out[0] = Byte;                                                                                 \
+    Out += 1;                                                                                      \
+    NEO_FN_MACRO_END
+
+    constexpr compress_result _step(mutable_buffer out, const_buffer in, flush f) noexcept {
+        neo_assert(expects,
+                   !NEO_CORO_IS_FINISHED(_coro),
+                   "Application reused gzip_compressor without calling .reset()");
+
+        // Create a compression result based on how much progress we have made
+        auto calc_ret = [&, in_size = in.size(), out_size = out.size()] {
+            return compress_result{
+                .bytes_written = out_size - out.size(),
+                .bytes_read    = in_size - in.size(),
+                .done          = NEO_CORO_IS_FINISHED(_coro),
+            };
+        };
+
+        bool compress_done = false;
+        bool made_progress = false;
+
+        NEO_CORO_BEGIN(_coro);
+
+        // Flush the header
+        FLUSH_BUF(out, _header_buf);
+        // The flags byte. We only set FEXTRA, if needed.
+        PUT_BYTE(out, _has_extra_field() ? std::byte(0x04) : std::byte(0x00));
+        // Flush the mtime bytes
+        FLUSH_BUF(out, _mtime_buf);
+        // No interesting extra flags:
+        PUT_BYTE(out, std::byte(0x00));
+        // Flush the OS (0xff == unknown)
+        PUT_BYTE(out, std::byte(0xff));
+        if (_has_extra_field()) {
+            // XLEN, followed by the extra field itself
+            PUT_BYTE(out, std::byte(_xlen() & 0xff));
+            PUT_BYTE(out, std::byte(_xlen() >> 8));
+            if (_has_dictionary) {
+                // The "DC" subfield, with a four-byte little-endian dictionary ID
+                PUT_BYTE(out, std::byte('D'));
+                PUT_BYTE(out, std::byte('C'));
+                PUT_BYTE(out, std::byte(4));
+                PUT_BYTE(out, std::byte(0));
+                PUT_BYTE(out, std::byte(_dictionary_id));
+                PUT_BYTE(out, std::byte(_dictionary_id >> 8));
+                PUT_BYTE(out, std::byte(_dictionary_id >> 16));
+                PUT_BYTE(out, std::byte(_dictionary_id >> 24));
+            }
+            FLUSH_BUF(out, _extra_buf);
+        }
+
+        // Write the actual body of data
+        while (true) {
+            {
+                // Compress a piece of the input into `out`. The flush only applies once we
+                // reach the final piece.
+                using std::as_const;
+                const auto in_part   = in.first(std::min(in.size(), _crc_chunk_size));
+                const bool last_part = in_part.size() == in.size();
+                const auto compress_res = _stats.timed(&stream_stats::codec_time, [&] {
+                    return unref(_compressor)(as_const(out),
+                                              in_part,
+                                              last_part ? f : flush::no_flush);
+                });
+                // Update the running CRC
+                _stats.timed(&stream_stats::checksum_time, [&] {
+                    _crc.feed(in.first(compress_res.bytes_read));
+                });
+                // Update the running size count
+                _size += static_cast<std::uint32_t>(compress_res.bytes_read);
+                // Advance our buffers by the used space
+                out += compress_res.bytes_written;
+                in += compress_res.bytes_read;
+                compress_done = compress_res.done;
+                made_progress = compress_res.bytes_read || compress_res.bytes_written;
+            }
+
+            if (!compress_done && !in.empty() && !out.empty() && made_progress) {
+                // There is more input, and room to put it
+                continue;
+            }
+
+            if (!compress_done) {
+                // We aren't done compressing data and the user has not yet flushed
+                neo_assert(invariant,
+                           out.empty() || in.empty(),
+                           "Compressor did not exhaust the input nor output buffers",
+                           out.size(),
+                           in.size());
+                NEO_CORO_YIELD(calc_ret());
+                continue;
+            }
+
+            if (compress_done) {
+                neo_assert_always(invariant,
+                                  ((f & neo::flush::finish) == neo::flush::finish),
+                                  "Compressor finished prematurely?",
+                                  int(f));
+                neo_assert_always(invariant,
+                                  in.empty(),
+                                  "Compressor did not take all of the data",
+                                  in.size());
+            }
+            // Compression is finished. Finish up the Gzip file
+            break;
+        }
+
+        // Writing the trailer yeah!
+        while (_num_crc_bytes_written < sizeof(_crc.value())) {
+            if (out.empty()) {
+                NEO_CORO_YIELD(calc_ret());
+            }
+            neo_assert(expects, in.empty(), "Compressor is not accepting more data", in.size());
+
+            auto      crc_val      = _crc.value();
+            std::byte crc_bytes[4] = {
+                std::byte(crc_val),
+                std::byte(crc_val >> 8),
+                std::byte(crc_val >> 16),
+                std::byte(crc_val >> 24),
+            };
+            auto crc_buf       = neo::const_buffer(crc_bytes);
+            auto n_written_crc = buffer_copy(out, crc_buf + _num_crc_bytes_written);
+            _num_crc_bytes_written += n_written_crc;
+            out += n_written_crc;
+        }
+
+        while (_num_size_bytes_written < sizeof(_size)) {
+            if (out.empty()) {
+                NEO_CORO_YIELD(calc_ret());
+            }
+            neo_assert(expects, in.empty(), "Compressor is not accepting more data", in.size());
+            std::byte size_bytes[4] = {
+                std::byte(_size),
+                std::byte(_size >> 8),
+                std::byte(_size >> 16),
+                std::byte(_size >> 24),
+            };
+            auto size_buf      = neo::const_buffer(size_bytes);
+            auto n_written_len = buffer_copy(out, size_buf + _num_size_bytes_written);
+            out += n_written_len;
+            _num_size_bytes_written += n_written_len;
+        }
+
+        NEO_CORO_END;
+
+#undef FLUSH_BUF
+#undef PUT_BYTE
+
+        return calc_ret();
+    }
+};
+
+template <typename C>
+gzip_compressor(C &&) -> gzip_compressor<C>;
+
+/**
+ * Options for a gzip_decompressor
+ */
+struct gzip_decompress_options {
+    /**
+     * Check the CRC-32 and the size stored in the trailer of the stream. This
+     * should only be disabled for trusted data, such as data that the
+     * application generated itself.
+     */
+    bool verify_checksum = true;
+    /**
+     * Decode a stream of concatenated gzip members (as produced by pigz,
+     * bgzip, or `cat a.gz b.gz`) as a single stream. Since another member may
+     * always follow, the decompressor never reports `done` in this mode: The
+     * data ends when the input ends. Use at_member_boundary() to check that the
+     * input did not end part-way through a member.
+     */
+    bool multi_member = false;
+};
+
+/**
+ * A gzip_decompressor decompresses a gzip stream, using `InnerDecompressor` to
+ * decompress the actual body data.
+ *
+ * @tparam Stats A stream_stats_policy. With record_stream_stats, stats()
+ * reports the bytes, calls, and yields of the decompressor, and the time spent
+ * in the inner decompressor and verifying the CRC.
+ */
+template <decompressor_algorithm InnerDecompressor, stream_stats_policy Stats = no_stream_stats>
+class gzip_decompressor {
+    [[no_unique_address]] wrap_refs_t<InnerDecompressor> _decompress;
+
+    [[no_unique_address]] detail::stream_stats_recorder<Stats::enabled> _stats;
+
+    /**
+     * The output is requested from the inner decompressor in pieces of this
+     * size, so that the CRC of each piece is computed while it is still hot in
+     * the cache.
+     */
+    static constexpr std::size_t _crc_chunk_size = 1024 * 64;
+
+    gzip_decompress_options _opts;
+
+    int _coro = 0;
+
+    template <std::size_t Len>
+    struct arrbuf {
+        std::array<std::byte, Len> bytes = {};
+        mutable_buffer             buf{bytes};
+
+        constexpr arrbuf() = default;
+        constexpr arrbuf(const arrbuf& other)
+            : bytes(other.bytes)
+            , buf(as_buffer(bytes)) {}
+
+        constexpr void reset() noexcept {
+            bytes = {};
+            buf   = mutable_buffer(bytes);
+        }
+    };
+
+    arrbuf<2> _magic;
+
+    std::byte _flags{0};
+    std::byte _compression_method{};
+    arrbuf<4> _mtime;
+    std::byte _xfl{};
+    std::byte _os{};
+
+    arrbuf<2>        _xlen;
+    arrbuf<1024 * 2> _fextra;
+    arrbuf<1024>     _fname;
+    arrbuf<256>      _comment;
+    arrbuf<2>        _hcrc;
+    arrbuf<4>        _stored_crc32;
+    arrbuf<4>        _stored_size;
+
+    std::uint64_t _actual_size = 0;
+    crc32         _actual_crc;
+    bool          _member_done = false;
+
+    const_buffer  _dictionary;
+    std::uint32_t _dictionary_id  = 0;
+    bool          _has_dictionary = false;
+
+    constexpr std::uint16_t _xlen_uint16() const noexcept {
+        return std::uint16_t(
+            (std::uint16_t(_xlen.bytes[0]) | std::uint16_t(std::uint16_t(_xlen.bytes[1]) << 8)));
+    }
+
+    constexpr std::uint32_t _stored_crc_uint32() const noexcept {
+        return (std::uint32_t(_stored_crc32.bytes[0])            //
+                | (std::uint32_t(_stored_crc32.bytes[1]) << 8)   //
+                | (std::uint32_t(_stored_crc32.bytes[2]) << 16)  //
+                | (std::uint32_t(_stored_crc32.bytes[3]) << 24));
+    }
+
+    constexpr std::uint32_t _stored_size_uint32() const noexcept {
+        return (std::uint32_t(_stored_size.bytes[0])            //
+                | (std::uint32_t(_stored_size.bytes[1]) << 8)   //
+                | (std::uint32_t(_stored_size.bytes[2]) << 16)  //
+                | (std::uint32_t(_stored_size.bytes[3]) << 24));
+    }
+
+    constexpr bool _ftext_set() const noexcept { return int(_flags) & 1; }
+    constexpr bool _fhcrc_set() const noexcept { return int(_flags) & 1 << 1; }
+    constexpr bool _fextra_set() const noexcept { return int(_flags) & 1 << 2; }
+    constexpr bool _fname_set() const noexcept { return int(_flags) & 1 << 3; }
+    constexpr bool _fcomment_set() const noexcept { return int(_flags) & 1 << 4; }
+
+    /**
+     * If the FEXTRA field of the current member names a preset dictionary with
+     * a "DC" subfield, give the dictionary to the inner decompressor.
+     */
+    void _load_member_dictionary() {
+        const auto& f    = _fextra.bytes;
+        const auto  xlen = std::size_t(_xlen_uint16());
+        std::size_t pos  = 0;
+        while (pos + 4 <= xlen) {
+            const auto len = std::size_t(f[pos + 2]) | (std::size_t(f[pos + 3]) << 8);
+            if (f[pos] != std::byte('D') || f[pos + 1] != std::byte('C') || len != 4
+                || pos + 8 > xlen) {
+                pos += 4 + len;
+                continue;
+            }
+            const auto id = (std::uint32_t(f[pos + 4])            //
+                             | (std::uint32_t(f[pos + 5]) << 8)   //
+                             | (std::uint32_t(f[pos + 6]) << 16)  //
+                             | (std::uint32_t(f[pos + 7]) << 24));
+            if (!_has_dictionary) {
+                throw std::runtime_error("gzip member requires a preset dictionary");
+            }
+            if (id != _dictionary_id) {
+                throw std::runtime_error(
+                    "gzip member was compressed with a different preset dictionary");
+            }
+            using inner_type = std::remove_cvref_t<decltype(unref(_decompress))>;
+            if constexpr (detail::accepts_dictionary<inner_type>) {
+                unref(_decompress).set_dictionary(_dictionary);
+            } else {
+                throw std::runtime_error("The inner decompressor does not support dictionaries");
+            }
+            return;
+        }
+    }
+
+    constexpr void _reset_member() noexcept {
+        unref(_decompress).reset();
+        _flags              = std::byte{0};
+        _compression_method = std::byte{};
+        _xfl                = std::byte{};
+        _os                 = std::byte{};
+        _magic.reset();
+        _mtime.reset();
+        _xlen.reset();
+        _fextra.reset();
+        _fname.reset();
+        _comment.reset();
+        _hcrc.reset();
+        _stored_crc32.reset();
+        _stored_size.reset();
+        _actual_size = 0;
+        _actual_crc  = crc32();
+    }
+
+public:
+    constexpr gzip_decompressor() = default;
+    constexpr explicit gzip_decompressor(const gzip_decompress_options& opts)
+        : _opts(opts) {}
+    constexpr explicit gzip_decompressor(InnerDecompressor&&            c,
+                                         const gzip_decompress_options& opts = {})
+        : _decompress(NEO_FWD(c))
+        , _opts(opts) {}
+
+    NEO_DECL_UNREF_GETTER(decompressor, _decompress);
+
+    const gzip_decompress_options& options() const noexcept { return _opts; }
+
+    /**
+     * Reset the decompressor to begin a new gzip stream. The options and the
+     * inner decompressor are retained.
+     */
+    constexpr void reset() noexcept {
+        _reset_member();
+        _coro        = 0;
+        _member_done = false;
+    }
+
+    /**
+     * Whether the decompressor is between gzip members, i.e. at least one
+     * member has been fully decoded and no part of another has been read.
+     */
+    constexpr bool at_member_boundary() const noexcept { return _member_done; }
+
+    /**
+     * Provide the preset dictionary for members that were compressed with one
+     * by gzip_compressor::set_dictionary(). A member that names a different
+     * dictionary is rejected. The buffer is not copied: It must remain valid
+     * for as long as the decompressor is used.
+     */
+    void set_dictionary(const_buffer dict) {
+        _dictionary     = dict;
+        _dictionary_id  = dictionary_id(dict);
+        _has_dictionary = true;
+    }
+
+    /**
+     * Get the statistics recorded since construction. These accumulate across
+     * calls to reset(). The peak allocator usage is that of the inner
+     * decompressor, if it records one.
+     */
+    stream_stats stats() const noexcept requires Stats::enabled {
+        auto ret                 = _stats.values();
+        ret.peak_bytes_allocated = detail::peak_bytes_allocated_of(unref(_decompress));
+        return ret;
+    }
+
+    constexpr decompress_result operator()(mutable_buffer out, const_buffer in) {
+        if constexpr (Stats::enabled) {
+            auto res = _stats.timed(&stream_stats::total_time, [&] { return _step(out, in); });
+            _stats.record_call(res.bytes_read, res.bytes_written, !res.done);
+            return res;
+        } else {
+            return _step(out, in);
+        }
+    }
+
+private:
+/**
+ * Continually read bytes into Arr until Arr is full
+ */
+#define CORO_READ_BUF(Arr, Buf)                                                                    \
+    NEO_FN_MACRO_BEGIN                                                                             \
+    while (!Arr.buf.empty()) {                                                                     \
+        if (Buf.empty()) {                                                                         \
+            /* There's no data from the input, but we need more */                                 \
+            NEO_CORO_YIELD(calc_ret());                                                            \
+        }                                                                                          \
+        /* Copy some bytes */                                                                      \
+        const auto n_read = buffer_copy(Arr.buf, Buf);                                             \
+        /* Advance the buffers by the distance we copied */                                        \
+        Arr.buf += n_read;                                                                         \
+        Buf += n_read;                                                                             \
+    }                                                                                              \
+    NEO_FN_MACRO_END
+
+/**
+ * Read bytes until either Arr is full or we encounter a NUL byte
+ */
+#define CORO_READ_ZSTR(Arr, Buf)                                                                   \
+    NEO_FN_MACRO_BEGIN                                                                             \
+    while (true) {                                                                                 \
+        while (!Arr.buf.empty() && !Buf.empty() && Buf[0] != std::byte(0)) {                       \
+            /* Copy a byte that is non-zero */                                                     \
+            Arr.buf[0] = Buf[0];                                                                   \
+            Buf += 1;                                                                              \
+            Arr.buf += 1;                                                                          \
+        }                                                                                          \
+        if (Arr.buf.empty()) {                                                                     \
+            /* There's no more room in the destination buffer */                                   \
+            break;                                                                                 \
+        }                                                                                          \
+        if (!Buf.empty() && Buf[0] == std::byte(0)) {                                              \
+            /* The next byte is a zero. We're done. */                                             \
+            Buf += 1;                                                                              \
+            break;                                                                                 \
+        }                                                                                          \
+        /* We need more bytes */                                                                   \
+        NEO_CORO_YIELD(calc_ret());                                                                \
+    }                                                                                              \
+    NEO_FN_MACRO_END
+
+/**
+ * Read a single byte from the input and store it in `Byte`
+ */
+#define CORO_READ_BYTE(Byte, Buf)                                                                  \
+    NEO_FN_MACRO_BEGIN                                                                             \
+    if (Buf.empty()) {                                                                             \
+        NEO_CORO_YIELD(calc_ret());                                                                \
+    }                                                                                              \
+    neo_assert(invariant, !Buf.empty(), "Expected more bytes of input");                           \
+    Byte = Buf[0];                                                                                 \
+    Buf += 1;                                                                                      \
+    NEO_FN_MACRO_END
+
+    constexpr decompress_result _step(mutable_buffer out, const_buffer in) {
+        const auto out_init = out;
+        const auto in_init  = in;
+        auto       calc_ret = [&] {
+            return decompress_result{
+                .bytes_written = out_init.size() - out.size(),
+                .bytes_read    = in_init.size() - in.size(),
+                .done          = NEO_CORO_IS_FINISHED(_coro),
+            };
+        };
+
+        if (NEO_CORO_IS_FINISHED(_coro)) {
+            return calc_ret();
+        }
+
+        NEO_CORO_BEGIN(_coro);
+
+        while (true) {
+            // Read the magic number
+            CORO_READ_BUF(_magic, in);
+            if (_magic.bytes[0] != std::byte(0x1f) || _magic.bytes[1] != std::byte(0x8b)) {
+                // Invalid magic number
+                throw std::runtime_error("Invalid gzip magic number");
+            }
+
+            // Read the various gzip header bits
+            CORO_READ_BYTE(_compression_method, in);
+            CORO_READ_BYTE(_flags, in);
+            CORO_READ_BUF(_mtime, in);
+            CORO_READ_BYTE(_xfl, in);
+            CORO_READ_BYTE(_os, in);
+
+            // Optional, fextra:
+            if (_fextra_set()) {
+                CORO_READ_BUF(_xlen, in);
+                if (_xlen_uint16() > _fextra.buf.size()) {
+                    throw std::runtime_error("gzip xlen is larger than supported");
+                }
+                _fextra.buf = _fextra.buf.first(_xlen_uint16());
+                CORO_READ_BUF(_fextra, in);
+                _load_member_dictionary();
+            }
+
+            // Optional, filename:
+            if (_fname_set()) {
+                CORO_READ_ZSTR(_fname, in);
+            }
+
+            // Optional: file comment
+            if (_fcomment_set()) {
+                CORO_READ_ZSTR(_comment, in);
+            }
+
+            // Optional, a header CRC, although we don't actually validate this (yet)
+            if (_fhcrc_set()) {
+                CORO_READ_BUF(_hcrc, in);
+            }
+
+            // Decompress the actual body of the file:
+            while (true) {
+                {
+                    // Decompress a piece of the output
+                    const auto out_part   = out.first(std::min(out.size(), _crc_chunk_size));
+                    const auto decomp_res = _stats.timed(&stream_stats::codec_time, [&] {
+                        return unref(_decompress)(out_part, std::as_const(in));
+                    });
+                    // Update the running CRC
+                    if (_opts.verify_checksum) {
+                        _stats.timed(&stream_stats::checksum_time, [&] {
+                            _actual_crc.feed(out.first(decomp_res.bytes_written));
+                        });
+                    }
+                    // Advance our buffers
+                    in += decomp_res.bytes_read;
+                    out += decomp_res.bytes_written;
+                    // Track how much we've read
+                    _actual_size += decomp_res.bytes_written;
+                    if (decomp_res.done) {
+                        break;
+                    }
+                    if (decomp_res.bytes_written == out_part.size() && !out.empty()) {
+                        // We filled the piece, and there is room for more
+                        continue;
+                    }
+                }
+                // We aren't done yet, so yield until we get more data
+                NEO_CORO_YIELD(calc_ret());
+            }
+
+            // Read the trailing CRC and data size
+            CORO_READ_BUF(_stored_crc32, in);
+            CORO_READ_BUF(_stored_size, in);
+
+            if (_opts.verify_checksum) {
+                // Check that the CRC matches
+                if (_actual_crc.value() != _stored_crc_uint32()) {
+                    throw std::runtime_error("CRC-32 check failed");
+                }
+
+                // And the data size. The stored size is only the low 32 bits.
+                if (static_cast<std::uint32_t>(_actual_size) != _stored_size_uint32()) {
+                    throw std::runtime_error("Data length mismatch");
+                }
+            }
+
+            _member_done = true;
+            if (!_opts.multi_member) {
+                break;
+            }
+
+            // Another member may follow. Wait until we see more input.
+            _reset_member();
+            while (in.empty()) {
+                NEO_CORO_YIELD(calc_ret());
+            }
+            _member_done = false;
+        }
+
+        NEO_CORO_END;
+
+        return calc_ret();
+
+#undef CORO_READ_BYTE
+#undef CORO_READ_BUF
+#undef CORO_READ_ZSTR
+    }
+};
+
+template <decompressor_algorithm D>
+explicit gzip_decompressor(D &&) -> gzip_decompressor<D>;
+
+template <decompressor_algorithm D>
+gzip_decompressor(D&&, const gzip_decompress_options&) -> gzip_decompressor<D>;
+
+}  // namespace neo
@@ -0,0 +1,229 @@
+#include "./lz4.hpp"
+
+#include <neo/buffer_algorithm/copy.hpp>
+
+#include <lz4frame.h>
+
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#define MY_CCTX (static_cast<::LZ4F_cctx*>(_cctx))
+#define MY_DCTX (static_cast<::LZ4F_dctx*>(_dctx))
+
+using namespace neo;
+
+namespace {
+
+::LZ4F_preferences_t make_prefs(const lz4_options& opts) noexcept {
+    ::LZ4F_preferences_t prefs{};
+    prefs.frameInfo.blockSizeID = static_cast<::LZ4F_blockSizeID_t>(opts.block_size);
+    prefs.frameInfo.blockMode   = LZ4F_blockLinked;
+    prefs.frameInfo.contentChecksumFlag
+        = opts.checksum ? LZ4F_contentChecksumEnabled : LZ4F_noContentChecksum;
+    prefs.compressionLevel = opts.level;
+    return prefs;
+}
+
+/// The uncompressed size of a block
+std::size_t block_bytes(lz4_block_size bs) noexcept {
+    return std::size_t(1024 * 64) << (2 * (static_cast<int>(bs) - 4));
+}
+
+std::size_t check_lz4(std::size_t rc, const char* what) {
+    if (::LZ4F_isError(rc)) {
+        throw std::runtime_error(std::string(what) + ": " + ::LZ4F_getErrorName(rc));
+    }
+    return rc;
+}
+
+}  // namespace
+
+lz4_compressor::lz4_compressor(const lz4_options& opts)
+    : _opts(opts) {
+    ::LZ4F_cctx* cctx = nullptr;
+    auto         rc   = ::LZ4F_createCompressionContext(&cctx, LZ4F_VERSION);
+    if (::LZ4F_isError(rc)) {
+        throw std::bad_alloc();
+    }
+    _cctx            = cctx;
+    const auto prefs = make_prefs(opts);
+    // Room for a whole compressed block, which is also enough for the frame header and footer
+    _staging.resize(::LZ4F_compressBound(block_bytes(opts.block_size), &prefs));
+}
+
+lz4_compressor::~lz4_compressor() { ::LZ4F_freeCompressionContext(MY_CCTX); }
+
+lz4_compressor::lz4_compressor(lz4_compressor&& o) noexcept
+    : _cctx(std::exchange(o._cctx, nullptr))
+    , _opts(o._opts)
+    , _staging(std::move(o._staging))
+    , _pending(std::exchange(o._pending, const_buffer()))
+    , _started(o._started)
+    , _end_written(o._end_written)
+    , _finished(o._finished) {}
+
+lz4_compressor& lz4_compressor::operator=(lz4_compressor&& o) noexcept {
+    std::swap(_cctx, o._cctx);
+    std::swap(_opts, o._opts);
+    std::swap(_staging, o._staging);
+    std::swap(_pending, o._pending);
+    std::swap(_started, o._started);
+    std::swap(_end_written, o._end_written);
+    std::swap(_finished, o._finished);
+    return *this;
+}
+
+void lz4_compressor::reset() noexcept {
+    // LZ4F_compressBegin() reinitializes the context for the next frame
+    _pending     = const_buffer();
+    _started     = false;
+    _end_written = false;
+    _finished    = false;
+}
+
+std::size_t lz4_compressor::_drain(mutable_buffer& out) noexcept {
+    const auto n = buffer_copy(out, _pending);
+    out += n;
+    _pending += n;
+    return n;
+}
+
+compress_result lz4_compressor::operator()(mutable_buffer out, const_buffer in, flush f) {
+    const auto out_size = out.size();
+    const auto in_size  = in.size();
+    auto       calc_ret = [&] {
+        return compress_result{
+            .bytes_written = out_size - out.size(),
+            .bytes_read    = in_size - in.size(),
+            .done          = _finished,
+        };
+    };
+
+    if (_finished) {
+        return calc_ret();
+    }
+
+    const auto prefs = make_prefs(_opts);
+
+    /**
+     * Call an LZ4F function that writes at most `bound` bytes. If there is room, the data goes
+     * directly into `out`. Otherwise, it goes into the staging buffer to be copied out later.
+     */
+    auto emit = [&](std::size_t bound, auto&& write, const char* what) {
+        if (out.size() >= bound) {
+            out += check_lz4(write(out.data(), out.size()), what);
+        } else {
+            auto n   = check_lz4(write(_staging.data(), _staging.size()), what);
+            _pending = const_buffer(_staging.data(), n);
+            _drain(out);
+        }
+    };
+
+    _drain(out);
+
+    if (!_started && _pending.empty()) {
+        emit(
+            LZ4F_HEADER_SIZE_MAX,
+            [&](void* dst, std::size_t cap) {
+                return ::LZ4F_compressBegin(MY_CCTX, dst, cap, &prefs);
+            },
+            "Failed to begin an LZ4 frame");
+        _started = true;
+    }
+
+    const auto max_part = block_bytes(_opts.block_size);
+    while (!in.empty() && _pending.empty()) {
+        const auto part = in.first(std::min(in.size(), max_part));
+        emit(
+            ::LZ4F_compressBound(part.size(), &prefs),
+            [&](void* dst, std::size_t cap) {
+                return ::LZ4F_compressUpdate(MY_CCTX, dst, cap, part.data(), part.size(), nullptr);
+            },
+            "LZ4 compression failed");
+        in += part.size();
+    }
+
+    if (in.empty() && _pending.empty() && !_end_written) {
+        if (f == flush::finish) {
+            emit(
+                ::LZ4F_compressBound(0, &prefs),
+                [&](void* dst, std::size_t cap) {
+                    return ::LZ4F_compressEnd(MY_CCTX, dst, cap, nullptr);
+                },
+                "Failed to finish an LZ4 frame");
+            _end_written = true;
+        } else if (f != flush::no_flush) {
+            emit(
+                ::LZ4F_compressBound(0, &prefs),
+                [&](void* dst, std::size_t cap) {
+                    return ::LZ4F_flush(MY_CCTX, dst, cap, nullptr);
+                },
+                "Failed to flush an LZ4 frame");
+        }
+    }
+
+    _finished = _end_written && _pending.empty();
+    return calc_ret();
+}
+
+lz4_decompressor::lz4_decompressor(const lz4_decompress_options& opts)
+    : _opts(opts) {
+    ::LZ4F_dctx* dctx = nullptr;
+    auto         rc   = ::LZ4F_createDecompressionContext(&dctx, LZ4F_VERSION);
+    if (::LZ4F_isError(rc)) {
+        throw std::bad_alloc();
+    }
+    _dctx = dctx;
+}
+
+lz4_decompressor::~lz4_decompressor() { ::LZ4F_freeDecompressionContext(MY_DCTX); }
+
+lz4_decompressor::lz4_decompressor(lz4_decompressor&& o) noexcept
+    : _dctx(std::exchange(o._dctx, nullptr))
+    , _opts(o._opts)
+    , _frame_done(o._frame_done) {}
+
+lz4_decompressor& lz4_decompressor::operator=(lz4_decompressor&& o) noexcept {
+    std::swap(_dctx, o._dctx);
+    std::swap(_opts, o._opts);
+    std::swap(_frame_done, o._frame_done);
+    return *this;
+}
+
+void lz4_decompressor::reset() noexcept {
+    ::LZ4F_resetDecompressionContext(MY_DCTX);
+    _frame_done = false;
+}
+
+decompress_result lz4_decompressor::operator()(mutable_buffer out, const_buffer in) {
+    const auto out_size = out.size();
+    const auto in_size  = in.size();
+    while (!_frame_done || (_opts.multi_frame && !in.empty())) {
+        // Another frame may begin here in multi-frame mode
+        _frame_done       = false;
+        std::size_t n_out = out.size();
+        std::size_t n_in  = in.size();
+        auto        rc
+            = check_lz4(::LZ4F_decompress(MY_DCTX, out.data(), &n_out, in.data(), &n_in, nullptr),
+                        "LZ4 decompression failed");
+        out += n_out;
+        in += n_in;
+        if (rc == 0) {
+            // The frame was fully decoded and flushed
+            _frame_done = true;
+            continue;
+        }
+        if ((n_in == 0 && n_out == 0) || in.empty() || out.empty()) {
+            // More input is needed, or the output is full
+            break;
+        }
+    }
+    return {
+        .bytes_written = out_size - out.size(),
+        .bytes_read    = in_size - in.size(),
+        .done          = _frame_done && !_opts.multi_frame,
+    };
+}
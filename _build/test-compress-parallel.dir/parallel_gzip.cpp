@@ -0,0 +1,645 @@
+#include "./parallel_gzip.hpp"
+
+#include "./bgzf.hpp"
+#include "./crc32.hpp"
+#include "./detail/thread_pool.hpp"
+#include "./gzip.hpp"
+#include "./inflate.hpp"
+
+#include <neo/assert.hpp>
+#include <neo/buffer_algorithm/copy.hpp>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <future>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+using namespace neo;
+
+namespace {
+
+using byte_vec = std::vector<std::byte>;
+
+/// The largest distance that a DEFLATE match may reach backwards
+constexpr std::size_t max_dict_size = 32 * 1024;
+
+/**
+ * A raw-DEFLATE z_stream that is kept alive on each worker thread, so that we
+ * do not pay for deflateInit2() on every block.
+ */
+class worker_deflater {
+    ::z_stream      _strm{};
+    deflate_options _opts;
+    bool            _init = false;
+
+public:
+    worker_deflater() = default;
+    worker_deflater(const worker_deflater&) = delete;
+    ~worker_deflater() {
+        if (_init) {
+            ::deflateEnd(&_strm);
+        }
+    }
+
+    ::z_stream& prepare(const deflate_options& opts) {
+        const bool same_params = _init && opts.level == _opts.level
+            && opts.window_bits == _opts.window_bits && opts.mem_level == _opts.mem_level
+            && opts.strategy == _opts.strategy;
+        if (same_params) {
+            ::deflateReset(&_strm);
+            return _strm;
+        }
+        if (_init) {
+            ::deflateEnd(&_strm);
+            _init = false;
+        }
+        _strm   = ::z_stream{};
+        auto rc = ::deflateInit2(&_strm,
+                                 opts.level,
+                                 Z_DEFLATED,
+                                 -opts.window_bits,
+                                 opts.mem_level,
+                                 static_cast<int>(opts.strategy));
+        if (rc == Z_MEM_ERROR) {
+            throw std::bad_alloc();
+        } else if (rc != Z_OK) {
+            throw std::runtime_error("Failed to initialize the DEFLATE compressor");
+        }
+        _opts = opts;
+        _init = true;
+        return _strm;
+    }
+};
+
+struct block_result {
+    byte_vec      compressed;
+    std::uint32_t crc  = 0;
+    std::size_t   size = 0;
+};
+
+/**
+ * Compress a single block. Non-final blocks end with a sync flush so that they
+ * end on a byte boundary and can be concatenated with the next block.
+ */
+block_result compress_block(const deflate_options& opts,
+                            const byte_vec&        block,
+                            const byte_vec&        dict,
+                            bool                   last) {
+    thread_local worker_deflater deflater;
+    auto&                        strm = deflater.prepare(opts);
+    if (!dict.empty()) {
+        ::deflateSetDictionary(&strm,
+                               reinterpret_cast<const ::Bytef*>(dict.data()),
+                               static_cast<uInt>(dict.size()));
+    }
+
+    block_result ret;
+    ret.size = block.size();
+    ret.crc  = crc32::calc(const_buffer(block.data(), block.size()));
+    // Room for the compressed data, plus the empty stored block of a sync flush
+    ret.compressed.resize(::deflateBound(&strm, static_cast<uLong>(block.size())) + 16);
+
+    strm.next_in   = const_cast<::Bytef*>(reinterpret_cast<const ::Bytef*>(block.data()));
+    strm.avail_in  = static_cast<uInt>(block.size());
+    strm.next_out  = reinterpret_cast<::Bytef*>(ret.compressed.data());
+    strm.avail_out = static_cast<uInt>(ret.compressed.size());
+    while (true) {
+        auto rc = ::deflate(&strm, last ? Z_FINISH : Z_SYNC_FLUSH);
+        neo_assert(invariant,
+                   rc == Z_OK || rc == Z_STREAM_END || rc == Z_BUF_ERROR,
+                   "deflate() failed unexpectedly while compressing a block",
+                   rc);
+        if (strm.avail_out != 0 || rc == Z_STREAM_END) {
+            // The block has been fully flushed
+            break;
+        }
+        // Should not happen given deflateBound(), but grow the buffer if needed
+        auto n_used = ret.compressed.size();
+        ret.compressed.resize(n_used * 2);
+        strm.next_out  = reinterpret_cast<::Bytef*>(ret.compressed.data() + n_used);
+        strm.avail_out = static_cast<uInt>(ret.compressed.size() - n_used);
+    }
+    ret.compressed.resize(ret.compressed.size() - strm.avail_out);
+    return ret;
+}
+
+struct member_result {
+    byte_vec output;
+    // Whether the end of a gzip member was reached
+    bool member_done = false;
+    // The amount of input that belonged to the member
+    std::size_t bytes_read = 0;
+};
+
+/// The smallest possible gzip member: A header, an empty DEFLATE block, and a trailer
+constexpr std::size_t min_member_size = 20;
+
+/**
+ * Decompress a single gzip member. If the input ends before the member does,
+ * the result has `member_done == false`.
+ */
+member_result decompress_member(const byte_vec& input) {
+    thread_local gzip_decompressor<inflate_decompressor> gz;
+    gz.reset();
+
+    member_result ret;
+    // The trailer gives the size of the output (modulo 2^32). Use it as a hint, within reason.
+    std::size_t size_hint = 0;
+    if (input.size() >= 4) {
+        auto p    = input.data() + input.size() - 4;
+        size_hint = std::size_t(p[0]) | (std::size_t(p[1]) << 8) | (std::size_t(p[2]) << 16)
+            | (std::size_t(p[3]) << 24);
+    }
+    ret.output.resize(std::clamp<std::size_t>(size_hint, 1024, 1024 * 1024 * 64));
+
+    auto        in    = const_buffer(input.data(), input.size());
+    std::size_t n_out = 0;
+    while (true) {
+        auto res = gz(mutable_buffer(ret.output.data() + n_out, ret.output.size() - n_out), in);
+        in += res.bytes_read;
+        n_out += res.bytes_written;
+        if (res.done) {
+            ret.member_done = true;
+            break;
+        }
+        if (n_out != ret.output.size()) {
+            // There was room for more output, so the input ran out
+            break;
+        }
+        ret.output.resize(ret.output.size() * 2);
+    }
+    ret.output.resize(n_out);
+    ret.bytes_read = input.size() - in.size();
+    return ret;
+}
+
+void append_le32(byte_vec& out, std::uint32_t v) {
+    out.push_back(std::byte(v));
+    out.push_back(std::byte(v >> 8));
+    out.push_back(std::byte(v >> 16));
+    out.push_back(std::byte(v >> 24));
+}
+
+}  // namespace
+
+struct parallel_gzip_compressor::state {
+    parallel_gzip_options opts;
+    detail::thread_pool   pool;
+    std::size_t           max_in_flight;
+
+    // The block of input that is being filled
+    byte_vec cur_block;
+    // The final bytes of all input prior to `cur_block`
+    std::shared_ptr<const byte_vec> dict = std::make_shared<byte_vec>();
+    // Blocks that have been sent to the workers, in order
+    std::deque<std::future<block_result>> in_flight;
+
+    // Output that is ready to be written
+    byte_vec    pending;
+    std::size_t pending_pos = 0;
+
+    std::uint32_t crc             = 0;
+    std::uint32_t size            = 0;
+    bool          header_queued   = false;
+    bool          final_submitted = false;
+    bool          trailer_queued  = false;
+    bool          done            = false;
+
+    explicit state(const parallel_gzip_options& o)
+        : opts(o)
+        , pool(o.thread_count)
+        // Keep enough blocks in-flight to keep all the workers busy while we collect results
+        , max_in_flight(pool.size() * 2) {
+        neo_assert(expects, opts.block_size > 0, "parallel_gzip block_size must be non-zero");
+        cur_block.reserve(opts.block_size);
+    }
+
+    void submit(bool last) {
+        auto block = std::make_shared<byte_vec>(std::move(cur_block));
+        auto dict  = this->dict;
+        in_flight.push_back(pool.submit([block, dict, last, d_opts = opts.deflate] {
+            return compress_block(d_opts, *block, *dict, last);
+        }));
+
+        // The dictionary for the next block is the tail of all of the data up to this point
+        auto next_dict = std::make_shared<byte_vec>();
+        if (block->size() < max_dict_size) {
+            const auto n_keep = std::min(dict->size(), max_dict_size - block->size());
+            next_dict->insert(next_dict->end(), dict->end() - n_keep, dict->end());
+        }
+        const auto n_take = std::min(block->size(), max_dict_size);
+        next_dict->insert(next_dict->end(), block->end() - n_take, block->end());
+        this->dict = std::move(next_dict);
+
+        cur_block = byte_vec();
+        cur_block.reserve(opts.block_size);
+    }
+
+    bool front_ready() const {
+        return !in_flight.empty()
+            && in_flight.front().wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    /// Wait for the oldest in-flight block and queue its output.
+    void collect_front() {
+        auto res = in_flight.front().get();
+        in_flight.pop_front();
+        crc = crc32::combine(crc, res.crc, res.size);
+        size += static_cast<std::uint32_t>(res.size);
+        pending.insert(pending.end(), res.compressed.begin(), res.compressed.end());
+    }
+
+    /// Copy as much pending output as possible. Returns the number of bytes written.
+    std::size_t drain(mutable_buffer& out) {
+        auto n = buffer_copy(out, const_buffer(pending.data(), pending.size()) + pending_pos);
+        out += n;
+        pending_pos += n;
+        if (pending_pos == pending.size()) {
+            pending.clear();
+            pending_pos = 0;
+        }
+        return n;
+    }
+
+    bool has_pending() const noexcept { return !pending.empty(); }
+
+    void queue_header() {
+        // Magic, DEFLATE, no flags, mtime (unsupported), no extra flags, unknown OS. This matches
+        // the header written by gzip_compressor.
+        const unsigned char header[]
+            = {0x1f, 0x8b, 0x08, 0x00, 0xde, 0xad, 0xbe, 0xef, 0x00, 0xff};
+        for (auto c : header) {
+            pending.push_back(std::byte(c));
+        }
+    }
+
+    void queue_trailer() {
+        append_le32(pending, crc);
+        append_le32(pending, size);
+    }
+
+    void wait_all() noexcept {
+        for (auto& fut : in_flight) {
+            fut.wait();
+        }
+        in_flight.clear();
+    }
+};
+
+parallel_gzip_compressor::parallel_gzip_compressor(const parallel_gzip_options& opts)
+    : _state(std::make_unique<state>(opts)) {}
+
+parallel_gzip_compressor::~parallel_gzip_compressor() {
+    if (_state) {
+        _state->wait_all();
+    }
+}
+
+parallel_gzip_compressor::parallel_gzip_compressor(parallel_gzip_compressor&&) noexcept = default;
+parallel_gzip_compressor&
+parallel_gzip_compressor::operator=(parallel_gzip_compressor&&) noexcept = default;
+
+void parallel_gzip_compressor::reset() noexcept {
+    auto& st = *_state;
+    st.wait_all();
+    st.cur_block.clear();
+    st.dict            = std::make_shared<byte_vec>();
+    st.pending.clear();
+    st.pending_pos     = 0;
+    st.crc             = 0;
+    st.size            = 0;
+    st.header_queued   = false;
+    st.final_submitted = false;
+    st.trailer_queued  = false;
+    st.done            = false;
+}
+
+compress_result parallel_gzip_compressor::operator()(mutable_buffer out, const_buffer in, flush f) {
+    auto& st = *_state;
+    neo_assert(expects,
+               !st.done,
+               "Application reused parallel_gzip_compressor without calling .reset()");
+
+    const auto in_size  = in.size();
+    const auto out_size = out.size();
+
+    if (!st.header_queued) {
+        st.queue_header();
+        st.header_queued = true;
+    }
+
+    while (true) {
+        st.drain(out);
+        if (st.has_pending()) {
+            // The output is full
+            break;
+        }
+        if (st.front_ready()) {
+            st.collect_front();
+            continue;
+        }
+        if (!in.empty()) {
+            if (st.in_flight.size() >= st.max_in_flight) {
+                // Too much work queued. Wait for the oldest block to finish.
+                st.collect_front();
+                continue;
+            }
+            const auto n_take = std::min(in.size(), st.opts.block_size - st.cur_block.size());
+            st.cur_block.insert(st.cur_block.end(), in.data(), in.data() + n_take);
+            in += n_take;
+            if (st.cur_block.size() == st.opts.block_size) {
+                st.submit(false);
+            }
+            continue;
+        }
+        // We've consumed all of the input
+        if (f == flush::no_flush) {
+            break;
+        }
+        if (f == flush::finish) {
+            if (!st.final_submitted) {
+                st.submit(true);
+                st.final_submitted = true;
+            } else if (!st.in_flight.empty()) {
+                st.collect_front();
+            } else if (!st.trailer_queued) {
+                st.queue_trailer();
+                st.trailer_queued = true;
+            } else {
+                st.done = true;
+                break;
+            }
+            continue;
+        }
+        // Any other flush: Push all input through to the output
+        if (!st.cur_block.empty()) {
+            st.submit(false);
+        } else if (!st.in_flight.empty()) {
+            st.collect_front();
+        } else {
+            break;
+        }
+    }
+
+    return {
+        .bytes_written = out_size - out.size(),
+        .bytes_read    = in_size - in.size(),
+        .done          = st.done,
+    };
+}
+
+struct parallel_gzip_decoder::state {
+    struct job {
+        std::shared_ptr<const byte_vec> input;
+        std::future<member_result>      result;
+    };
+
+    parallel_gzip_decompress_options opts;
+    detail::thread_pool              pool;
+    std::size_t                      max_in_flight;
+
+    // Members that have been sent to the workers, in order
+    std::deque<job> jobs;
+
+    // Input that has not been assigned to a member
+    byte_vec    input;
+    std::size_t input_pos = 0;
+    // Where to resume searching for the next member, relative to `input_pos`
+    std::size_t search_pos = min_member_size;
+    bool        eof        = false;
+
+    // Decompressed data that is ready to be read
+    byte_vec    ready;
+    std::size_t ready_pos = 0;
+
+    // Used when decompression falls back to the calling thread
+    std::optional<gzip_decompressor<inflate_decompressor>> sequential;
+    bool                                                    finished = false;
+
+    explicit state(const parallel_gzip_decompress_options& o)
+        : opts(o)
+        , pool(o.thread_count)
+        , max_in_flight(pool.size() * 2) {}
+
+    const_buffer unassigned() const noexcept {
+        return const_buffer(input.data(), input.size()) + input_pos;
+    }
+
+    bool wants_input() const noexcept {
+        if (eof) {
+            return false;
+        }
+        if (sequential) {
+            return unassigned().size() < opts.max_member_size;
+        }
+        return jobs.size() < max_in_flight && unassigned().size() < opts.max_member_size;
+    }
+
+    void feed(const_buffer in) {
+        if (input_pos > input.size() / 2) {
+            // Discard input that has already been assigned
+            input.erase(input.begin(), input.begin() + static_cast<std::ptrdiff_t>(input_pos));
+            input_pos = 0;
+        }
+        input.insert(input.end(), in.data(), in.data() + in.size());
+        dispatch();
+    }
+
+    /**
+     * Find the size of the member at the front of the unassigned input. Returns
+     * zero if the end of the member cannot yet be determined.
+     */
+    std::size_t next_member_size() {
+        const auto avail = unassigned();
+        if (avail.size() < 12 && !eof) {
+            return 0;
+        }
+        // A BGZF block gives us its size
+        if (avail.size() >= 12 && (avail[3] & std::byte(0x04)) != std::byte(0)) {
+            const auto xlen = std::size_t(avail[10]) | (std::size_t(avail[11]) << 8);
+            if (avail.size() < 12 + xlen && !eof) {
+                return 0;
+            }
+            if (auto bsize = bgzf_block_size(avail); bsize && search_pos <= min_member_size) {
+                if (avail.size() < *bsize && !eof) {
+                    return 0;
+                }
+                return std::min(*bsize, avail.size());
+            }
+        }
+        // Search for the magic number and compression method of the next member
+        auto p = avail.data();
+        for (; search_pos + 3 < avail.size(); ++search_pos) {
+            auto c = p + search_pos;
+            if (c[0] == std::byte(0x1f) && c[1] == std::byte(0x8b) && c[2] == std::byte(0x08)
+                && (c[3] & std::byte(0xe0)) == std::byte(0)) {
+                return search_pos;
+            }
+        }
+        if (eof) {
+            return avail.size();
+        }
+        if (avail.size() >= opts.max_member_size) {
+            // This member is too large to buffer. Decompress the rest of the stream on the
+            // calling thread.
+            sequential.emplace(gzip_decompress_options{.multi_member = true});
+        }
+        return 0;
+    }
+
+    /// Send as many members as possible to the workers
+    void dispatch() {
+        while (!sequential && jobs.size() < max_in_flight && !unassigned().empty()) {
+            const auto size = next_member_size();
+            if (size == 0) {
+                break;
+            }
+            auto bytes = std::make_shared<byte_vec>(unassigned().data(),
+                                                    unassigned().data() + size);
+            input_pos += size;
+            search_pos = min_member_size;
+            jobs.push_back({bytes, pool.submit([bytes] { return decompress_member(*bytes); })});
+        }
+    }
+
+    /**
+     * Return the input of the front member (starting at `from`) and all later
+     * members to the unassigned input, to be divided again.
+     */
+    void rewind(const byte_vec& front, std::size_t from, std::size_t new_search_pos) {
+        byte_vec restored(front.begin() + static_cast<std::ptrdiff_t>(from), front.end());
+        for (auto& j : jobs) {
+            restored.insert(restored.end(), j.input->begin(), j.input->end());
+        }
+        // The results of later members are discarded. Any errors they had are due to the bad
+        // member boundary.
+        jobs.clear();
+        auto rest = unassigned();
+        restored.insert(restored.end(), rest.data(), rest.data() + rest.size());
+        input      = std::move(restored);
+        input_pos  = 0;
+        search_pos = new_search_pos;
+    }
+
+    /// Wait for the front member and make its output ready
+    void collect_front() {
+        auto front = std::move(jobs.front());
+        jobs.pop_front();
+        auto res = front.result.get();
+        if (res.member_done && res.bytes_read == front.input->size()) {
+            // The member ended exactly where we expected
+            ready = std::move(res.output);
+        } else if (res.member_done) {
+            // The member ended before the boundary we found. The rest is the next member.
+            ready = std::move(res.output);
+            rewind(*front.input, res.bytes_read, min_member_size);
+        } else {
+            // The boundary was a false match inside the member's data
+            if (eof && jobs.empty() && unassigned().empty()) {
+                throw std::runtime_error("Unexpected end of gzip data");
+            }
+            rewind(*front.input, 0, front.input->size() + 1);
+        }
+        ready_pos = 0;
+        dispatch();
+    }
+
+    /// Decompress on the calling thread. Returns `false` if no progress was made.
+    bool decode_sequential() {
+        ready.resize(1024 * 256);
+        auto res = (*sequential)(mutable_buffer(ready.data(), ready.size()), unassigned());
+        input_pos += res.bytes_read;
+        ready.resize(res.bytes_written);
+        ready_pos = 0;
+        if (res.bytes_written != 0) {
+            return true;
+        }
+        if (eof && unassigned().empty()) {
+            if (!sequential->at_member_boundary()) {
+                throw std::runtime_error("Unexpected end of gzip data");
+            }
+            finished = true;
+        }
+        return false;
+    }
+
+    bool front_ready() const {
+        return jobs.front().result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    const_buffer output() {
+        while (ready_pos == ready.size()) {
+            ready.clear();
+            ready_pos = 0;
+            if (!jobs.empty()) {
+                if (!front_ready() && wants_input()) {
+                    // Let the caller give us more work while the workers are busy
+                    return {};
+                }
+                collect_front();
+                continue;
+            }
+            if (sequential) {
+                if (!decode_sequential()) {
+                    return {};
+                }
+                continue;
+            }
+            if (eof && unassigned().empty()) {
+                finished = true;
+            }
+            return {};
+        }
+        return const_buffer(ready.data(), ready.size()) + ready_pos;
+    }
+
+    void wait_all() noexcept {
+        for (auto& j : jobs) {
+            j.result.wait();
+        }
+        jobs.clear();
+    }
+};
+
+parallel_gzip_decoder::parallel_gzip_decoder(const parallel_gzip_decompress_options& opts)
+    : _state(std::make_unique<state>(opts)) {}
+
+parallel_gzip_decoder::~parallel_gzip_decoder() {
+    if (_state) {
+        _state->wait_all();
+    }
+}
+
+parallel_gzip_decoder::parallel_gzip_decoder(parallel_gzip_decoder&&) noexcept = default;
+parallel_gzip_decoder& parallel_gzip_decoder::operator=(parallel_gzip_decoder&&) noexcept = default;
+
+bool parallel_gzip_decoder::wants_input() const noexcept { return _state->wants_input(); }
+
+void parallel_gzip_decoder::feed(const_buffer in) {
+    neo_assert(expects, !_state->eof, "parallel_gzip_decoder given input after finish_input()");
+    _state->feed(in);
+}
+
+void parallel_gzip_decoder::finish_input() {
+    _state->eof = true;
+    _state->dispatch();
+}
+
+const_buffer parallel_gzip_decoder::output() { return _state->output(); }
+
+void parallel_gzip_decoder::consume_output(std::size_t n) noexcept {
+    auto& st = *_state;
+    neo_assert(expects,
+               n <= st.ready.size() - st.ready_pos,
+               "Consumed more output than was available from the parallel_gzip_decoder",
+               n,
+               st.ready.size() - st.ready_pos);
+    st.ready_pos += n;
+}
+
+bool parallel_gzip_decoder::done() const noexcept { return _state->finished; }
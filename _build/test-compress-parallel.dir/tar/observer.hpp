@@ -0,0 +1,110 @@
+#pragma once
+
+#include "./ustar.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+
+namespace neo {
+
+/**
+ * The work done for a single archive member by compress_directory_targz(),
+ * compress_directory_tarzst(), expand_directory_targz(), or
+ * expand_directory_tarzst().
+ */
+struct tar_member_event {
+    using duration = std::chrono::nanoseconds;
+
+    /// The header of the member
+    const ustar_member_info& info;
+    /// The file on disk that the member was read from or extracted to
+    const std::filesystem::path& path;
+    /// The number of bytes of member data that were copied
+    std::uint64_t data_bytes = 0;
+    /// Time spent opening the file on disk
+    duration open_time{};
+    /**
+     * Time spent reading the member data: From the archive (including
+     * decompression) when extracting, or from the file when creating.
+     */
+    duration read_time{};
+    /**
+     * Time spent writing the member data: To the file when extracting, or into
+     * the archive (including compression) when creating.
+     */
+    duration write_time{};
+    /// Time spent closing the file on disk
+    duration close_time{};
+    /// Time spent creating directories and links, and restoring permissions
+    duration metadata_time{};
+};
+
+/**
+ * Progress through a tar pipeline, as a snapshot of running totals.
+ */
+struct tar_progress {
+    /// The compressed bytes consumed from the input (extract) or written to the output (create)
+    std::uint64_t compressed_bytes = 0;
+    /// The uncompressed tar bytes produced (extract) or given to the compressor (create)
+    std::uint64_t uncompressed_bytes = 0;
+    /// The number of members that have been fully processed
+    std::uint64_t members_done = 0;
+};
+
+/**
+ * Receives events from the tar archive pipelines. Override the member
+ * functions for the events of interest: The defaults do nothing. Give a
+ * pointer to an observer in compress_options or expand_options. When none is
+ * given, the pipelines do not read the clock or make any calls.
+ *
+ * The member functions are called on the thread that runs the pipeline.
+ */
+class tar_observer {
+public:
+    using duration = std::chrono::nanoseconds;
+
+    virtual ~tar_observer() = default;
+
+    /**
+     * The number of uncompressed bytes between calls to on_progress(). Progress
+     * is also reported when the pipeline finishes.
+     */
+    std::uint64_t progress_interval = 1024 * 1024 * 16;
+
+    /// Called when a member header has been decoded (extract) or encoded (create)
+    virtual void on_member_header(const ustar_member_info&) {}
+    /// Called when all of the work for a member is done
+    virtual void on_member_done(const tar_member_event&) {}
+    /// Called when a directory has been created while extracting
+    virtual void on_directory_created(const std::filesystem::path&, duration) {}
+    /// Called periodically with the progress so far
+    virtual void on_progress(const tar_progress&) {}
+};
+
+namespace detail {
+
+/**
+ * Invoke `fn`. If there is an observer, add the time that it takes to `counter`.
+ */
+template <typename Func>
+decltype(auto) observe_time(tar_observer* obs, tar_observer::duration& counter, Func&& fn) {
+    using clock = std::chrono::steady_clock;
+    struct timer {
+        tar_observer::duration* counter;
+        clock::time_point       start;
+
+        ~timer() {
+            if (counter) {
+                *counter += std::chrono::duration_cast<tar_observer::duration>(clock::now()
+                                                                               - start);
+            }
+        }
+    };
+    timer t{obs ? &counter : nullptr, obs ? clock::now() : clock::time_point()};
+    return fn();
+}
+
+}  // namespace detail
+
+}  // namespace neo
@@ -0,0 +1,270 @@
+#include <neo/tar/util.hpp>
+
+#include <neo/gzip.hpp>
+#include <neo/inflate.hpp>
+#include <neo/tar/ustar.hpp>
+
+#include <neo/as_dynamic_buffer.hpp>
+#include <neo/iostream_io.hpp>
+#include <neo/string_io.hpp>
+#include <neo/transform_io.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+const auto THIS_DIR  = fs::path(__FILE__).parent_path();
+const auto ROOT      = THIS_DIR.parent_path().parent_path().parent_path();
+const auto BUILD_DIR = ROOT / "_build";
+
+TEST_CASE("Compress a directory") {
+    auto dest = BUILD_DIR / "test-compress.tar.gz";
+    neo::compress_directory_targz(THIS_DIR.parent_path(), dest);
+
+    neo::buffer_transform_source gz_data{
+        neo::iostream_io{std::ifstream{dest, std::ios::binary}},
+        neo::gzip_decompressor{neo::inflate_decompressor{}},
+    };
+
+    neo::ustar_reader reader{gz_data};
+    auto              mem = reader.next_member().value();
+    CHECK(mem.filename_str() != "");
+}
+
+TEST_CASE("Expand a directory") {
+    auto dest = BUILD_DIR / "test-expand.dir";
+    fs::remove_all(dest);
+    fs::create_directories(dest);
+    neo::expand_directory_targz(dest, ROOT / "data/test.tar.gz");
+    CHECK(fs::is_regular_file(dest / "01-test.txt"));
+    CHECK(fs::is_regular_file(dest / "02-test.txt"));
+    CHECK(fs::is_directory(dest / "subdir"));
+    CHECK(fs::is_regular_file(dest / "subdir/thing.txt"));
+    CHECK(std::distance(fs::recursive_directory_iterator(dest), fs::recursive_directory_iterator())
+          == 4);
+
+    neo::string_dynbuf_io str;
+    neo::buffer_copy(str,
+                     neo::iostream_io(std::ifstream{dest / "subdir/thing.txt", std::ios::binary}));
+    CHECK(str.read_area_view()
+          == "I'm just another file, but in a subdirectory!\n\n- The Sign Painter");
+}
+
+TEST_CASE("Expand an archive containing pax extensions") {
+    auto dest = BUILD_DIR / "test-expand.dir";
+    fs::remove_all(dest);
+    fs::create_directories(dest);
+    auto tgz_in = ROOT / "data/neo-buffer-0.4.2.tar.gz";
+    neo::expand_directory_targz(dest, tgz_in);
+    CHECK(fs::is_regular_file(dest / "neo-buffer-0.4.2/package.jsonc"));
+
+    neo::string_dynbuf_io str;
+    neo::buffer_copy(str,
+                     neo::iostream_io(
+                         std::ifstream{dest / "neo-buffer-0.4.2/package.jsonc", std::ios::binary}));
+    CHECK(str.read_area_view() == R"({
+    "name": "neo-buffer",
+    "version": "0.4.2",
+    "namespace": "neo",
+    "test_driver": "Catch-Main",
+    "depends": [
+        "neo-concepts^0.4.0",
+        "neo-fun^0.4.1"
+    ]
+})");
+
+    fs::remove_all(dest);
+    fs::create_directories(dest);
+    neo::expand_directory_targz(
+        neo::expand_options{
+            .destination_directory = dest,
+            .input_name            = tgz_in.string(),
+            .strip_components      = 1,
+        },
+        tgz_in);
+    // We've stripped on directory component
+    CHECK(fs::is_regular_file(dest / "package.jsonc"));
+}
+
+namespace {
+
+struct recording_observer : neo::tar_observer {
+    std::vector<std::string>       headers;
+    std::vector<fs::path>          directories;
+    std::uint64_t                  data_bytes = 0;
+    std::vector<neo::tar_progress> progress;
+
+    void on_member_header(const neo::ustar_member_info& info) override {
+        headers.emplace_back(info.filename_str());
+    }
+    void on_member_done(const neo::tar_member_event& ev) override { data_bytes += ev.data_bytes; }
+    void on_directory_created(const fs::path& dir, duration) override {
+        directories.push_back(dir);
+    }
+    void on_progress(const neo::tar_progress& p) override { progress.push_back(p); }
+};
+
+}  // namespace
+
+TEST_CASE("Observe the expansion of an archive") {
+    auto dest = BUILD_DIR / "test-expand-observed.dir";
+    fs::remove_all(dest);
+    fs::create_directories(dest);
+
+    recording_observer obs;
+    obs.progress_interval = 1;
+    auto tgz_in           = ROOT / "data/test.tar.gz";
+    neo::expand_directory_targz(
+        neo::expand_options{
+            .destination_directory = dest,
+            .input_name            = tgz_in.string(),
+            .observer              = &obs,
+        },
+        tgz_in);
+
+    CHECK(obs.headers.size() == 4);
+    REQUIRE(obs.directories.size() == 1);
+    CHECK(fs::equivalent(obs.directories[0], dest / "subdir"));
+    CHECK(obs.data_bytes > 0);
+    REQUIRE(obs.progress.size() > 1);
+    const auto& last = obs.progress.back();
+    CHECK(last.members_done == 4);
+    CHECK(last.compressed_bytes > 0);
+    CHECK(last.compressed_bytes <= fs::file_size(tgz_in));
+    CHECK(last.uncompressed_bytes > last.compressed_bytes);
+}
+
+TEST_CASE("Observe the creation of an archive") {
+    auto dest = BUILD_DIR / "test-compress-observed.tar.gz";
+
+    recording_observer obs;
+    neo::compress_directory_targz(THIS_DIR, dest, neo::compress_options{.observer = &obs});
+
+    CHECK(obs.headers.size() >= 4);
+    CHECK(obs.directories.empty());
+    REQUIRE(obs.progress.size() == 1);
+    CHECK(obs.progress[0].members_done == obs.headers.size());
+    CHECK(obs.progress[0].compressed_bytes == fs::file_size(dest));
+    CHECK(obs.progress[0].uncompressed_bytes > obs.data_bytes);
+}
+
+TEST_CASE("Observe the creation of a zstd archive") {
+    auto dest = BUILD_DIR / "test-compress-observed.tar.zst";
+
+    recording_observer obs;
+    neo::compress_directory_tarzst(THIS_DIR,
+                                   dest,
+                                   neo::compress_options{.read_threads = 2, .observer = &obs});
+
+    CHECK(obs.headers.size() >= 4);
+    REQUIRE(obs.progress.size() == 1);
+    CHECK(obs.progress[0].members_done == obs.headers.size());
+    CHECK(obs.progress[0].compressed_bytes == fs::file_size(dest));
+    CHECK(obs.progress[0].uncompressed_bytes > obs.data_bytes);
+}
+
+TEST_CASE("Compress a directory using multiple threads") {
+    auto dest = BUILD_DIR / "test-compress-parallel.tar.gz";
+    neo::compress_directory_targz(THIS_DIR.parent_path(),
+                                  dest,
+                                  neo::compress_options{.thread_count = 4});
+
+    auto expand_dest = BUILD_DIR / "test-compress-parallel.dir";
+    fs::remove_all(expand_dest);
+    fs::create_directories(expand_dest);
+    neo::expand_directory_targz(expand_dest, dest);
+    CHECK(fs::is_regular_file(expand_dest / "tar/util.cpp"));
+}
+
+TEST_CASE("Read files ahead of the archive writer") {
+    // A small read-ahead limit makes the larger files fall back to being read by the writer
+    auto read_ahead = GENERATE(std::size_t(1024 * 1024 * 64), std::size_t(1024 * 64));
+    auto serial     = BUILD_DIR / "test-compress-serial.tar.gz";
+    auto prefetched = BUILD_DIR / "test-compress-prefetched.tar.gz";
+    neo::compress_directory_targz(THIS_DIR.parent_path(), serial);
+
+    recording_observer obs;
+    neo::compress_directory_targz(THIS_DIR.parent_path(),
+                                  prefetched,
+                                  neo::compress_options{
+                                      .read_threads     = 4,
+                                      .read_ahead_bytes = read_ahead,
+                                      .observer         = &obs,
+                                  });
+
+    auto read_file = [](const fs::path& p) {
+        neo::string_dynbuf_io str;
+        neo::buffer_copy(str, neo::iostream_io(std::ifstream{p, std::ios::binary}));
+        return std::string(str.read_area_view());
+    };
+    CHECK(read_file(serial) == read_file(prefetched));
+    REQUIRE(obs.progress.size() == 1);
+    CHECK(obs.progress[0].members_done == obs.headers.size());
+    CHECK(obs.progress[0].compressed_bytes == fs::file_size(prefetched));
+}
+
+TEST_CASE("Write extracted files on multiple threads") {
+    // A small limit makes the larger files fall back to being written by the decoding thread
+    auto write_behind = GENERATE(std::size_t(1024 * 1024 * 64), std::size_t(1024 * 64));
+    auto archive      = BUILD_DIR / "test-expand-parallel.tar.gz";
+    neo::compress_directory_targz(THIS_DIR.parent_path(), archive);
+
+    auto dest = BUILD_DIR / "test-expand-parallel.dir";
+    fs::remove_all(dest);
+    fs::create_directories(dest);
+    recording_observer obs;
+    neo::expand_directory_targz(
+        neo::expand_options{
+            .destination_directory = dest,
+            .input_name            = archive.string(),
+            .write_threads         = 4,
+            .write_behind_bytes    = write_behind,
+            .observer              = &obs,
+        },
+        archive);
+
+    auto read_file = [](const fs::path& p) {
+        neo::string_dynbuf_io str;
+        neo::buffer_copy(str, neo::iostream_io(std::ifstream{p, std::ios::binary}));
+        return std::string(str.read_area_view());
+    };
+    std::size_t n_files = 0;
+    for (auto& item : fs::recursive_directory_iterator(THIS_DIR.parent_path())) {
+        auto expanded = dest / item.path().lexically_relative(THIS_DIR.parent_path());
+        if (item.is_directory()) {
+            CHECK(fs::is_directory(expanded));
+        } else {
+            CHECK(read_file(expanded) == read_file(item.path()));
+            ++n_files;
+        }
+    }
+    CHECK(n_files > 0);
+    REQUIRE_FALSE(obs.progress.empty());
+    CHECK(obs.progress.back().members_done == obs.headers.size());
+}
+
+TEST_CASE("Compress and expand a directory with zstd") {
+    auto threads = GENERATE(1u, 4u);
+    auto dest    = BUILD_DIR / "test-compress.tar.zst";
+    neo::compress_directory_tarzst(THIS_DIR.parent_path(),
+                                   dest,
+                                   neo::zstd_options{.thread_count = threads});
+
+    auto expand_dest = BUILD_DIR / "test-compress-zst.dir";
+    fs::remove_all(expand_dest);
+    fs::create_directories(expand_dest);
+    neo::expand_directory_tarzst(expand_dest, dest);
+    CHECK(fs::is_regular_file(expand_dest / "tar/util.cpp"));
+
+    neo::string_dynbuf_io expanded;
+    neo::buffer_copy(expanded,
+                     neo::iostream_io(
+                         std::ifstream{expand_dest / "tar/util.cpp", std::ios::binary}));
+    neo::string_dynbuf_io original;
+    neo::buffer_copy(original, neo::iostream_io(std::ifstream{THIS_DIR / "util.cpp"}));
+    CHECK(expanded.string() == original.string());
+}
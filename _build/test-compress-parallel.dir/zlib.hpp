@@ -0,0 +1,436 @@
+#pragma once
+
+#include <neo/adler32.hpp>
+#include <neo/compress.hpp>
+#include <neo/decompress.hpp>
+#include <neo/gzip.hpp>
+
+#include <neo/assert.hpp>
+#include <neo/buffer_algorithm/copy.hpp>
+#include <neo/const_buffer.hpp>
+#include <neo/ref.hpp>
+#include <neo/switch_coro.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+namespace neo {
+
+/**
+ * A zlib_compressor compresses a stream in the zlib format (RFC 1950), using
+ * `InnerCompressor` to compress the actual body data.
+ *
+ * The zlib format is a two-byte header, the deflate data, and an Adler-32
+ * of the uncompressed data. It is much lighter than gzip, and is what PNG,
+ * HTTP "deflate" encoding, and many file formats use internally.
+ */
+template <compressor_algorithm InnerCompressor>
+class zlib_compressor {
+    [[no_unique_address]] wrap_refs_t<InnerCompressor> _compressor;
+
+    /**
+     * The input is handed to the inner compressor in pieces of this size, so
+     * that the Adler-32 of each piece is computed while it is still hot in the
+     * cache.
+     */
+    static constexpr std::size_t _adler_chunk_size = 1024 * 64;
+
+    const_buffer  _dictionary;
+    std::uint32_t _dictionary_id  = 0;
+    bool          _has_dictionary = false;
+    adler32       _adler;
+    std::size_t   _num_header_bytes_written = 0;
+    std::size_t   _num_adler_bytes_written  = 0;
+    int           _coro                     = 0;
+
+    /// The size of the header: CMF and FLG, then the DICTID if there is a dictionary
+    constexpr std::size_t _header_size() const noexcept { return _has_dictionary ? 6 : 2; }
+
+    /**
+     * Fill `bytes` with the header. The window size and the compression level
+     * are taken from the inner compressor's options, if it has any.
+     */
+    constexpr void _make_header(std::byte (&bytes)[6]) const noexcept {
+        int window_bits = 15;
+        int flevel      = 2;
+        if constexpr (requires { unref(_compressor).options().window_bits; }) {
+            window_bits = unref(_compressor).options().window_bits;
+        }
+        if constexpr (requires { unref(_compressor).options().level; }) {
+            // The same mapping as zlib uses. The level is informational only. A level of -1
+            // selects zlib's default, which is 6.
+            const int opt_level = unref(_compressor).options().level;
+            const int level     = opt_level < 0 ? 6 : opt_level;
+            flevel          = level < 2 ? 0 : level < 6 ? 1 : level == 6 ? 2 : 3;
+        }
+        // CM = 8 (deflate) and CINFO = log2(window size) - 8
+        const auto cmf = 0x08u | (static_cast<unsigned>(window_bits - 8) << 4);
+        auto       flg = (static_cast<unsigned>(flevel) << 6) | (_has_dictionary ? 0x20u : 0u);
+        // FCHECK makes the header, as a big-endian number, a multiple of 31
+        flg += 31 - (cmf * 256 + flg) % 31;
+        bytes[0] = std::byte(cmf);
+        bytes[1] = std::byte(flg);
+        bytes[2] = std::byte(_dictionary_id >> 24);
+        bytes[3] = std::byte(_dictionary_id >> 16);
+        bytes[4] = std::byte(_dictionary_id >> 8);
+        bytes[5] = std::byte(_dictionary_id);
+    }
+
+public:
+    constexpr zlib_compressor() = default;
+    constexpr explicit zlib_compressor(InnerCompressor&& c)
+        : _compressor(NEO_FWD(c)) {}
+
+    NEO_DECL_UNREF_GETTER(compressor, _compressor);
+
+    /**
+     * Reset the compressor to begin a new zlib stream. The inner compressor is
+     * reset in-place, so any parameters it was given are retained. If a
+     * dictionary was given, it is given to the inner compressor again.
+     */
+    constexpr void reset() noexcept {
+        unref(_compressor).reset();
+        using inner_type = std::remove_cvref_t<decltype(unref(_compressor))>;
+        if constexpr (detail::accepts_dictionary<inner_type>) {
+            if (_has_dictionary) {
+                unref(_compressor).set_dictionary(_dictionary);
+            }
+        }
+        _adler                    = adler32();
+        _num_header_bytes_written = 0;
+        _num_adler_bytes_written  = 0;
+        _coro                     = 0;
+    }
+
+    /**
+     * Compress using a preset dictionary, such as one from train_dictionary().
+     * The Adler-32 of the dictionary is written as the DICTID of the header, so
+     * that any zlib decoder can tell which dictionary it needs.
+     *
+     * The buffer is not copied: It must remain valid for as long as the
+     * compressor is used, as reset() gives it to the inner compressor again.
+     * Must be called before any output is generated.
+     */
+    void set_dictionary(const_buffer dict) {
+        neo_assert(expects,
+                   _coro == 0,
+                   "zlib_compressor::set_dictionary() called after output was generated");
+        unref(_compressor).set_dictionary(dict);
+        _dictionary     = dict;
+        _dictionary_id  = dictionary_id(dict);
+        _has_dictionary = true;
+    }
+
+    constexpr compress_result
+    operator()(mutable_buffer out, const_buffer in, flush f = flush::no_flush) noexcept {
+        neo_assert(expects,
+                   !NEO_CORO_IS_FINISHED(_coro),
+                   "Application reused zlib_compressor without calling .reset()");
+
+        // Create a compression result based on how much progress we have made
+        auto calc_ret = [&, in_size = in.size(), out_size = out.size()] {
+            return compress_result{
+                .bytes_written = out_size - out.size(),
+                .bytes_read    = in_size - in.size(),
+                .done          = NEO_CORO_IS_FINISHED(_coro),
+            };
+        };
+
+        bool compress_done = false;
+        bool made_progress = false;
+
+        NEO_CORO_BEGIN(_coro);
+
+        // Write the header
+        while (_num_header_bytes_written < _header_size()) {
+            if (out.empty()) {
+                NEO_CORO_YIELD(calc_ret());
+            }
+            std::byte header_bytes[6] = {};
+            _make_header(header_bytes);
+            auto header_buf = const_buffer(header_bytes, _header_size());
+            auto n_written  = buffer_copy(out, header_buf + _num_header_bytes_written);
+            _num_header_bytes_written += n_written;
+            out += n_written;
+        }
+
+        // Write the actual body of data
+        while (true) {
+            {
+                // Compress a piece of the input into `out`. The flush only applies once we
+                // reach the final piece.
+                using std::as_const;
+                const auto in_part   = in.first(std::min(in.size(), _adler_chunk_size));
+                const bool last_part = in_part.size() == in.size();
+                auto       compress_res
+                    = unref(_compressor)(as_const(out), in_part, last_part ? f : flush::no_flush);
+                _adler.feed(in.first(compress_res.bytes_read));
+                out += compress_res.bytes_written;
+                in += compress_res.bytes_read;
+                compress_done = compress_res.done;
+                made_progress = compress_res.bytes_read || compress_res.bytes_written;
+            }
+
+            if (!compress_done && !in.empty() && !out.empty() && made_progress) {
+                // There is more input, and room to put it
+                continue;
+            }
+
+            if (!compress_done) {
+                neo_assert(invariant,
+                           out.empty() || in.empty(),
+                           "Compressor did not exhaust the input nor output buffers",
+                           out.size(),
+                           in.size());
+                NEO_CORO_YIELD(calc_ret());
+                continue;
+            }
+
+            neo_assert_always(invariant,
+                              ((f & neo::flush::finish) == neo::flush::finish),
+                              "Compressor finished prematurely?",
+                              int(f));
+            neo_assert_always(invariant,
+                              in.empty(),
+                              "Compressor did not take all of the data",
+                              in.size());
+            break;
+        }
+
+        // The trailer is the Adler-32 of the uncompressed data, in big-endian
+        while (_num_adler_bytes_written < sizeof(_adler.value())) {
+            if (out.empty()) {
+                NEO_CORO_YIELD(calc_ret());
+            }
+            neo_assert(expects, in.empty(), "Compressor is not accepting more data", in.size());
+
+            auto      adler_val      = _adler.value();
+            std::byte adler_bytes[4] = {
+                std::byte(adler_val >> 24),
+                std::byte(adler_val >> 16),
+                std::byte(adler_val >> 8),
+                std::byte(adler_val),
+            };
+            auto adler_buf = neo::const_buffer(adler_bytes);
+            auto n_written = buffer_copy(out, adler_buf + _num_adler_bytes_written);
+            _num_adler_bytes_written += n_written;
+            out += n_written;
+        }
+
+        NEO_CORO_END;
+
+        return calc_ret();
+    }
+};
+
+template <typename C>
+zlib_compressor(C &&) -> zlib_compressor<C>;
+
+/**
+ * Options for a zlib_decompressor
+ */
+struct zlib_decompress_options {
+    /**
+     * Check the Adler-32 stored in the trailer of the stream. This should only
+     * be disabled for trusted data, such as data that the application
+     * generated itself.
+     */
+    bool verify_checksum = true;
+};
+
+template <decompressor_algorithm InnerDecompressor>
+class zlib_decompressor {
+    [[no_unique_address]] wrap_refs_t<InnerDecompressor> _decompress;
+
+    /**
+     * The output is requested from the inner decompressor in pieces of this
+     * size, so that the Adler-32 of each piece is computed while it is still
+     * hot in the cache.
+     */
+    static constexpr std::size_t _adler_chunk_size = 1024 * 64;
+
+    zlib_decompress_options _opts;
+
+    int _coro = 0;
+
+    std::byte _cmf{};
+    std::byte _flg{};
+    std::byte _byte{};
+    // A big-endian number being read from the input, and how many of its bytes have been read
+    std::uint32_t _word        = 0;
+    int           _word_nbytes = 0;
+
+    adler32 _actual_adler;
+
+    const_buffer  _dictionary;
+    std::uint32_t _dictionary_id  = 0;
+    bool          _has_dictionary = false;
+
+    constexpr bool _fdict_set() const noexcept { return int(_flg) & 0x20; }
+
+    /// Check the CMF and FLG bytes that begin the stream
+    constexpr void _check_header() const {
+        if ((unsigned(_cmf) * 256 + unsigned(_flg)) % 31 != 0) {
+            throw std::runtime_error("Invalid zlib header check bits");
+        }
+        if ((unsigned(_cmf) & 0x0f) != 8) {
+            throw std::runtime_error("Unsupported zlib compression method");
+        }
+        if ((unsigned(_cmf) >> 4) > 7) {
+            throw std::runtime_error("Invalid zlib window size");
+        }
+    }
+
+    /// Give the dictionary named by the DICTID in the header to the inner decompressor
+    void _load_dictionary(std::uint32_t id) {
+        if (!_has_dictionary) {
+            throw std::runtime_error("zlib stream requires a preset dictionary");
+        }
+        if (id != _dictionary_id) {
+            throw std::runtime_error(
+                "zlib stream was compressed with a different preset dictionary");
+        }
+        using inner_type = std::remove_cvref_t<decltype(unref(_decompress))>;
+        if constexpr (detail::accepts_dictionary<inner_type>) {
+            unref(_decompress).set_dictionary(_dictionary);
+        } else {
+            throw std::runtime_error("The inner decompressor does not support dictionaries");
+        }
+    }
+
+public:
+    constexpr zlib_decompressor() = default;
+    constexpr explicit zlib_decompressor(const zlib_decompress_options& opts)
+        : _opts(opts) {}
+    constexpr explicit zlib_decompressor(InnerDecompressor&&            c,
+                                         const zlib_decompress_options& opts = {})
+        : _decompress(NEO_FWD(c))
+        , _opts(opts) {}
+
+    NEO_DECL_UNREF_GETTER(decompressor, _decompress);
+
+    const zlib_decompress_options& options() const noexcept { return _opts; }
+
+    /**
+     * Reset the decompressor to begin a new zlib stream. The options, the
+     * dictionary, and the inner decompressor are retained.
+     */
+    constexpr void reset() noexcept {
+        unref(_decompress).reset();
+        _cmf          = std::byte{};
+        _flg          = std::byte{};
+        _byte         = std::byte{};
+        _word         = 0;
+        _word_nbytes  = 0;
+        _actual_adler = adler32();
+        _coro         = 0;
+    }
+
+    /**
+     * Provide the preset dictionary for streams that were compressed with one.
+     * A stream whose DICTID does not match the Adler-32 of the dictionary is
+     * rejected. The buffer is not copied: It must remain valid for as long as
+     * the decompressor is used.
+     */
+    void set_dictionary(const_buffer dict) {
+        _dictionary     = dict;
+        _dictionary_id  = dictionary_id(dict);
+        _has_dictionary = true;
+    }
+
+/**
+ * Read a single byte from the input and store it in `Byte`
+ */
+#define CORO_READ_BYTE(Byte, Buf)                                                                  \
+    NEO_FN_MACRO_BEGIN                                                                             \
+    if (Buf.empty()) {                                                                             \
+        NEO_CORO_YIELD(calc_ret());                                                                \
+    }                                                                                              \
+    neo_assert(invariant, !Buf.empty(), "Expected more bytes of input");                           \
+    Byte = Buf[0];                                                                                 \
+    Buf += 1;                                                                                      \
+    NEO_FN_MACRO_END
+
+/**
+ * Read a four-byte big-endian number from the input into `_word`
+ */
+#define CORO_READ_WORD(Buf)                                                                        \
+    NEO_FN_MACRO_BEGIN                                                                             \
+    for (_word = 0, _word_nbytes = 0; _word_nbytes < 4; ++_word_nbytes) {                          \
+        CORO_READ_BYTE(_byte, Buf);                                                                \
+        _word = (_word << 8) | std::uint32_t(_byte);                                               \
+    }                                                                                              \
+    NEO_FN_MACRO_END
+
+    constexpr decompress_result operator()(mutable_buffer out, const_buffer in) {
+        const auto out_init = out;
+        const auto in_init  = in;
+        auto       calc_ret = [&] {
+            return decompress_result{
+                .bytes_written = out_init.size() - out.size(),
+                .bytes_read    = in_init.size() - in.size(),
+                .done          = NEO_CORO_IS_FINISHED(_coro),
+            };
+        };
+
+        if (NEO_CORO_IS_FINISHED(_coro)) {
+            return calc_ret();
+        }
+
+        NEO_CORO_BEGIN(_coro);
+
+        CORO_READ_BYTE(_cmf, in);
+        CORO_READ_BYTE(_flg, in);
+        _check_header();
+
+        if (_fdict_set()) {
+            CORO_READ_WORD(in);
+            _load_dictionary(_word);
+        }
+
+        // Decompress the actual body of the stream:
+        while (true) {
+            {
+                // Decompress a piece of the output
+                const auto out_part   = out.first(std::min(out.size(), _adler_chunk_size));
+                const auto decomp_res = unref(_decompress)(out_part, std::as_const(in));
+                if (_opts.verify_checksum) {
+                    _actual_adler.feed(out.first(decomp_res.bytes_written));
+                }
+                in += decomp_res.bytes_read;
+                out += decomp_res.bytes_written;
+                if (decomp_res.done) {
+                    break;
+                }
+                if (decomp_res.bytes_written == out_part.size() && !out.empty()) {
+                    // We filled the piece, and there is room for more
+                    continue;
+                }
+            }
+            // We aren't done yet, so yield until we get more data
+            NEO_CORO_YIELD(calc_ret());
+        }
+
+        // Read the trailing Adler-32
+        CORO_READ_WORD(in);
+        if (_opts.verify_checksum && _actual_adler.value() != _word) {
+            throw std::runtime_error("Adler-32 check failed");
+        }
+
+        NEO_CORO_END;
+
+        return calc_ret();
+
+#undef CORO_READ_WORD
+#undef CORO_READ_BYTE
+    }
+};
+
+template <decompressor_algorithm D>
+explicit zlib_decompressor(D &&) -> zlib_decompressor<D>;
+
+template <decompressor_algorithm D>
+zlib_decompressor(D&&, const zlib_decompress_options&) -> zlib_decompressor<D>;
+
+}  // namespace neo
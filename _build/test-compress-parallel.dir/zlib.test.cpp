@@ -0,0 +1,139 @@
+#include <neo/zlib.hpp>
+
+#include <neo/deflate.hpp>
+#include <neo/inflate.hpp>
+
+#include <neo/buffer_algorithm/transform.hpp>
+#include <neo/dynbuf_io.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <zlib.h>
+
+namespace {
+
+std::string make_text() {
+    std::string text;
+    for (auto i = 0; i < 20000; ++i) {
+        text += "Some data to compress " + std::to_string(i) + "\n";
+    }
+    return text;
+}
+
+std::string zlib_compress_str(const std::string& text, const std::string* dict = nullptr) {
+    neo::zlib_compressor<neo::deflate_compressor> comp;
+    if (dict) {
+        comp.set_dictionary(neo::const_buffer(*dict));
+    }
+    neo::dynbuf_io<std::string> out;
+    neo::buffer_transform(comp, out, neo::const_buffer(text));
+    neo::buffer_transform(comp, out, neo::const_buffer(), neo::flush::finish);
+    out.shrink_uncommitted();
+    return std::move(out.storage());
+}
+
+std::string zlib_decompress_str(const std::string&                  data,
+                                const std::string*                  dict = nullptr,
+                                const neo::zlib_decompress_options& opts = {}) {
+    neo::zlib_decompressor<neo::inflate_decompressor> decomp{opts};
+    if (dict) {
+        decomp.set_dictionary(neo::const_buffer(*dict));
+    }
+    neo::dynbuf_io<std::string> out;
+    auto res = neo::buffer_transform(decomp, out, neo::const_buffer(data));
+    out.shrink_uncommitted();
+    CHECK(res.done);
+    return std::move(out.storage());
+}
+
+}  // namespace
+
+TEST_CASE("Compress/decompress some data in the zlib format") {
+    const auto text       = make_text();
+    const auto compressed = zlib_compress_str(text);
+    CHECK(compressed.size() < text.size() / 4);
+    // The header is a multiple of 31, with the deflate method
+    CHECK((std::uint8_t(compressed[0]) * 256 + std::uint8_t(compressed[1])) % 31 == 0);
+    CHECK((compressed[0] & 0x0f) == 8);
+    CHECK(zlib_decompress_str(compressed) == text);
+}
+
+TEST_CASE("Interoperate with zlib itself") {
+    const auto text = make_text();
+
+    // zlib can read what we write
+    const auto  ours = zlib_compress_str(text);
+    std::string plain;
+    plain.resize(text.size());
+    ::uLongf plain_size = plain.size();
+    REQUIRE(::uncompress(reinterpret_cast<::Bytef*>(plain.data()),
+                         &plain_size,
+                         reinterpret_cast<const ::Bytef*>(ours.data()),
+                         ours.size())
+            == Z_OK);
+    CHECK(plain_size == text.size());
+    CHECK(plain == text);
+
+    // And we can read what zlib writes, at any level
+    for (int level : {0, 1, 6, 9}) {
+        std::string theirs;
+        ::uLongf    theirs_size = ::compressBound(text.size());
+        theirs.resize(theirs_size);
+        REQUIRE(::compress2(reinterpret_cast<::Bytef*>(theirs.data()),
+                            &theirs_size,
+                            reinterpret_cast<const ::Bytef*>(text.data()),
+                            text.size(),
+                            level)
+                == Z_OK);
+        theirs.resize(theirs_size);
+        CHECK(zlib_decompress_str(theirs) == text);
+    }
+}
+
+TEST_CASE("Detect corrupt zlib data") {
+    const auto text       = make_text();
+    const auto compressed = zlib_compress_str(text);
+
+    auto bad_header = compressed;
+    bad_header[1] ^= 0x01;
+    CHECK_THROWS_AS(zlib_decompress_str(bad_header), std::runtime_error);
+
+    // Corrupt the stored Adler-32
+    auto bad_checksum = compressed;
+    bad_checksum.back() ^= 0x40;
+    CHECK_THROWS_AS(zlib_decompress_str(bad_checksum), std::runtime_error);
+    // Unless it isn't checked
+    CHECK(zlib_decompress_str(bad_checksum,
+                              nullptr,
+                              neo::zlib_decompress_options{.verify_checksum = false})
+          == text);
+}
+
+TEST_CASE("Carry the dictionary ID in the zlib header") {
+    const std::string dict  = "Some data to compress 1234\nSome data to compress 5678\n";
+    const std::string text  = "Some data to compress 1234\n";
+    const auto        small = zlib_compress_str(text, &dict);
+    // FDICT is set
+    CHECK((small[1] & 0x20) != 0);
+    CHECK(zlib_decompress_str(small, &dict) == text);
+
+    // zlib asks for the dictionary by its Adler-32
+    ::z_stream strm{};
+    REQUIRE(::inflateInit(&strm) == Z_OK);
+    std::string plain;
+    plain.resize(text.size());
+    strm.next_in   = reinterpret_cast<::Bytef*>(const_cast<char*>(small.data()));
+    strm.avail_in  = static_cast<::uInt>(small.size());
+    strm.next_out  = reinterpret_cast<::Bytef*>(plain.data());
+    strm.avail_out = static_cast<::uInt>(plain.size());
+    CHECK(::inflate(&strm, Z_FINISH) == Z_NEED_DICT);
+    CHECK(strm.adler == neo::adler32::calc(neo::const_buffer(dict)));
+    ::inflateSetDictionary(&strm, reinterpret_cast<const ::Bytef*>(dict.data()), dict.size());
+    CHECK(::inflate(&strm, Z_FINISH) == Z_STREAM_END);
+    ::inflateEnd(&strm);
+    CHECK(plain == text);
+
+    CHECK_THROWS_AS(zlib_decompress_str(small), std::runtime_error);
+    const std::string other = "Something else entirely";
+    CHECK_THROWS_AS(zlib_decompress_str(small, &other), std::runtime_error);
+}
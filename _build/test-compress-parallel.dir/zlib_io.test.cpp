@@ -0,0 +1,53 @@
+#include "./zlib_io.hpp"
+
+#include <neo/string_io.hpp>
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("Compress a string with zlib_sink") {
+    std::string text;
+    for (auto i = 0; i < 100; ++i) {
+        text += "I am a line of text that will be compressed in the zlib format.\n";
+    }
+
+    neo::string_dynbuf_io z_data;
+    neo::zlib_sink        z_out{z_data, neo::deflate_options{.level = 9}};
+    neo::buffer_copy(z_out, neo::const_buffer(text));
+    z_out.finish();
+
+    neo::string_dynbuf_io plain;
+    neo::zlib_source      z_in{z_data};
+    neo::buffer_copy(plain, z_in);
+    CHECK(plain.string() == text);
+
+    neo::string_dynbuf_io compressed;
+    neo::zlib_compress(compressed, neo::const_buffer(text));
+    neo::string_dynbuf_io decompressed;
+    neo::zlib_decompress(decompressed, compressed);
+    CHECK(decompressed.string() == text);
+}
+
+TEST_CASE("Flush a zlib_sink mid-stream") {
+    neo::string_dynbuf_io z_data;
+    neo::zlib_sink        z_out{z_data};
+
+    neo::buffer_copy(z_out, neo::const_buffer("Hello, "));
+    z_out.flush();
+
+    // Everything written so far can be decompressed, even though the stream is incomplete
+    neo::zlib_decompressor<neo::inflate_decompressor> decomp;
+    std::string                                       partial;
+    partial.resize(64);
+    auto z_str = std::string(z_data.read_area_view());
+    auto res
+        = neo::buffer_transform(decomp, neo::mutable_buffer(partial), neo::const_buffer(z_str));
+    partial.resize(res.bytes_written);
+    CHECK_FALSE(res.done);
+    CHECK(partial == "Hello, ");
+
+    neo::buffer_copy(z_out, neo::const_buffer("world!"));
+    z_out.finish();
+    neo::string_dynbuf_io plain;
+    neo::zlib_decompress(plain, z_data);
+    CHECK(plain.string() == "Hello, world!");
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <neo/buffer_range.hpp>
+#include <neo/buffers_consumer.hpp>
+#include <neo/bytewise_iterator.hpp>
+#include <neo/const_buffer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace neo {
+
+namespace detail {
+
+/// The largest prime smaller than 65536
+constexpr std::uint32_t adler32_base = 65521;
+
+/**
+ * Update an Adler-32 checksum with the given bytes, using the fastest method
+ * available on the running processor.
+ */
+std::uint32_t adler32_update(std::uint32_t adler, const std::byte* data, std::size_t size) noexcept;
+
+}  // namespace detail
+
+/**
+ * The Adler-32 checksum, as used by the zlib format (RFC 1950).
+ */
+class adler32 {
+    std::uint32_t _value = 1;
+
+    /// Process each contiguous buffer in bulk
+    template <buffer_range Buffers>
+    void _feed_bulk(const Buffers& bufs) noexcept {
+        buffers_consumer in{bufs};
+        while (!in.empty()) {
+            auto part = in.next_contiguous();
+            _value    = detail::adler32_update(_value, part.data(), part.size());
+            in.consume(part.size());
+        }
+    }
+
+public:
+    template <buffer_range Buffers>
+    constexpr void feed(const Buffers& bufs) noexcept {
+        if (std::is_constant_evaluated()) {
+            std::uint32_t a = _value & 0xffff;
+            std::uint32_t b = _value >> 16;
+            for (std::byte byte : bytewise_iterator{bufs}) {
+                a = (a + std::uint32_t(byte)) % detail::adler32_base;
+                b = (b + a) % detail::adler32_base;
+            }
+            _value = (b << 16) | a;
+        } else {
+            _feed_bulk(bufs);
+        }
+    }
+
+    constexpr std::uint32_t value() const noexcept { return _value; }
+
+    template <buffer_range Buffers>
+    static constexpr std::uint32_t calc(const Buffers& bufs) noexcept {
+        adler32 c;
+        c.feed(bufs);
+        return c.value();
+    }
+
+    /**
+     * Given the Adler-32 of two sequences of bytes A and B, compute the
+     * Adler-32 of the concatenation of A and B, without access to the bytes
+     * themselves.
+     *
+     * @param adler_a The Adler-32 of the first sequence
+     * @param adler_b The Adler-32 of the second sequence
+     * @param len_b The length of the second sequence
+     */
+    static constexpr std::uint32_t
+    combine(std::uint32_t adler_a, std::uint32_t adler_b, std::uint64_t len_b) noexcept {
+        constexpr std::uint32_t base = detail::adler32_base;
+        const auto              rem  = static_cast<std::uint32_t>(len_b % base);
+        const auto              a1   = adler_a & 0xffff;
+        const auto              b1   = adler_a >> 16;
+        const auto              a2   = adler_b & 0xffff;
+        const auto              b2   = adler_b >> 16;
+        // The first sum of B starts from one, so the one from A must not be counted twice
+        auto a = (a1 + a2 + base - 1) % base;
+        // Each byte of B adds the first sum of A to the second sum again
+        auto b = (b1 + b2 + (rem * a1) % base + base - rem) % base;
+        return (b << 16) | a;
+    }
+};
+
+}  // namespace neo
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <neo/compress.hpp>
+
+#include "./detail/zlib_base.hpp"
+#include "./stream_stats.hpp"
+
+#include <neo/buffer_algorithm/transform.hpp>
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+
+namespace neo {
+
+/**
+ * The match-finding strategy used by a deflate_compressor. These correspond to
+ * the zlib strategy constants of the same name.
+ */
+enum class deflate_strategy {
+    default_strategy = 0,
+    filtered         = 1,
+    huffman_only     = 2,
+    rle              = 3,
+    fixed            = 4,
+};
+
+/**
+ * Parameters that control the behavior of a deflate_compressor. The defaults
+ * match what deflate_compressor has always used.
+ */
+struct deflate_options {
+    /**
+     * The compression level, from 0 (store only) to 9 (best compression), or
+     * -1 (Z_DEFAULT_COMPRESSION) for zlib's default level
+     */
+    int level = 5;
+    /// The base-2 logarithm of the history window size, from 9 to 15
+    int window_bits = 12;
+    /// How much memory to use for the internal compression state, from 1 to 9
+    int mem_level = 8;
+    /// The match-finding strategy
+    deflate_strategy strategy = deflate_strategy::default_strategy;
+};
+
+/**
+ * A compressor that generates a raw DEFLATE stream using zlib.
+ *
+ * @tparam Stats A stream_stats_policy. With record_stream_stats, stats()
+ * reports the bytes and calls given to the compressor, the time spent inside
+ * of zlib, and the peak memory that zlib held through the allocator.
+ */
+template <stream_stats_policy Stats = no_stream_stats>
+class basic_deflate_compressor : public detail::compression_base {
+    deflate_options _opts;
+    // Parameters requested by set_params() that have not yet been applied
+    std::optional<deflate_options> _pending_params;
+
+    [[no_unique_address]] detail::stream_stats_recorder<Stats::enabled> _stats;
+
+    compress_result _compress(mutable_buffer out, const_buffer in, flush f);
+
+public:
+    explicit basic_deflate_compressor(const deflate_options& opts,
+                                      allocator_type         alloc) noexcept;
+    explicit basic_deflate_compressor(allocator_type alloc) noexcept
+        : basic_deflate_compressor(deflate_options(), alloc) {}
+    explicit basic_deflate_compressor(const deflate_options& opts) noexcept
+        : basic_deflate_compressor(opts, allocator_type()) {}
+    basic_deflate_compressor() noexcept
+        : basic_deflate_compressor(allocator_type()) {}
+    ~basic_deflate_compressor();
+
+    basic_deflate_compressor(basic_deflate_compressor&& o)
+        : compression_base(NEO_FWD(o))
+        , _opts(o._opts)
+        , _pending_params(o._pending_params)
+        , _stats(o._stats) {}
+
+    compress_result operator()(mutable_buffer out, const_buffer in, flush f = flush::no_flush) {
+        if constexpr (Stats::enabled) {
+            auto res
+                = _stats.timed(&stream_stats::total_time, [&] { return _compress(out, in, f); });
+            _stats.record_call(res.bytes_read, res.bytes_written, !res.done);
+            return res;
+        } else {
+            return _compress(out, in, f);
+        }
+    }
+
+    void reset() noexcept;
+
+    /**
+     * Prime the compressor's history window with a preset dictionary: Strings
+     * in `dict` can be referenced from the very beginning of the data, which
+     * helps greatly when compressing small messages that share a lot of
+     * content. The data must be decompressed with the same dictionary.
+     *
+     * Must be called before any data is given after construction or reset().
+     * The dictionary is not retained: reset() discards it.
+     */
+    void set_dictionary(const_buffer dict);
+
+    /**
+     * Change the compression level and strategy without resetting the stream.
+     * The new parameters take effect at the beginning of the next call to
+     * operator(), as data that was given with the prior parameters must first
+     * be flushed to the output.
+     */
+    void set_params(int level, deflate_strategy strategy);
+
+    /// Get the parameters that are (or soon will be) in effect for this compressor
+    const deflate_options& options() const noexcept {
+        return _pending_params ? *_pending_params : _opts;
+    }
+
+    /**
+     * Get the statistics recorded since construction. These accumulate across
+     * calls to reset().
+     */
+    stream_stats stats() const noexcept requires Stats::enabled {
+        auto ret                 = _stats.values();
+        ret.peak_bytes_allocated = peak_bytes_allocated();
+        return ret;
+    }
+};
+
+extern template class basic_deflate_compressor<no_stream_stats>;
+extern template class basic_deflate_compressor<record_stream_stats>;
+
+/**
+ * A basic_deflate_compressor that records no statistics. This is a class of its
+ * own, rather than an alias, so that it can be forward-declared.
+ */
+class deflate_compressor : public basic_deflate_compressor<no_stream_stats> {
+public:
+    using basic_deflate_compressor::basic_deflate_compressor;
+};
+
+namespace detail {
+
+/// The compressor used by the gzip sinks: deflate_compressor if no stats are recorded
+template <stream_stats_policy Stats>
+struct deflate_compressor_for {
+    using type = basic_deflate_compressor<Stats>;
+};
+
+template <>
+struct deflate_compressor_for<no_stream_stats> {
+    using type = deflate_compressor;
+};
+
+template <stream_stats_policy Stats>
+using deflate_compressor_for_t = typename deflate_compressor_for<Stats>::type;
+
+}  // namespace detail
+
+/**
+ * Compressed data is usually much smaller than its input, so a small step
+ * avoids reserving far more output than a short message needs. Use
+ * deflate_bound() to reserve exactly enough for a known input.
+ */
+template <typename Stats>
+constexpr std::size_t buffer_transform_dynamic_growth_hint_v<basic_deflate_compressor<Stats>>
+    = 1024 * 64;
+
+template <>
+constexpr std::size_t buffer_transform_dynamic_growth_hint_v<deflate_compressor>
+    = buffer_transform_dynamic_growth_hint_v<basic_deflate_compressor<>>;
+
+}  // namespace neo
@@ -0,0 +1,52 @@
+#include "./thread_pool.hpp"
+
+using namespace neo::detail;
+
+thread_pool::thread_pool(unsigned n_threads) {
+    if (n_threads == 0) {
+        n_threads = std::thread::hardware_concurrency();
+    }
+    if (n_threads == 0) {
+        n_threads = 1;
+    }
+    _threads.reserve(n_threads);
+    for (auto i = 0u; i < n_threads; ++i) {
+        _threads.emplace_back([this] { _worker_main(); });
+    }
+}
+
+thread_pool::~thread_pool() {
+    {
+        std::unique_lock lk{_mutex};
+        _stop = true;
+    }
+    _cv.notify_all();
+    for (auto& thr : _threads) {
+        thr.join();
+    }
+}
+
+void thread_pool::_push(std::function<void()> fn) {
+    {
+        std::unique_lock lk{_mutex};
+        _queue.push_back(std::move(fn));
+    }
+    _cv.notify_one();
+}
+
+void thread_pool::_worker_main() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock lk{_mutex};
+            _cv.wait(lk, [&] { return _stop || !_queue.empty(); });
+            if (_queue.empty()) {
+                // We've been asked to stop, and there is no more work to do
+                return;
+            }
+            task = std::move(_queue.front());
+            _queue.pop_front();
+        }
+        task();
+    }
+}
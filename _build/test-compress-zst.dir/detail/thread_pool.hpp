@@ -0,0 +1,58 @@
+#pragma once
+
+#include <neo/fwd.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace neo::detail {
+
+/**
+ * A simple fixed-size pool of worker threads that execute submitted tasks in
+ * FIFO order. Used by the parallel compression and archiving facilities.
+ */
+class thread_pool {
+    std::mutex                        _mutex;
+    std::condition_variable           _cv;
+    std::deque<std::function<void()>> _queue;
+    std::vector<std::thread>          _threads;
+    bool                              _stop = false;
+
+    void _push(std::function<void()> fn);
+    void _worker_main();
+
+public:
+    /**
+     * Create a pool with the given number of threads. If zero, uses the number
+     * of hardware threads.
+     */
+    explicit thread_pool(unsigned n_threads);
+    ~thread_pool();
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    std::size_t size() const noexcept { return _threads.size(); }
+
+    /**
+     * Enqueue the given invocable to run on a worker thread. Returns a future
+     * for the result. Exceptions thrown by the task are stored in the future.
+     */
+    template <typename Func>
+    auto submit(Func&& fn) {
+        using result_type = std::invoke_result_t<std::decay_t<Func>&>;
+        auto task = std::make_shared<std::packaged_task<result_type()>>(NEO_FWD(fn));
+        auto fut  = task->get_future();
+        _push([task] { (*task)(); });
+        return fut;
+    }
+};
+
+}  // namespace neo::detail
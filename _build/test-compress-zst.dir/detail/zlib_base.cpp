@@ -0,0 +1,89 @@
+#include "./zlib_base.hpp"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <utility>
+
+using namespace neo;
+using namespace neo::detail;
+
+namespace {
+
+// zlib expects the same alignment as malloc() would give
+constexpr std::size_t zalloc_align = alignof(std::max_align_t);
+// zlib does not give the size of a block when freeing it, so it is stored in a header before the
+// block. The header keeps the block aligned.
+constexpr std::size_t zalloc_header_size = zalloc_align;
+
+static_assert(zalloc_header_size >= sizeof(std::size_t));
+
+}  // namespace
+
+struct compression_base::_zalloc_fns {
+    template <bool Track>
+    static void* allocate(void* self_, unsigned count, unsigned size) noexcept {
+        auto              self    = static_cast<compression_base*>(self_);
+        const std::size_t n_bytes = std::size_t(count) * size;
+        std::byte*        block   = nullptr;
+        try {
+            block = static_cast<std::byte*>(
+                self->_alloc.allocate_bytes(n_bytes + zalloc_header_size, zalloc_align));
+        } catch (const std::bad_alloc&) {
+            // zlib reports Z_MEM_ERROR for a null pointer
+            return nullptr;
+        }
+        std::memcpy(block, &n_bytes, sizeof n_bytes);
+        if constexpr (Track) {
+            self->_bytes_allocated += n_bytes + zalloc_header_size;
+            self->_peak_bytes_allocated
+                = std::max(self->_peak_bytes_allocated, self->_bytes_allocated);
+        }
+        return block + zalloc_header_size;
+    }
+
+    template <bool Track>
+    static void deallocate(void* self_, void* addr) noexcept {
+        auto        self  = static_cast<compression_base*>(self_);
+        auto        block = static_cast<std::byte*>(addr) - zalloc_header_size;
+        std::size_t n_bytes;
+        std::memcpy(&n_bytes, block, sizeof n_bytes);
+        self->_alloc.deallocate_bytes(block, n_bytes + zalloc_header_size, zalloc_align);
+        if constexpr (Track) {
+            self->_bytes_allocated -= n_bytes + zalloc_header_size;
+        }
+    }
+};
+
+compression_base::compression_base(detail::compression_base::allocator_type alloc,
+                                   bool                                     track_allocations)
+    : _alloc(alloc) {
+    _z_stream_ptr = _alloc.allocate_bytes(sizeof(::z_stream), alignof(::z_stream));
+
+    auto z_st = new (_z_stream_ptr)::z_stream{};
+    if (track_allocations) {
+        z_st->zalloc = &_zalloc_fns::allocate<true>;
+        z_st->zfree  = &_zalloc_fns::deallocate<true>;
+    } else {
+        z_st->zalloc = &_zalloc_fns::allocate<false>;
+        z_st->zfree  = &_zalloc_fns::deallocate<false>;
+    }
+    z_st->opaque = this;
+}
+
+compression_base::compression_base(compression_base&& other) noexcept
+    : _alloc(other.get_allocator())
+    , _z_stream_ptr(std::exchange(other._z_stream_ptr, nullptr))
+    , _bytes_allocated(other._bytes_allocated)
+    , _peak_bytes_allocated(other._peak_bytes_allocated) {
+    static_cast<::z_stream*>(_z_stream_ptr)->opaque = this;
+}
+
+compression_base::~compression_base() {
+    if (_z_stream_ptr) {
+        _alloc.deallocate_bytes(_z_stream_ptr, sizeof(::z_stream), alignof(::z_stream));
+    }
+}
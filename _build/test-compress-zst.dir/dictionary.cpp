@@ -0,0 +1,148 @@
+#include "./dictionary.hpp"
+
+#include <neo/adler32.hpp>
+#include <neo/assert.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+using namespace neo;
+
+namespace {
+
+struct match_stats {
+    // The number of samples that contain the string
+    std::uint32_t n_samples = 0;
+    // The index of the last sample that contained the string, plus one
+    std::uint32_t last_sample = 0;
+};
+
+struct segment {
+    std::size_t   offset = 0;
+    std::uint64_t score  = 0;
+};
+
+}  // namespace
+
+std::uint32_t neo::dictionary_id(const_buffer dict) noexcept { return adler32::calc(dict); }
+
+std::vector<std::byte> neo::train_dictionary(const std::vector<const_buffer>&   samples,
+                                             const dictionary_training_options& opts) {
+    neo_assert(expects,
+               opts.match_length >= 3 && opts.match_length <= 8,
+               "Invalid dictionary match length",
+               opts.match_length);
+    neo_assert(expects,
+               opts.segment_size >= opts.match_length,
+               "Dictionary segments must be at least as long as a match",
+               opts.segment_size,
+               opts.match_length);
+
+    std::vector<std::byte> data;
+    for (auto s : samples) {
+        data.insert(data.end(), s.data(), s.data() + s.size());
+    }
+    if (data.size() <= opts.max_size) {
+        return data;
+    }
+
+    // Identify the string of `match_length` bytes that begins at each offset, packed into an
+    // integer. Strings that span two samples are not counted.
+    const auto k = opts.match_length;
+    // A dictionary that is smaller than a segment holds a single, shorter segment
+    const auto segment_size = std::min(opts.segment_size, opts.max_size);
+    if (segment_size < k) {
+        // There is no room for a single match
+        return {};
+    }
+    const auto mask = k == 8 ? ~std::uint64_t(0) : (std::uint64_t(1) << (8 * k)) - 1;
+    std::vector<std::uint64_t>                     keys(data.size());
+    std::vector<bool>                              valid(data.size());
+    std::unordered_map<std::uint64_t, match_stats> stats;
+    {
+        std::size_t offset = 0;
+        for (std::uint32_t sample_n = 0; sample_n < samples.size(); ++sample_n) {
+            const auto    size = samples[sample_n].size();
+            std::uint64_t key  = 0;
+            for (std::size_t i = 0; i < size; ++i) {
+                key = ((key << 8) | std::uint64_t(data[offset + i])) & mask;
+                if (i + 1 < k) {
+                    continue;
+                }
+                const auto start = offset + i + 1 - k;
+                keys[start]      = key;
+                valid[start]     = true;
+                // Count each string once per sample
+                auto& st = stats[key];
+                if (st.last_sample != sample_n + 1) {
+                    st.last_sample = sample_n + 1;
+                    ++st.n_samples;
+                }
+            }
+            offset += size;
+        }
+    }
+
+    // A string is worth as much as the number of samples that contain it
+    auto weight = [&](std::uint64_t key) -> std::uint64_t { return stats[key].n_samples; };
+
+    const auto n_segments  = opts.max_size / segment_size;
+    const auto region_size = data.size() / n_segments;
+    const auto seg_keys    = segment_size - k + 1;
+
+    std::vector<segment>                             chosen;
+    std::unordered_map<std::uint64_t, std::uint32_t> in_window;
+    for (std::size_t region = 0; region < n_segments; ++region) {
+        // Regions are at least one segment long, since the data is larger than the dictionary
+        const auto begin = region * region_size;
+        const auto last  = begin + region_size - segment_size;
+        // Slide a segment-sized window over the region, scoring each position by the weight of
+        // the distinct strings within the window.
+        in_window.clear();
+        std::uint64_t score = 0;
+        auto          add   = [&](std::size_t pos) {
+            if (valid[pos] && in_window[keys[pos]]++ == 0) {
+                score += weight(keys[pos]);
+            }
+        };
+        auto remove = [&](std::size_t pos) {
+            if (valid[pos] && --in_window[keys[pos]] == 0) {
+                score -= weight(keys[pos]);
+            }
+        };
+        for (std::size_t i = 0; i < seg_keys; ++i) {
+            add(begin + i);
+        }
+        segment best{.offset = begin, .score = score};
+        for (auto pos = begin + 1; pos <= last; ++pos) {
+            remove(pos - 1);
+            add(pos + seg_keys - 1);
+            if (score > best.score) {
+                best = {.offset = pos, .score = score};
+            }
+        }
+        if (best.score == 0) {
+            continue;
+        }
+        chosen.push_back(best);
+        // The content of the chosen segment is now covered by the dictionary
+        for (std::size_t i = 0; i < seg_keys; ++i) {
+            if (valid[best.offset + i]) {
+                stats[keys[best.offset + i]].n_samples = 0;
+            }
+        }
+    }
+
+    // The most valuable segments go last, nearest to the data being compressed
+    std::stable_sort(chosen.begin(), chosen.end(), [](const segment& a, const segment& b) {
+        return a.score < b.score;
+    });
+    std::vector<std::byte> dict;
+    dict.reserve(chosen.size() * segment_size);
+    for (auto& seg : chosen) {
+        auto first = data.begin() + static_cast<std::ptrdiff_t>(seg.offset);
+        dict.insert(dict.end(), first, first + static_cast<std::ptrdiff_t>(segment_size));
+    }
+    return dict;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <neo/const_buffer.hpp>
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <type_traits>
+#include <vector>
+
+namespace neo {
+
+/**
+ * Compute the identifier of a preset dictionary. This is the Adler-32 checksum
+ * of the dictionary, the same value that zlib stores as the DICTID of a zlib
+ * stream.
+ */
+std::uint32_t dictionary_id(const_buffer dict) noexcept;
+
+/**
+ * Parameters for train_dictionary()
+ */
+struct dictionary_training_options {
+    /// The size of the generated dictionary. DEFLATE can only refer back 32 KiB.
+    std::size_t max_size = 1024 * 32;
+    /**
+     * The size of each piece of sample data that is selected for the
+     * dictionary. It is reduced to `max_size` if it is larger.
+     */
+    std::size_t segment_size = 64;
+    /**
+     * The length of the strings that are counted to measure how common the
+     * content of a segment is, from 3 (the shortest DEFLATE match) to 8.
+     */
+    std::size_t match_length = 6;
+};
+
+/**
+ * Build a preset dictionary from a set of representative messages, for use
+ * with deflate_compressor::set_dictionary() and the gzip framing.
+ *
+ * The samples are divided into as many regions as there are segments in the
+ * dictionary. From each region, the segment that contains the most strings
+ * that are common to many samples is selected, and the strings that it
+ * contains stop counting towards later selections. Segments are ordered by
+ * score, with the most valuable at the end of the dictionary, where matches
+ * are the cheapest to encode.
+ *
+ * If the samples are no larger than `opts.max_size` in total, the dictionary
+ * is their concatenation. If `opts.max_size` is smaller than `match_length`,
+ * the dictionary is empty.
+ */
+std::vector<std::byte> train_dictionary(const std::vector<const_buffer>&   samples,
+                                        const dictionary_training_options& opts = {});
+
+/**
+ * Build a preset dictionary from a range of buffers, such as a vector of
+ * strings.
+ */
+template <std::ranges::input_range Samples>
+requires std::constructible_from<const_buffer, std::ranges::range_reference_t<Samples>>  //
+    && (!std::same_as<std::remove_cvref_t<Samples>, std::vector<const_buffer>>)
+std::vector<std::byte> train_dictionary(Samples&&                          samples,
+                                        const dictionary_training_options& opts = {}) {
+    std::vector<const_buffer> bufs;
+    for (auto&& s : samples) {
+        bufs.emplace_back(s);
+    }
+    return train_dictionary(bufs, opts);
+}
+
+}  // namespace neo
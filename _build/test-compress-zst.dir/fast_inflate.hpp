@@ -0,0 +1,55 @@
+#pragma once
+
+#include <neo/const_buffer.hpp>
+#include <neo/decompress.hpp>
+
+#include <neo/buffer_algorithm/transform.hpp>
+
+#include <cstddef>
+#include <memory>
+
+namespace neo {
+
+/**
+ * A buffer transformer that decompresses DEFLATE data, implemented natively
+ * rather than with zlib. It is a drop-in replacement for inflate_decompressor
+ * as the inner decompressor of a gzip_decompressor.
+ *
+ * Huffman codes are decoded with multi-level lookup tables that are built
+ * once per block. While there is plenty of input and room for output, a fast
+ * loop keeps a 64-bit bit buffer topped up a word at a time, decodes several
+ * literals per refill, and copies matches eight bytes at a time. Near the
+ * ends of the buffers, a slower path decodes one complete symbol at a time so
+ * that decoding can stop and resume at any buffer boundary.
+ *
+ * The decompressor never reads past the end of the DEFLATE stream: When the
+ * final block ends, `bytes_read` excludes any data that follows it.
+ */
+class fast_inflate_decompressor {
+    struct state;
+    std::unique_ptr<state> _state;
+
+public:
+    fast_inflate_decompressor();
+    ~fast_inflate_decompressor();
+
+    fast_inflate_decompressor(fast_inflate_decompressor&&) noexcept;
+    fast_inflate_decompressor& operator=(fast_inflate_decompressor&&) noexcept;
+
+    decompress_result operator()(mutable_buffer out, const_buffer in);
+
+    void reset() noexcept;
+
+    /**
+     * Provide the history window that precedes the next input, e.g. the
+     * preset dictionary that the data was compressed with. Only the last
+     * 32 KiB of `window` are used.
+     */
+    void set_dictionary(const_buffer window) noexcept;
+};
+
+template <>
+constexpr std::size_t buffer_transform_dynamic_growth_hint_v<fast_inflate_decompressor> = 1024
+    * 1024 * 4;
+
+}  // namespace neo
@@ -0,0 +1,176 @@
+#include <neo/fast_inflate.hpp>
+
+#include <neo/deflate.hpp>
+#include <neo/gzip.hpp>
+#include <neo/inflate.hpp>
+
+#include <neo/buffer_algorithm/transform.hpp>
+#include <neo/dynbuf_io.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <random>
+
+namespace {
+
+std::string make_text() {
+    std::string text;
+    for (auto i = 0; i < 20000; ++i) {
+        text += "Line " + std::to_string(i % 97) + " of a build log that needs compressing\n";
+    }
+    // Incompressible data ends up in stored blocks
+    std::mt19937 rng{42};
+    for (auto i = 0; i < 100000; ++i) {
+        text.push_back(static_cast<char>(rng()));
+    }
+    return text;
+}
+
+std::string deflate_str(const std::string& text, const neo::deflate_options& opts) {
+    neo::deflate_compressor     defl{opts};
+    neo::dynbuf_io<std::string> compressed;
+    neo::buffer_transform(defl, compressed, neo::const_buffer(text));
+    neo::buffer_transform(defl, compressed, neo::const_buffer(), neo::flush::finish);
+    compressed.shrink_uncommitted();
+    return std::move(compressed.storage());
+}
+
+}  // namespace
+
+TEST_CASE("Decompress DEFLATE data natively") {
+    const auto text     = make_text();
+    auto       level    = GENERATE(0, 1, 5, 9);
+    auto       strategy = GENERATE(neo::deflate_strategy::default_strategy,
+                             neo::deflate_strategy::fixed);
+    const auto compressed = deflate_str(text,
+                                        neo::deflate_options{
+                                            .level       = level,
+                                            .window_bits = 15,
+                                            .strategy    = strategy,
+                                        });
+
+    neo::fast_inflate_decompressor infl;
+    neo::dynbuf_io<std::string>    plain;
+    auto res = neo::buffer_transform(infl, plain, neo::const_buffer(compressed));
+    plain.shrink_uncommitted();
+    CHECK(res.done);
+    CHECK(res.bytes_read == compressed.size());
+    CHECK(plain.storage() == text);
+}
+
+TEST_CASE("Decompress DEFLATE data natively in small pieces") {
+    const auto text       = make_text();
+    const auto compressed = deflate_str(text, neo::deflate_options{.window_bits = 15});
+    // Data that follows the DEFLATE stream must not be consumed
+    const auto input = compressed + "trailing";
+
+    auto in_size  = GENERATE(std::size_t(1), std::size_t(7), std::size_t(4096));
+    auto out_size = GENERATE(std::size_t(1), std::size_t(300), std::size_t(100000));
+
+    neo::fast_inflate_decompressor infl;
+    std::string                    plain;
+    std::string                    out_buf(out_size, '\0');
+    std::size_t                    n_read = 0;
+    bool                           done   = false;
+    while (!done) {
+        auto in  = neo::const_buffer(input) + n_read;
+        auto res = infl(neo::mutable_buffer(out_buf), in.first(std::min(in.size(), in_size)));
+        REQUIRE((res.bytes_read || res.bytes_written || res.done));
+        plain.append(out_buf.data(), res.bytes_written);
+        n_read += res.bytes_read;
+        done = res.done;
+    }
+    CHECK(n_read == compressed.size());
+    CHECK(plain == text);
+}
+
+TEST_CASE("Reject corrupt DEFLATE data") {
+    const auto text       = make_text();
+    auto       compressed = deflate_str(text, neo::deflate_options{});
+    // Set the block type to the reserved value
+    compressed[0] = static_cast<char>(compressed[0] | 0b110);
+
+    neo::fast_inflate_decompressor infl;
+    neo::dynbuf_io<std::string>    plain;
+    CHECK_THROWS(neo::buffer_transform(infl, plain, neo::const_buffer(compressed)));
+}
+
+TEST_CASE("Only accept an incomplete Huffman code with a single code of length one") {
+    // A dynamic block that encodes "a" with a one-bit code, and a single distance code of
+    // `dist_len` bits.
+    auto dist_len = GENERATE(1, 2);
+
+    std::string   block;
+    std::uint32_t bit_buf = 0;
+    int           n_bits  = 0;
+    auto          put     = [&](std::uint32_t value, int n) {
+        bit_buf |= value << n_bits;
+        n_bits += n;
+        while (n_bits >= 8) {
+            block.push_back(static_cast<char>(bit_buf & 0xff));
+            bit_buf >>= 8;
+            n_bits -= 8;
+        }
+    };
+    // Huffman codes are packed starting from their most significant bit
+    auto put_code = [&](std::uint32_t code, int len) {
+        while (len--) {
+            put((code >> len) & 1, 1);
+        }
+    };
+    put(1, 1);   // BFINAL
+    put(2, 2);   // Dynamic Huffman codes
+    put(0, 5);   // 257 literal/length codes
+    put(0, 5);   // One distance code
+    put(14, 4);  // 18 code length codes
+    // Code lengths for the code length alphabet: 18 gets a one-bit code, 1 and 2 get two bits
+    for (auto sym : {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1}) {
+        put(sym == 18 ? 1 : sym == 1 || sym == 2 ? 2 : 0, 3);
+    }
+    const auto put_zeros = [&](int n) {
+        put_code(0b0, 1);
+        put(static_cast<std::uint32_t>(n - 11), 7);
+    };
+    put_zeros(97);
+    put_code(0b10, 2);  // 'a'
+    put_zeros(138);
+    put_zeros(20);
+    put_code(0b10, 2);  // End of block
+    put_code(dist_len == 1 ? 0b10 : 0b11, 2);
+    put_code(0b0, 1);  // 'a'
+    put_code(0b1, 1);  // End of block
+    put(0, 7);
+
+    auto decode = [&](auto&& decomp) {
+        std::string out(16, '\0');
+        auto res = decomp(neo::mutable_buffer(out), neo::const_buffer(block));
+        CHECK(res.done);
+        out.resize(res.bytes_written);
+        return out;
+    };
+    if (dist_len == 1) {
+        CHECK(decode(neo::inflate_decompressor{}) == "a");
+        CHECK(decode(neo::fast_inflate_decompressor{}) == "a");
+    } else {
+        // zlib rejects this code, and so do we
+        CHECK_THROWS(decode(neo::inflate_decompressor{}));
+        CHECK_THROWS(decode(neo::fast_inflate_decompressor{}));
+    }
+}
+
+TEST_CASE("Use fast_inflate_decompressor with gzip_decompressor") {
+    const auto text = make_text();
+
+    neo::gzip_compressor<neo::deflate_compressor> comp;
+    neo::dynbuf_io<std::string>                   gzipped;
+    neo::buffer_transform(comp, gzipped, neo::const_buffer(text));
+    neo::buffer_transform(comp, gzipped, neo::const_buffer(), neo::flush::finish);
+    gzipped.shrink_uncommitted();
+
+    neo::gzip_decompressor<neo::fast_inflate_decompressor> decomp;
+    neo::dynbuf_io<std::string>                            plain;
+    auto res = neo::buffer_transform(decomp, plain, neo::const_buffer(gzipped.storage()));
+    plain.shrink_uncommitted();
+    CHECK(res.done);
+    CHECK(plain.storage() == text);
+}
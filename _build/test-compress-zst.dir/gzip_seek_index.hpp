@@ -0,0 +1,149 @@
+#pragma once
+
+#include "./decompress.hpp"
+#include "./gzip.hpp"
+#include "./inflate.hpp"
+
+#include <neo/const_buffer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+namespace neo {
+
+/**
+ * A point in a gzip stream at which decompression can be resumed: The start
+ * of a DEFLATE block, and the 32 KiB of uncompressed data that preceded it.
+ */
+struct gzip_seek_point {
+    /// The offset of the first whole byte of the block in the compressed data
+    std::uint64_t compressed_offset = 0;
+    /// The offset in the uncompressed data at which the block begins
+    std::uint64_t uncompressed_offset = 0;
+    /// The number of bits of the byte before `compressed_offset` that belong to the block
+    int bits = 0;
+    /// The uncompressed data preceding the point, up to 32 KiB
+    std::vector<std::byte> window;
+};
+
+/**
+ * An index of access points into an ordinary (single-member) gzip file, in the
+ * style of zlib's "zran" example. This allows decompression to begin near any
+ * offset in the uncompressed data, at the cost of storing a 32 KiB window for
+ * each access point.
+ *
+ * An index is generated by gzip_seek_index_builder (or by build()), and is used
+ * by gzip_random_access_source.
+ */
+class gzip_seek_index {
+    std::vector<gzip_seek_point> _points;
+    std::uint64_t                _span = default_span;
+
+    friend class gzip_seek_index_builder;
+
+public:
+    /// The default distance between access points, in bytes of uncompressed data
+    static constexpr std::uint64_t default_span = 1024 * 1024;
+
+    gzip_seek_index() = default;
+
+    const std::vector<gzip_seek_point>& points() const noexcept { return _points; }
+
+    /// The requested distance between access points
+    std::uint64_t span() const noexcept { return _span; }
+
+    /**
+     * Find the last access point at or before the given offset in the
+     * uncompressed data. Returns `nullptr` if the offset precedes all access
+     * points, in which case decompression must begin at the start of the file.
+     */
+    const gzip_seek_point* find(std::uint64_t uncompressed_offset) const noexcept;
+
+    /**
+     * Write the index in a compact form. The windows are compressed.
+     */
+    void write(std::ostream& out) const;
+
+    /// Read an index that was written by write()
+    static gzip_seek_index read(std::istream& in);
+
+    /**
+     * Generate an index by decompressing all of the gzip data in the given
+     * stream.
+     */
+    static gzip_seek_index build(std::istream& in, std::uint64_t span = default_span);
+};
+
+/**
+ * A decompressor that decompresses gzip data and simultaneously generates a
+ * gzip_seek_index for it. This can be used as a drop-in replacement for
+ * gzip_decompressor<inflate_decompressor> to generate an index as part of a
+ * decompression that would be done anyway.
+ */
+class gzip_seek_index_builder {
+    gzip_decompressor<inflate_decompressor> _gz;
+    gzip_seek_index                         _index;
+
+    std::uint64_t _total_in   = 0;
+    std::uint64_t _total_out  = 0;
+    std::uint64_t _last_point = 0;
+
+    void _add_point();
+
+public:
+    explicit gzip_seek_index_builder(std::uint64_t span = gzip_seek_index::default_span);
+
+    decompress_result operator()(mutable_buffer out, const_buffer in);
+
+    void reset() noexcept;
+
+    /// The index of the data that has been decompressed so far
+    const gzip_seek_index& index() const noexcept { return _index; }
+};
+
+template <>
+constexpr std::size_t buffer_transform_dynamic_growth_hint_v<gzip_seek_index_builder>
+    = buffer_transform_dynamic_growth_hint_v<inflate_decompressor>;
+
+/**
+ * @brief A buffer_source that decompresses a gzip file from a seekable stream,
+ * using a gzip_seek_index to begin decompression near any offset.
+ *
+ * Only the first member of a multi-member gzip file is available. The gzip
+ * data is expected to begin at the start of the stream. The CRC-32 of the data
+ * is only checked when reading from the beginning to the end of the file.
+ */
+class gzip_random_access_source {
+    std::istream*                           _in;
+    gzip_seek_index                         _index;
+    gzip_decompressor<inflate_decompressor> _gz;
+    inflate_decompressor                    _raw;
+    bool                                    _use_raw = false;
+    bool                                    _done    = false;
+
+    std::vector<std::byte> _in_buf;
+    const_buffer           _in_avail;
+
+    std::vector<std::byte> _out_buf;
+    std::size_t            _out_pos    = 0;
+    std::size_t            _out_end    = 0;
+    std::uint64_t          _out_offset = 0;
+
+    bool _fill();
+
+public:
+    gzip_random_access_source(std::istream& in, gzip_seek_index idx);
+
+    const_buffer next(std::size_t n);
+    void         consume(std::size_t n) noexcept;
+
+    /// Move to the given offset in the uncompressed data
+    void seek(std::uint64_t uncompressed_offset);
+
+    /// The current offset in the uncompressed data
+    std::uint64_t tell() const noexcept { return _out_offset + _out_pos; }
+};
+
+}  // namespace neo
@@ -0,0 +1,106 @@
+#include "./inflate.hpp"
+
+#include <neo/assert.hpp>
+
+#include <zlib.h>
+
+#include <stdexcept>
+
+using namespace std::literals;
+using namespace neo;
+
+#define MY_Z_STATE (*static_cast<::z_stream*>(_z_stream_ptr))
+
+/**
+ * Initialize the state for tinfl.
+ */
+template <stream_stats_policy Stats>
+basic_inflate_decompressor<Stats>::basic_inflate_decompressor(allocator_type alloc) noexcept
+    : compression_base(alloc, Stats::enabled) {
+    ::inflateInit2(&MY_Z_STATE, -15);
+}
+
+template <stream_stats_policy Stats>
+basic_inflate_decompressor<Stats>::~basic_inflate_decompressor() {
+    if (_z_stream_ptr) {
+        ::inflateEnd(&MY_Z_STATE);
+    }
+}
+
+template <stream_stats_policy Stats>
+void basic_inflate_decompressor<Stats>::reset() noexcept {
+    ::inflateReset(&MY_Z_STATE);
+}
+
+template <stream_stats_policy Stats>
+decompress_result basic_inflate_decompressor<Stats>::_decompress(mutable_buffer out,
+                                                                 const_buffer   in) {
+    ::z_stream& strm = MY_Z_STATE;
+    strm.next_in     = const_cast<::Byte*>(reinterpret_cast<const ::Byte*>(in.data()));
+    strm.avail_in    = static_cast<uInt>(in.size());
+    strm.next_out    = reinterpret_cast<::Byte*>(out.data());
+    strm.avail_out   = static_cast<uInt>(out.size());
+
+    const auto mode = _stop_at_blocks ? Z_BLOCK : Z_NO_FLUSH;
+    const auto result
+        = _stats.timed(&stream_stats::codec_time, [&] { return ::inflate(&strm, mode); });
+    if (result != Z_OK && result != Z_BUF_ERROR && result != Z_STREAM_END) {
+        // There was an error from tinfl!
+        if (strm.msg) {
+            throw std::runtime_error("Data inflate failed. Corrupted? Message from zlib: "s
+                                     + strm.msg);
+        } else {
+            throw std::runtime_error("Data inflate failed. Corrupted?");
+        }
+    }
+    return {
+        .bytes_written = out.size() - strm.avail_out,
+        .bytes_read    = in.size() - strm.avail_in,
+        .done          = result == Z_STREAM_END,
+    };
+}
+
+template <stream_stats_policy Stats>
+bool basic_inflate_decompressor<Stats>::at_block_boundary() const noexcept {
+    // Bit 7 is set when inflate() stops at the end of a block, and bit 6 is set in the final block
+    const auto data_type = MY_Z_STATE.data_type;
+    return (data_type & 128) && !(data_type & 64);
+}
+
+template <stream_stats_policy Stats>
+int basic_inflate_decompressor<Stats>::unused_bits() const noexcept {
+    return MY_Z_STATE.data_type & 7;
+}
+
+template <stream_stats_policy Stats>
+std::size_t basic_inflate_decompressor<Stats>::get_window(mutable_buffer out) const {
+    neo_assert(expects,
+               out.size() >= 32 * 1024,
+               "Buffer is too small to receive the inflate window",
+               out.size());
+    ::uInt n  = 0;
+    auto   rc = ::inflateGetDictionary(&MY_Z_STATE, reinterpret_cast<::Bytef*>(out.data()), &n);
+    neo_assert(invariant, rc == Z_OK, "inflateGetDictionary() failed", rc);
+    return n;
+}
+
+template <stream_stats_policy Stats>
+void basic_inflate_decompressor<Stats>::prime(int n_bits, int value) {
+    auto rc = ::inflatePrime(&MY_Z_STATE, n_bits, value);
+    if (rc != Z_OK) {
+        throw std::runtime_error("Failed to prime the inflate bit buffer");
+    }
+}
+
+template <stream_stats_policy Stats>
+void basic_inflate_decompressor<Stats>::set_dictionary(const_buffer window) {
+    auto rc = ::inflateSetDictionary(&MY_Z_STATE,
+                                     reinterpret_cast<const ::Bytef*>(window.data()),
+                                     static_cast<::uInt>(window.size()));
+    if (rc != Z_OK) {
+        throw std::runtime_error("Failed to set the inflate dictionary");
+    }
+}
+
+template class neo::basic_inflate_decompressor<no_stream_stats>;
+template class neo::basic_inflate_decompressor<record_stream_stats>;
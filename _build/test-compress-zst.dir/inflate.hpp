@@ -0,0 +1,146 @@
+#pragma once
+
+#include <neo/decompress.hpp>
+
+#include "./detail/zlib_base.hpp"
+#include "./stream_stats.hpp"
+
+#include <neo/buffer_algorithm/transform.hpp>
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+
+namespace neo {
+
+/**
+ * A buffer transformer that takes decompresses a sequence of bytes that have
+ * been compressed using the DEFLATE algorithm.
+ *
+ * @tparam Stats A stream_stats_policy. With record_stream_stats, stats()
+ * reports the bytes and calls given to the decompressor, the time spent inside
+ * of zlib, and the peak memory that zlib held through the allocator.
+ */
+template <stream_stats_policy Stats = no_stream_stats>
+class basic_inflate_decompressor : public detail::compression_base {
+    bool _stop_at_blocks = false;
+
+    [[no_unique_address]] detail::stream_stats_recorder<Stats::enabled> _stats;
+
+    decompress_result _decompress(mutable_buffer out, const_buffer in);
+
+public:
+    explicit basic_inflate_decompressor(allocator_type alloc) noexcept;
+    basic_inflate_decompressor() noexcept
+        : basic_inflate_decompressor(allocator_type()) {}
+    ~basic_inflate_decompressor();
+
+    basic_inflate_decompressor(basic_inflate_decompressor&& o)
+        : compression_base(NEO_FWD(o))
+        , _stop_at_blocks(o._stop_at_blocks)
+        , _stats(o._stats) {}
+
+    decompress_result operator()(mutable_buffer out, const_buffer in) {
+        if constexpr (Stats::enabled) {
+            auto res
+                = _stats.timed(&stream_stats::total_time, [&] { return _decompress(out, in); });
+            _stats.record_call(res.bytes_read, res.bytes_written, !res.done);
+            return res;
+        } else {
+            return _decompress(out, in);
+        }
+    }
+
+    void reset() noexcept;
+
+    /**
+     * If enabled, each call to operator() will return early when it reaches
+     * the end of a DEFLATE block. Use at_block_boundary() to check whether
+     * this has occurred. This is used to build an index of points at which
+     * decompression can be resumed.
+     */
+    void stop_at_block_boundaries(bool b) noexcept { _stop_at_blocks = b; }
+
+    /**
+     * Whether the most recent call to operator() stopped at the boundary
+     * between two DEFLATE blocks (and not after the final block). Only
+     * meaningful if stop_at_block_boundaries() is enabled.
+     */
+    bool at_block_boundary() const noexcept;
+
+    /**
+     * The number of bits of the most recently consumed input byte that have
+     * not yet been decoded, from zero to seven.
+     */
+    int unused_bits() const noexcept;
+
+    /**
+     * Copy the decompressor's history window (the most recent output, up to
+     * 32 KiB) into `out`. Returns the size of the window. `out` should be at
+     * least 32 KiB.
+     */
+    std::size_t get_window(mutable_buffer out) const;
+
+    /**
+     * Insert the low `n_bits` bits of `value` into the input. Used to begin
+     * decompression at a point that is not on a byte boundary.
+     */
+    void prime(int n_bits, int value);
+
+    /**
+     * Provide the history window that preceded the next input. Used to begin
+     * decompression at a point that is not the beginning of the stream, or to
+     * decompress data that was compressed with a preset dictionary.
+     */
+    void set_dictionary(const_buffer window);
+
+    /**
+     * Get the statistics recorded since construction. These accumulate across
+     * calls to reset().
+     */
+    stream_stats stats() const noexcept requires Stats::enabled {
+        auto ret                 = _stats.values();
+        ret.peak_bytes_allocated = peak_bytes_allocated();
+        return ret;
+    }
+};
+
+extern template class basic_inflate_decompressor<no_stream_stats>;
+extern template class basic_inflate_decompressor<record_stream_stats>;
+
+/**
+ * A basic_inflate_decompressor that records no statistics. This is a class of
+ * its own, rather than an alias, so that it can be forward-declared.
+ */
+class inflate_decompressor : public basic_inflate_decompressor<no_stream_stats> {
+public:
+    using basic_inflate_decompressor::basic_inflate_decompressor;
+};
+
+namespace detail {
+
+/// The decompressor used by the gzip sources: inflate_decompressor if no stats are recorded
+template <stream_stats_policy Stats>
+struct inflate_decompressor_for {
+    using type = basic_inflate_decompressor<Stats>;
+};
+
+template <>
+struct inflate_decompressor_for<no_stream_stats> {
+    using type = inflate_decompressor;
+};
+
+template <stream_stats_policy Stats>
+using inflate_decompressor_for_t = typename inflate_decompressor_for<Stats>::type;
+
+}  // namespace detail
+
+template <typename Stats>
+constexpr std::size_t buffer_transform_dynamic_growth_hint_v<basic_inflate_decompressor<Stats>>
+    = 1024 * 1024 * 4;
+
+template <>
+constexpr std::size_t buffer_transform_dynamic_growth_hint_v<inflate_decompressor>
+    = buffer_transform_dynamic_growth_hint_v<basic_inflate_decompressor<>>;
+
+}  // namespace neo
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "./lz4.hpp"
+
+#include <neo/buffer_sink.hpp>
+#include <neo/buffer_source.hpp>
+#include <neo/transform_io.hpp>
+
+namespace neo {
+
+/**
+ * @brief Adapt a buffer_sink with LZ4 compression.
+ *
+ * @tparam Sink The underlying buffer sink (A file, socket, etc.)
+ */
+template <buffer_sink Sink>
+class lz4_sink : public buffer_transform_sink<Sink, lz4_compressor> {
+public:
+    explicit lz4_sink(Sink&& out)
+        : lz4_sink::buffer_transform_sink{NEO_FWD(out), {}} {}
+
+    lz4_sink(Sink&& out, const lz4_options& opts)
+        : lz4_sink::buffer_transform_sink{NEO_FWD(out), lz4_compressor{opts}} {}
+
+    /**
+     * @brief Flush all data written so far through to the underlying sink, so
+     * that it can be decoded by a reader without waiting for more data.
+     *
+     * @returns The number of bytes written to the underlying sink.
+     */
+    std::size_t flush(neo::flush mode = neo::flush::sync) {
+        return buffer_transform(this->transformer(), this->sink(), const_buffer(), mode)
+            .bytes_written;
+    }
+
+    std::size_t finish() {
+        return buffer_transform(this->transformer(),
+                                this->sink(),
+                                const_buffer(),
+                                neo::flush::finish)
+            .bytes_written;
+    }
+};
+
+template <buffer_sink S>
+explicit lz4_sink(S &&) -> lz4_sink<S>;
+
+template <buffer_sink S>
+lz4_sink(S&&, const lz4_options&) -> lz4_sink<S>;
+
+/**
+ * @brief Adapt a buffer_source with LZ4 decompression.
+ *
+ * @tparam Source The underlying buffer source (A file, socket, etc.)
+ */
+template <buffer_source Source>
+class lz4_source : public buffer_transform_source<Source, lz4_decompressor> {
+public:
+    explicit lz4_source(Source&& in, const lz4_decompress_options& opts = {})
+        : lz4_source::buffer_transform_source{NEO_FWD(in), lz4_decompressor{opts}} {}
+};
+
+template <buffer_source S>
+explicit lz4_source(S &&) -> lz4_source<S>;
+
+template <buffer_source S>
+lz4_source(S&&, const lz4_decompress_options&) -> lz4_source<S>;
+
+/**
+ * @brief Compress the given input and write it as an LZ4 frame to the given output.
+ *
+ * @returns the number of bytes written to the output.
+ */
+template <buffer_output Out, buffer_input In>
+std::size_t lz4_compress(Out&& out, In&& in, const lz4_options& opts = {}) {
+    lz4_sink lz4_out{ensure_buffer_sink(out), opts};
+    auto     n = buffer_copy(lz4_out, in);
+    n += lz4_out.finish();
+    return n;
+}
+
+/**
+ * @brief Decompress the given LZ4-compressed input, and write the decompressed data to the
+ * given output.
+ *
+ * @returns The number of bytes written to the output.
+ */
+template <buffer_output Out, buffer_input In>
+std::size_t lz4_decompress(Out&& out, In&& in, const lz4_decompress_options& opts = {}) {
+    lz4_source lz4_in{ensure_buffer_source(in), opts};
+    auto       n = buffer_copy(out, lz4_in);
+    return n;
+}
+
+}  // namespace neo
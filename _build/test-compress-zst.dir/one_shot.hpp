@@ -0,0 +1,88 @@
+#pragma once
+
+#include "./deflate.hpp"
+#include "./gzip.hpp"
+
+#include <neo/const_buffer.hpp>
+#include <neo/mutable_buffer.hpp>
+
+#include <cstddef>
+#include <iosfwd>
+#include <optional>
+#include <vector>
+
+/**
+ * Non-streaming compression and decompression, for when the entire input is
+ * in memory as a single buffer. These avoid the bookkeeping that the streaming
+ * transformers need to suspend and resume at arbitrary buffer boundaries, and
+ * reuse per-thread codec state between calls.
+ *
+ * The overloads that take a `mutable_buffer` write into the given buffer and
+ * return the number of bytes written. They throw `std::runtime_error` if the
+ * output does not fit. The overloads that return a vector size the output
+ * themselves.
+ */
+
+namespace neo {
+
+/**
+ * The largest size of the raw DEFLATE data that deflate_buffer() will generate
+ * for `in_size` bytes of input with the given options.
+ */
+std::size_t deflate_bound(std::size_t in_size, const deflate_options& opts = {});
+
+/**
+ * The largest size of the gzip data that gzip_compress_buffer() will generate
+ * for `in_size` bytes of input with the given options.
+ */
+std::size_t gzip_compress_bound(std::size_t in_size, const deflate_options& opts = {});
+
+/// Compress `in` as a raw DEFLATE stream
+std::size_t deflate_buffer(mutable_buffer out, const_buffer in, const deflate_options& opts = {});
+std::vector<std::byte> deflate_buffer(const_buffer in, const deflate_options& opts = {});
+
+/**
+ * Decompress the raw DEFLATE stream at the beginning of `in`. Any data that
+ * follows the end of the stream is ignored.
+ */
+std::size_t inflate_buffer(mutable_buffer out, const_buffer in);
+std::vector<std::byte> inflate_buffer(const_buffer in);
+
+/// Compress `in` as a single gzip member
+std::size_t
+gzip_compress_buffer(mutable_buffer out, const_buffer in, const deflate_options& opts = {});
+std::vector<std::byte> gzip_compress_buffer(const_buffer in, const deflate_options& opts = {});
+
+/**
+ * Decompress gzip data. As with gzip_decompressor, only the first member is
+ * decoded unless `opts.multi_member` is set, in which case every member up to
+ * the end of `in` is decoded.
+ *
+ * The vector overload sizes its output from the ISIZE field of the trailer,
+ * so a single-member stream is decompressed without reallocating.
+ */
+std::size_t            gzip_decompress_buffer(mutable_buffer                 out,
+                                              const_buffer                   in,
+                                              const gzip_decompress_options& opts = {});
+std::vector<std::byte> gzip_decompress_buffer(const_buffer                   in,
+                                              const gzip_decompress_options& opts = {});
+
+/**
+ * Estimate the size of the data that will result from decompressing the given
+ * gzip data, from the ISIZE field of its trailer. For a single-member stream
+ * of less than 4 GiB, this is the exact size.
+ *
+ * Returns `nullopt` if the data is too short to be gzip data.
+ */
+std::optional<std::size_t> gzip_output_size_hint(const_buffer gz);
+
+/**
+ * Estimate the size of the data that will result from decompressing the gzip
+ * data from the current position to the end of the given stream. The position
+ * of the stream is restored afterwards.
+ *
+ * Returns `nullopt` if the stream is not seekable.
+ */
+std::optional<std::size_t> gzip_output_size_hint(std::istream& gz);
+
+}  // namespace neo
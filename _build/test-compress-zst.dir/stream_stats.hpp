@@ -0,0 +1,132 @@
+#pragma once
+
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+namespace neo {
+
+/**
+ * Counters that describe the work done by a (de)compressor or by a sink or
+ * source that wraps one. Only objects that use the record_stream_stats policy
+ * fill these in.
+ */
+struct stream_stats {
+    using duration = std::chrono::nanoseconds;
+
+    /// The number of bytes consumed from the input
+    std::uint64_t bytes_in = 0;
+    /// The number of bytes written to the output
+    std::uint64_t bytes_out = 0;
+    /// The number of calls to operator() (for a sink or source: commit() or next())
+    std::uint64_t calls = 0;
+    /// The number of calls that returned before the stream was finished
+    std::uint64_t yields = 0;
+    /// The time spent inside of the instrumented calls, in total
+    duration total_time{};
+    /// The time spent inside of the codec library (e.g. zlib's deflate() and inflate())
+    duration codec_time{};
+    /// The time spent computing checksums
+    duration checksum_time{};
+    /// The time spent moving data between buffers, outside of the codec
+    duration copy_time{};
+    /// The largest number of bytes held at once through the codec's allocator
+    std::size_t peak_bytes_allocated = 0;
+};
+
+/**
+ * The default statistics policy: Nothing is recorded, and the instrumented
+ * types have the same size and code as if they were not instrumented.
+ */
+struct no_stream_stats {
+    static constexpr bool enabled = false;
+};
+
+/**
+ * Record a stream_stats for each instrumented object, available from its
+ * stats() member function. Recording costs two reads of the steady clock per
+ * timed region.
+ */
+struct record_stream_stats {
+    static constexpr bool enabled = true;
+};
+
+template <typename T>
+concept stream_stats_policy = requires {
+    { T::enabled } -> std::convertible_to<bool>;
+};
+
+namespace detail {
+
+template <bool Enabled>
+class stream_stats_recorder;
+
+template <>
+class stream_stats_recorder<false> {
+public:
+    template <typename Func>
+    constexpr decltype(auto) timed(stream_stats::duration stream_stats::*, Func&& fn) {
+        return fn();
+    }
+
+    constexpr void record_call(std::uint64_t, std::uint64_t, bool) noexcept {}
+};
+
+template <>
+class stream_stats_recorder<true> {
+    using clock = std::chrono::steady_clock;
+
+    stream_stats _values;
+
+    struct _scoped_timer {
+        stream_stats::duration& counter;
+        clock::time_point       start = clock::now();
+
+        ~_scoped_timer() {
+            counter += std::chrono::duration_cast<stream_stats::duration>(clock::now() - start);
+        }
+    };
+
+public:
+    /**
+     * Invoke `fn`, and add the time that it takes to the given counter. The
+     * time is counted even if `fn` throws.
+     */
+    template <typename Func>
+    decltype(auto) timed(stream_stats::duration stream_stats::*counter, Func&& fn) {
+        _scoped_timer timer{_values.*counter};
+        return fn();
+    }
+
+    /**
+     * Count a call that read `n_in` bytes and wrote `n_out` bytes. `suspended`
+     * should be true if the call returned before the end of the stream.
+     */
+    void record_call(std::uint64_t n_in, std::uint64_t n_out, bool suspended) noexcept {
+        _values.bytes_in += n_in;
+        _values.bytes_out += n_out;
+        ++_values.calls;
+        _values.yields += suspended ? 1 : 0;
+    }
+
+    const stream_stats& values() const noexcept { return _values; }
+    stream_stats&       values() noexcept { return _values; }
+};
+
+/**
+ * The peak allocator usage of the given algorithm, if it tracks one, otherwise
+ * zero.
+ */
+template <typename Algo>
+constexpr std::size_t peak_bytes_allocated_of(const Algo& algo) noexcept {
+    if constexpr (requires { algo.peak_bytes_allocated(); }) {
+        return algo.peak_bytes_allocated();
+    } else {
+        return 0;
+    }
+}
+
+}  // namespace detail
+
+}  // namespace neo
@@ -0,0 +1,127 @@
+#include <neo/stream_stats.hpp>
+
+#include <neo/deflate.hpp>
+#include <neo/gzip.hpp>
+#include <neo/gzip_io.hpp>
+#include <neo/inflate.hpp>
+
+#include <neo/buffer_algorithm/transform.hpp>
+#include <neo/dynbuf_io.hpp>
+#include <neo/string_io.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+
+namespace {
+
+std::string make_text() {
+    std::string text;
+    for (auto i = 0; i < 20000; ++i) {
+        text += "Line number " + std::to_string(i) + " of the text\n";
+    }
+    return text;
+}
+
+using recording_gzip_compressor
+    = neo::gzip_compressor<neo::basic_deflate_compressor<neo::record_stream_stats>,
+                           neo::record_stream_stats>;
+using recording_gzip_decompressor
+    = neo::gzip_decompressor<neo::basic_inflate_decompressor<neo::record_stream_stats>,
+                             neo::record_stream_stats>;
+
+}  // namespace
+
+static_assert(sizeof(neo::gzip_compressor<neo::deflate_compressor>)
+                  < sizeof(recording_gzip_compressor),
+              "Only recording statistics should require extra storage");
+
+TEST_CASE("Record statistics of gzip compression and decompression") {
+    const auto text = make_text();
+
+    recording_gzip_compressor   compress;
+    neo::dynbuf_io<std::string> gzipped;
+    auto res = neo::buffer_transform(compress, gzipped, neo::const_buffer(text));
+    res += neo::buffer_transform(compress, gzipped, neo::const_buffer(), neo::flush::finish);
+    gzipped.shrink_uncommitted();
+    REQUIRE(res.done);
+
+    auto stats = compress.stats();
+    CHECK(stats.bytes_in == text.size());
+    CHECK(stats.bytes_out == gzipped.storage().size());
+    CHECK(stats.calls > 0);
+    CHECK(stats.yields == stats.calls - 1);
+    CHECK(stats.codec_time <= stats.total_time);
+    CHECK(stats.checksum_time <= stats.total_time);
+    CHECK(stats.peak_bytes_allocated > 0);
+
+    // The inner compressor sees the body of the stream, without the gzip header and trailer
+    auto inner = compress.compressor().stats();
+    CHECK(inner.bytes_in == text.size());
+    CHECK(inner.bytes_out < stats.bytes_out);
+    CHECK(inner.peak_bytes_allocated == stats.peak_bytes_allocated);
+
+    recording_gzip_decompressor decompress;
+    neo::dynbuf_io<std::string> plain;
+    neo::buffer_transform(decompress, plain, neo::const_buffer(gzipped.storage()));
+    plain.shrink_uncommitted();
+    CHECK(plain.storage() == text);
+
+    stats = decompress.stats();
+    CHECK(stats.bytes_in == gzipped.storage().size());
+    CHECK(stats.bytes_out == text.size());
+    CHECK(stats.calls > 0);
+    CHECK(stats.peak_bytes_allocated > 0);
+}
+
+TEST_CASE("Record statistics of a gzip_sink and gzip_source") {
+    const auto text = make_text();
+
+    neo::string_dynbuf_io                                           gz_data;
+    neo::gzip_sink<neo::string_dynbuf_io&, neo::record_stream_stats> gz_out{gz_data};
+    neo::buffer_copy(gz_out, neo::const_buffer(text));
+    gz_out.finish();
+
+    auto stats = gz_out.stats();
+    CHECK(stats.bytes_in == text.size());
+    CHECK(stats.bytes_out == gz_data.read_area_view().size());
+    CHECK(stats.calls >= 2);
+    CHECK(stats.codec_time + stats.checksum_time <= stats.total_time);
+
+    neo::string_dynbuf_io                                             plain;
+    neo::gzip_source<neo::string_dynbuf_io&, neo::record_stream_stats> gz_in{gz_data};
+    neo::buffer_copy(plain, gz_in);
+    CHECK(plain.string() == text);
+
+    stats = gz_in.stats();
+    CHECK(stats.bytes_out == text.size());
+    CHECK(stats.calls > 0);
+    CHECK(stats.peak_bytes_allocated > 0);
+}
+
+TEST_CASE("Statistics survive a reset") {
+    const auto text = make_text();
+
+    neo::basic_deflate_compressor<neo::record_stream_stats> compress;
+
+    auto round_trip = [&] {
+        neo::dynbuf_io<std::string> out;
+        auto res = neo::buffer_transform(compress, out, neo::const_buffer(text));
+        res += neo::buffer_transform(compress, out, neo::const_buffer(), neo::flush::finish);
+        out.shrink_uncommitted();
+        CHECK(res.done);
+
+        neo::dynbuf_io<std::string> plain;
+        neo::buffer_transform(neo::inflate_decompressor{}, plain, neo::const_buffer(out.storage()));
+        plain.shrink_uncommitted();
+        CHECK(plain.storage() == text);
+    };
+    round_trip();
+    const auto first = compress.stats();
+    CHECK(first.bytes_in == text.size());
+
+    compress.reset();
+    round_trip();
+    CHECK(compress.stats().bytes_in == 2 * first.bytes_in);
+    CHECK(compress.stats().calls > first.calls);
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <neo/compress.hpp>
+#include <neo/decompress.hpp>
+
+#include <neo/buffer_algorithm/transform.hpp>
+#include <neo/const_buffer.hpp>
+#include <neo/mutable_buffer.hpp>
+
+#include <cstddef>
+#include <optional>
+
+namespace neo {
+
+/**
+ * Parameters that control the behavior of a zstd_compressor.
+ */
+struct zstd_options {
+    /// The compression level, from 1 (fastest) to 19 (best compression; 22 with a large window)
+    int level = 3;
+    /**
+     * The number of threads to use for compression. If one, compression is
+     * done on the calling thread. If zero, uses the number of hardware threads.
+     * If libzstd was built without multithreading support, this is ignored.
+     */
+    unsigned thread_count = 1;
+    /// Append a checksum of the content to each frame
+    bool checksum = true;
+    /// The base-2 logarithm of the window size. Zero lets zstd choose based on the level.
+    int window_log = 0;
+};
+
+/**
+ * A buffer transformer that compresses data as a Zstandard frame.
+ *
+ * The frame is finished by flush::finish. Every other flush mode makes all
+ * data given so far decodable by a reader of the output.
+ */
+class zstd_compressor {
+    // A ZSTD_CCtx, kept opaque so that users need not see zstd.h
+    void*        _cctx = nullptr;
+    zstd_options _opts;
+    bool         _finished = false;
+
+public:
+    explicit zstd_compressor(const zstd_options& opts);
+    zstd_compressor()
+        : zstd_compressor(zstd_options()) {}
+    ~zstd_compressor();
+
+    zstd_compressor(zstd_compressor&& o) noexcept;
+    zstd_compressor& operator=(zstd_compressor&& o) noexcept;
+
+    compress_result operator()(mutable_buffer out, const_buffer in, flush f = flush::no_flush);
+
+    /// Begin a new frame. The options are retained.
+    void reset() noexcept;
+
+    const zstd_options& options() const noexcept { return _opts; }
+};
+
+/**
+ * Options for a zstd_decompressor
+ */
+struct zstd_decompress_options {
+    /**
+     * Decode a sequence of concatenated frames as a single stream. As with
+     * gzip_decompress_options::multi_member, the decompressor never reports
+     * `done` in this mode. Use at_frame_boundary() to check that the input
+     * did not end part-way through a frame.
+     */
+    bool multi_frame = false;
+    /**
+     * The base-2 logarithm of the largest window that will be accepted, to
+     * bound the memory used for untrusted data. Zero uses the zstd default
+     * (128 MiB windows).
+     */
+    int window_log_max = 0;
+};
+
+/**
+ * A buffer transformer that decompresses Zstandard data.
+ */
+class zstd_decompressor {
+    // A ZSTD_DCtx, kept opaque so that users need not see zstd.h
+    void*                   _dctx = nullptr;
+    zstd_decompress_options _opts;
+    bool                    _frame_done = false;
+
+public:
+    explicit zstd_decompressor(const zstd_decompress_options& opts);
+    zstd_decompressor()
+        : zstd_decompressor(zstd_decompress_options()) {}
+    ~zstd_decompressor();
+
+    zstd_decompressor(zstd_decompressor&& o) noexcept;
+    zstd_decompressor& operator=(zstd_decompressor&& o) noexcept;
+
+    decompress_result operator()(mutable_buffer out, const_buffer in);
+
+    void reset() noexcept;
+
+    /**
+     * Whether the decompressor is between frames, i.e. at least one frame has
+     * been fully decoded and no part of another has been read.
+     */
+    bool at_frame_boundary() const noexcept { return _frame_done; }
+
+    const zstd_decompress_options& options() const noexcept { return _opts; }
+};
+
+/**
+ * Obtain the decompressed size of the Zstandard frame at the beginning of the
+ * given data, if the compressor recorded it in the frame header.
+ *
+ * Returns `nullopt` if the size is unknown or `frame` does not contain a
+ * complete frame header.
+ */
+std::optional<std::size_t> zstd_frame_content_size(const_buffer frame) noexcept;
+
+/**
+ * Estimate the decompressed size of the Zstandard frame at the beginning of
+ * the given data, for presizing an output. This is the content size recorded in
+ * the frame header, limited to the most that the given data could decode to.
+ *
+ * Returns `nullopt` if the size is unknown.
+ */
+std::optional<std::size_t> zstd_output_size_hint(const_buffer frame) noexcept;
+
+template <>
+constexpr std::size_t buffer_transform_dynamic_growth_hint_v<zstd_compressor> = 1024 * 64;
+
+template <>
+constexpr std::size_t buffer_transform_dynamic_growth_hint_v<zstd_decompressor> = 1024 * 1024 * 4;
+
+}  // namespace neo
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "./zstd.hpp"
+
+#include <neo/buffer_sink.hpp>
+#include <neo/buffer_source.hpp>
+#include <neo/transform_io.hpp>
+
+namespace neo {
+
+/**
+ * @brief Adapt a buffer_sink with Zstandard compression.
+ *
+ * @tparam Sink The underlying buffer sink (A file, socket, etc.)
+ */
+template <buffer_sink Sink>
+class zstd_sink : public buffer_transform_sink<Sink, zstd_compressor> {
+public:
+    explicit zstd_sink(Sink&& out)
+        : zstd_sink::buffer_transform_sink{NEO_FWD(out), {}} {}
+
+    zstd_sink(Sink&& out, const zstd_options& opts)
+        : zstd_sink::buffer_transform_sink{NEO_FWD(out), zstd_compressor{opts}} {}
+
+    /**
+     * @brief Flush all data written so far through to the underlying sink, so
+     * that it can be decoded by a reader without waiting for more data.
+     *
+     * @returns The number of bytes written to the underlying sink.
+     */
+    std::size_t flush(neo::flush mode = neo::flush::sync) {
+        return buffer_transform(this->transformer(), this->sink(), const_buffer(), mode)
+            .bytes_written;
+    }
+
+    std::size_t finish() {
+        return buffer_transform(this->transformer(),
+                                this->sink(),
+                                const_buffer(),
+                                neo::flush::finish)
+            .bytes_written;
+    }
+};
+
+template <buffer_sink S>
+explicit zstd_sink(S &&) -> zstd_sink<S>;
+
+template <buffer_sink S>
+zstd_sink(S&&, const zstd_options&) -> zstd_sink<S>;
+
+/**
+ * @brief Adapt a buffer_source with Zstandard decompression.
+ *
+ * @tparam Source The underlying buffer source (A file, socket, etc.)
+ */
+template <buffer_source Source>
+class zstd_source : public buffer_transform_source<Source, zstd_decompressor> {
+public:
+    explicit zstd_source(Source&& in, const zstd_decompress_options& opts = {})
+        : zstd_source::buffer_transform_source{NEO_FWD(in), zstd_decompressor{opts}} {}
+};
+
+template <buffer_source S>
+explicit zstd_source(S &&) -> zstd_source<S>;
+
+template <buffer_source S>
+zstd_source(S&&, const zstd_decompress_options&) -> zstd_source<S>;
+
+/**
+ * @brief Compress the given input and write it as a Zstandard frame to the given output.
+ *
+ * @returns the number of bytes written to the output.
+ */
+template <buffer_output Out, buffer_input In>
+std::size_t zstd_compress(Out&& out, In&& in, const zstd_options& opts = {}) {
+    zstd_sink zst_out{ensure_buffer_sink(out), opts};
+    auto      n = buffer_copy(zst_out, in);
+    n += zst_out.finish();
+    return n;
+}
+
+/**
+ * @brief Decompress the given Zstandard-compressed input, and write the decompressed data to the
+ * given output.
+ *
+ * If the input is a single contiguous buffer whose frame header records the
+ * size of the content, room for all of it is prepared in the output at once.
+ * The recorded size is limited by zstd_output_size_hint(), so a corrupt header
+ * cannot cause a huge allocation.
+ *
+ * @returns The number of bytes written to the output.
+ */
+template <buffer_output Out, buffer_input In>
+std::size_t zstd_decompress(Out&& out, In&& in, const zstd_decompress_options& opts = {}) {
+    auto&& sink = ensure_buffer_sink(out);
+    if constexpr (requires { const_buffer(in); }) {
+        if (auto size = zstd_output_size_hint(const_buffer(in)); size && !opts.multi_frame) {
+            sink.prepare(*size);
+        }
+    }
+    zstd_source zst_in{ensure_buffer_source(in), opts};
+    auto        n = buffer_copy(sink, zst_in);
+    return n;
+}
+
+}  // namespace neo
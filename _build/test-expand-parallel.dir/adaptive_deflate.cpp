@@ -0,0 +1,91 @@
+#include "./adaptive_deflate.hpp"
+
+#include <algorithm>
+
+using namespace neo;
+
+namespace {
+
+deflate_options clamped_initial(const adaptive_level_options& opts) {
+    neo_assert(expects,
+               opts.min_level >= 0 && opts.min_level <= opts.max_level && opts.max_level <= 9,
+               "Invalid level range for adaptive compression",
+               opts.min_level,
+               opts.max_level);
+    neo_assert(expects,
+               opts.target_bytes_per_second > 0,
+               "Adaptive compression requires a positive throughput target",
+               opts.target_bytes_per_second);
+    auto ret = opts.initial;
+    // A level of -1 is zlib's default, which is 6
+    const auto level = ret.level < 0 ? 6 : ret.level;
+    ret.level        = std::clamp(level, opts.min_level, opts.max_level);
+    return ret;
+}
+
+}  // namespace
+
+adaptive_deflate_compressor::adaptive_deflate_compressor(const adaptive_level_options& opts,
+                                                         decision_handler on_decision)
+    : _opts(opts)
+    , _defl(clamped_initial(opts))
+    , _on_decision(std::move(on_decision)) {}
+
+void adaptive_deflate_compressor::reset() noexcept {
+    _defl.reset();
+    // Keep the current level: It is still our best guess for the next stream. Start a fresh sample.
+    _block_in   = 0;
+    _block_out  = 0;
+    _block_time = {};
+}
+
+compress_result
+adaptive_deflate_compressor::operator()(mutable_buffer out, const_buffer in, flush f) {
+    const auto start = std::chrono::steady_clock::now();
+    const auto res   = _defl(out, in, f);
+    _block_time += std::chrono::steady_clock::now() - start;
+    _block_in += res.bytes_read;
+    _block_out += res.bytes_written;
+    if (_block_in >= _opts.block_size) {
+        _end_block();
+    }
+    return res;
+}
+
+void adaptive_deflate_compressor::_end_block() {
+    adaptive_level_decision dec;
+    dec.block_index = _block_index++;
+    dec.bytes_in    = _block_in;
+    dec.bytes_out   = _block_out;
+    dec.elapsed     = _block_time;
+    // Guard against a clock that did not advance
+    const auto seconds   = std::max(std::chrono::duration<double>(_block_time).count(), 1e-9);
+    dec.bytes_per_second = double(_block_in) / seconds;
+    // The output of a block may lag behind its input (zlib buffers internally), so this is an
+    // estimate that becomes more accurate with larger blocks.
+    dec.ratio     = _block_out ? double(_block_in) / double(_block_out) : 0.0;
+    dec.old_level = current_level();
+    dec.new_level = dec.old_level;
+
+    const auto target = _opts.target_bytes_per_second;
+    if (dec.bytes_per_second < target * (1.0 - _opts.tolerance)) {
+        // We're too slow. Spend less effort.
+        dec.new_level = std::max(dec.old_level - 1, _opts.min_level);
+    } else if (dec.bytes_per_second > target * (1.0 + _opts.tolerance)) {
+        // We have time to spare. Spend more effort.
+        dec.new_level = std::min(dec.old_level + 1, _opts.max_level);
+    }
+
+    if (dec.new_level != dec.old_level) {
+        _defl.set_params(dec.new_level, _defl.options().strategy);
+    }
+
+    _block_in   = 0;
+    _block_out  = 0;
+    _block_time = {};
+
+    _last_decision = dec;
+    if (_on_decision) {
+        _on_decision(dec);
+    }
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "./deflate.hpp"
+#include "./gzip.hpp"
+
+#include <neo/buffer_sink.hpp>
+#include <neo/transform_io.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <utility>
+
+namespace neo {
+
+/**
+ * Options that control how an adaptive_deflate_compressor chooses its
+ * compression level.
+ */
+struct adaptive_level_options {
+    /// The desired throughput, in bytes of input per second spent inside the compressor
+    double target_bytes_per_second = 32.0 * 1024 * 1024;
+    /// The amount of input to sample between level adjustments
+    std::size_t block_size = 1024 * 1024;
+    /// The lowest level that will be selected
+    int min_level = 1;
+    /// The highest level that will be selected
+    int max_level = 9;
+    /**
+     * How far (as a fraction of the target) the achieved throughput must be
+     * from the target before the level is changed.
+     */
+    double tolerance = 0.15;
+    /// The initial parameters of the compressor. The level is clamped to [min_level, max_level]
+    deflate_options initial = {};
+
+    /**
+     * Create options that target a CPU-time budget for each MiB of input
+     * rather than a throughput.
+     */
+    static adaptive_level_options with_cpu_budget(std::chrono::nanoseconds per_mib) noexcept {
+        adaptive_level_options ret;
+        const auto             seconds = std::chrono::duration<double>(per_mib).count();
+        ret.target_bytes_per_second    = (1024.0 * 1024.0) / seconds;
+        return ret;
+    }
+};
+
+/**
+ * A record of a level decision made by an adaptive_deflate_compressor at the
+ * end of a sampled block.
+ */
+struct adaptive_level_decision {
+    /// The zero-based index of the block that was sampled
+    std::uint64_t block_index = 0;
+    /// The number of input bytes in the sampled block
+    std::uint64_t bytes_in = 0;
+    /// The number of output bytes produced during the sampled block
+    std::uint64_t bytes_out = 0;
+    /// The time spent inside the compressor for the sampled block
+    std::chrono::nanoseconds elapsed{0};
+    /// The achieved throughput, in bytes of input per second
+    double bytes_per_second = 0;
+    /// The achieved compression ratio (input size divided by output size)
+    double ratio = 0;
+    /// The level that was in effect for the sampled block
+    int old_level = 0;
+    /// The level that will be used for the next block
+    int new_level = 0;
+};
+
+/**
+ * A compressor that wraps a deflate_compressor and adjusts its compression
+ * level as it runs in order to approach a target throughput. Time spent in the
+ * compressor is sampled across calls, and the level is raised or lowered by one
+ * step at each block boundary.
+ *
+ * Use gzip_compressor<adaptive_deflate_compressor> (or adaptive_gzip_sink) to
+ * generate gzip data.
+ */
+class adaptive_deflate_compressor {
+public:
+    using decision_handler = std::function<void(const adaptive_level_decision&)>;
+
+private:
+    adaptive_level_options _opts;
+    deflate_compressor     _defl;
+    decision_handler       _on_decision;
+
+    std::uint64_t            _block_index = 0;
+    std::uint64_t            _block_in    = 0;
+    std::uint64_t            _block_out   = 0;
+    std::chrono::nanoseconds _block_time{0};
+
+    std::optional<adaptive_level_decision> _last_decision;
+
+    void _end_block();
+
+public:
+    explicit adaptive_deflate_compressor(const adaptive_level_options& opts,
+                                         decision_handler              on_decision = {});
+    adaptive_deflate_compressor()
+        : adaptive_deflate_compressor(adaptive_level_options()) {}
+
+    compress_result operator()(mutable_buffer out, const_buffer in, flush f = flush::no_flush);
+
+    void reset() noexcept;
+
+    /// Set a function that is invoked with every level decision
+    void on_decision(decision_handler fn) noexcept { _on_decision = std::move(fn); }
+
+    /// The most recent level decision, if one has been made
+    const std::optional<adaptive_level_decision>& last_decision() const noexcept {
+        return _last_decision;
+    }
+
+    /// The level that will be used for subsequent input
+    int current_level() const noexcept { return _defl.options().level; }
+
+    const adaptive_level_options& options() const noexcept { return _opts; }
+};
+
+template <>
+constexpr std::size_t buffer_transform_dynamic_growth_hint_v<adaptive_deflate_compressor>
+    = buffer_transform_dynamic_growth_hint_v<deflate_compressor>;
+
+/**
+ * @brief Adapt a buffer_sink with gzip-based compression that adjusts its
+ * compression level to meet a throughput target.
+ *
+ * @tparam Sink The underlying buffer sink (A file, socket, etc.)
+ */
+template <buffer_sink Sink>
+class adaptive_gzip_sink
+    : public buffer_transform_sink<Sink, gzip_compressor<adaptive_deflate_compressor>> {
+public:
+    explicit adaptive_gzip_sink(Sink&&                                        out,
+                                const adaptive_level_options&                 opts = {},
+                                adaptive_deflate_compressor::decision_handler on_decision = {})
+        : adaptive_gzip_sink::buffer_transform_sink{
+            NEO_FWD(out),
+            gzip_compressor{adaptive_deflate_compressor{opts, std::move(on_decision)}}} {}
+
+    /// Obtain the adaptive compressor, to inspect its decisions
+    auto& controller() noexcept { return this->transformer().compressor(); }
+
+    std::size_t finish() {
+        return buffer_transform(this->transformer(), this->sink(), const_buffer(), flush::finish)
+            .bytes_written;
+    }
+};
+
+template <buffer_sink S>
+explicit adaptive_gzip_sink(S &&) -> adaptive_gzip_sink<S>;
+
+template <buffer_sink S, typename... Args>
+adaptive_gzip_sink(S&&, Args&&...) -> adaptive_gzip_sink<S>;
+
+}  // namespace neo
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <neo/compress.hpp>
+#include <neo/decompress.hpp>
+
+#include <neo/assert.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace neo {
+
+/**
+ * @brief A thread-safe pool of reusable compressors or decompressors.
+ *
+ * Constructing a zlib-backed compressor allocates and initializes several
+ * hundred KiB of state. A pool keeps instances that have been used and reset,
+ * so that creating a stream per request (e.g. a gzip_sink per HTTP response)
+ * does not pay that cost every time.
+ *
+ * Instances are obtained with acquire(), which returns a lease. When the lease
+ * is destroyed, the instance is reset and returned to the pool. To use a leased
+ * instance in a transformer that owns its inner algorithm, name a reference
+ * type, e.g. `gzip_compressor<deflate_compressor&>{*lease}`.
+ *
+ * Note that reset() does not undo parameter changes such as
+ * deflate_compressor::set_params().
+ *
+ * @tparam Algo A compressor_algorithm or decompressor_algorithm
+ */
+template <typename Algo>
+class compressor_pool {
+    static_assert(compressor_algorithm<Algo> || decompressor_algorithm<Algo>,
+                  "compressor_pool<Algo> requires a compressor or decompressor algorithm");
+
+public:
+    using algorithm_type = Algo;
+    using factory_type   = std::function<Algo()>;
+
+private:
+    factory_type                       _factory;
+    std::size_t                        _max_idle;
+    mutable std::mutex                 _mutex;
+    std::vector<std::unique_ptr<Algo>> _idle;
+
+    void _release(std::unique_ptr<Algo> algo) noexcept {
+        algo->reset();
+        std::lock_guard lk{_mutex};
+        if (_idle.size() < _max_idle) {
+            _idle.push_back(std::move(algo));
+        }
+        // Otherwise the pool is full, and the instance is destroyed after the lock is released
+    }
+
+public:
+    /**
+     * @brief An instance of `Algo` on loan from a compressor_pool.
+     *
+     * The instance is returned to the pool when the lease is destroyed.
+     */
+    class lease {
+        compressor_pool*      _pool = nullptr;
+        std::unique_ptr<Algo> _algo;
+
+        friend class compressor_pool;
+
+        lease(compressor_pool& pool, std::unique_ptr<Algo> algo) noexcept
+            : _pool(&pool)
+            , _algo(std::move(algo)) {}
+
+    public:
+        lease(lease&& o) noexcept
+            : _pool(std::exchange(o._pool, nullptr))
+            , _algo(std::move(o._algo)) {}
+
+        lease& operator=(lease&& o) noexcept {
+            release();
+            _pool = std::exchange(o._pool, nullptr);
+            _algo = std::move(o._algo);
+            return *this;
+        }
+
+        ~lease() { release(); }
+
+        /// Return the instance to the pool early. The lease is empty afterwards.
+        void release() noexcept {
+            if (_algo) {
+                _pool->_release(std::move(_algo));
+            }
+        }
+
+        Algo& get() const noexcept {
+            neo_assert(expects, _algo != nullptr, "Use of an empty compressor_pool lease");
+            return *_algo;
+        }
+        Algo& operator*() const noexcept { return get(); }
+        Algo* operator->() const noexcept { return &get(); }
+
+        explicit operator bool() const noexcept { return _algo != nullptr; }
+    };
+
+    /**
+     * @brief Create a pool.
+     *
+     * @param factory Creates a new instance when the pool has none idle
+     * @param max_idle The number of idle instances to retain. Instances
+     * returned beyond this limit are destroyed. If zero, uses twice the number
+     * of hardware threads.
+     */
+    explicit compressor_pool(factory_type factory, std::size_t max_idle = 0)
+        : _factory(std::move(factory))
+        , _max_idle(max_idle ? max_idle : std::max(2u, std::thread::hardware_concurrency() * 2)) {
+        // Returning an instance never needs to allocate
+        _idle.reserve(_max_idle);
+    }
+
+    compressor_pool()
+        : compressor_pool([] { return Algo(); }) {}
+
+    compressor_pool(const compressor_pool&) = delete;
+    compressor_pool& operator=(const compressor_pool&) = delete;
+
+    /// Obtain a reset instance, creating one if none are idle
+    lease acquire() {
+        {
+            std::lock_guard lk{_mutex};
+            if (!_idle.empty()) {
+                auto algo = std::move(_idle.back());
+                _idle.pop_back();
+                return lease{*this, std::move(algo)};
+            }
+        }
+        return lease{*this, std::make_unique<Algo>(_factory())};
+    }
+
+    /// Create instances until `n` are idle in the pool (or the idle limit is reached)
+    void reserve(std::size_t n) {
+        n = std::min(n, _max_idle);
+        while (idle_count() < n) {
+            auto algo = std::make_unique<Algo>(_factory());
+            std::lock_guard lk{_mutex};
+            _idle.push_back(std::move(algo));
+        }
+    }
+
+    /// The number of instances that are waiting in the pool
+    std::size_t idle_count() const noexcept {
+        std::lock_guard lk{_mutex};
+        return _idle.size();
+    }
+
+    std::size_t max_idle() const noexcept { return _max_idle; }
+};
+
+}  // namespace neo
@@ -0,0 +1,105 @@
+#include <neo/compressor_pool.hpp>
+
+#include <neo/deflate.hpp>
+#include <neo/gzip.hpp>
+#include <neo/gzip_io.hpp>
+#include <neo/inflate.hpp>
+
+#include <neo/dynbuf_io.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const std::string text = [] {
+    std::string ret;
+    for (auto i = 0; i < 5000; ++i) {
+        ret += "Response body number " + std::to_string(i % 13) + "\n";
+    }
+    return ret;
+}();
+
+std::string gzip_with(neo::deflate_compressor& defl) {
+    neo::gzip_compressor<neo::deflate_compressor&> comp{defl};
+    neo::dynbuf_io<std::string>                    gzipped;
+    neo::buffer_transform(comp, gzipped, neo::const_buffer(text));
+    neo::buffer_transform(comp, gzipped, neo::const_buffer(), neo::flush::finish);
+    gzipped.shrink_uncommitted();
+    return std::move(gzipped.storage());
+}
+
+std::string gunzip(const std::string& gz) {
+    neo::dynbuf_io<std::string> plain;
+    neo::gzip_decompress(plain, neo::const_buffer(gz));
+    plain.shrink_uncommitted();
+    return std::move(plain.storage());
+}
+
+}  // namespace
+
+TEST_CASE("Reuse compressors from a pool") {
+    neo::compressor_pool<neo::deflate_compressor> pool{
+        [] { return neo::deflate_compressor{neo::deflate_options{.level = 9}}; }};
+    CHECK(pool.idle_count() == 0);
+
+    neo::deflate_compressor* first_ptr = nullptr;
+    {
+        auto defl = pool.acquire();
+        first_ptr = &defl.get();
+        CHECK(gunzip(gzip_with(*defl)) == text);
+    }
+    CHECK(pool.idle_count() == 1);
+
+    // The same instance is handed out again, and has been reset
+    auto defl = pool.acquire();
+    CHECK(&defl.get() == first_ptr);
+    CHECK(pool.idle_count() == 0);
+    CHECK(gunzip(gzip_with(*defl)) == text);
+}
+
+TEST_CASE("Share a compressor pool between threads") {
+    neo::compressor_pool<neo::deflate_compressor> pool{[] { return neo::deflate_compressor{}; },
+                                                       2};
+    std::vector<std::thread> threads;
+    std::atomic<int>         n_ok = 0;
+    for (auto i = 0; i < 4; ++i) {
+        threads.emplace_back([&] {
+            for (auto j = 0; j < 5; ++j) {
+                auto defl = pool.acquire();
+                if (gunzip(gzip_with(*defl)) == text) {
+                    ++n_ok;
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    CHECK(n_ok == 20);
+    // Instances beyond the limit were destroyed
+    CHECK(pool.idle_count() <= 2);
+}
+
+TEST_CASE("Compress and decompress using pool memory resources") {
+    std::pmr::unsynchronized_pool_resource pool_mem;
+    std::pmr::monotonic_buffer_resource    mono_mem;
+    for (std::pmr::memory_resource* mem : {static_cast<std::pmr::memory_resource*>(&pool_mem),
+                                           static_cast<std::pmr::memory_resource*>(&mono_mem)}) {
+        for (auto i = 0; i < 3; ++i) {
+            neo::deflate_compressor defl{neo::deflate_options{}, mem};
+            auto                    gz = gzip_with(defl);
+
+            neo::gzip_decompressor<neo::inflate_decompressor> decomp{
+                neo::inflate_decompressor{mem}};
+            neo::dynbuf_io<std::string> plain;
+            neo::buffer_transform(decomp, plain, neo::const_buffer(gz));
+            plain.shrink_uncommitted();
+            CHECK(plain.storage() == text);
+        }
+    }
+}
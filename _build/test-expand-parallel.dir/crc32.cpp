@@ -0,0 +1,273 @@
+#include "./crc32.hpp"
+
+#include <algorithm>
+#include <array>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define NEO_CRC32_HAVE_PCLMUL 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define NEO_CRC32_TARGET_PCLMUL
+#else
+#include <cpuid.h>
+#define NEO_CRC32_TARGET_PCLMUL __attribute__((target("pclmul,sse4.1")))
+#endif
+#else
+#define NEO_CRC32_HAVE_PCLMUL 0
+#endif
+
+using namespace neo;
+
+namespace {
+
+constexpr std::uint32_t crc32_poly_reflected = 0xedb88320;
+
+using slice_tables = std::array<std::array<std::uint32_t, 256>, 16>;
+
+/**
+ * Generate the tables for slicing-by-16. Table zero is the ordinary bytewise
+ * table. Table N gives the CRC contribution of a byte followed by N zero bytes.
+ */
+constexpr slice_tables make_slice_tables() noexcept {
+    slice_tables tabs = {};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t c = i;
+        for (int k = 0; k < 8; ++k) {
+            c = (c & 1) ? (c >> 1) ^ crc32_poly_reflected : (c >> 1);
+        }
+        tabs[0][i] = c;
+    }
+    for (std::size_t t = 1; t < tabs.size(); ++t) {
+        for (std::size_t i = 0; i < 256; ++i) {
+            const auto prev = tabs[t - 1][i];
+            tabs[t][i]      = (prev >> 8) ^ tabs[0][prev & 0xff];
+        }
+    }
+    return tabs;
+}
+
+constexpr slice_tables crc_tables = make_slice_tables();
+
+inline std::uint32_t load_le32(const std::byte* p) noexcept {
+    return std::uint32_t(p[0]) | (std::uint32_t(p[1]) << 8) | (std::uint32_t(p[2]) << 16)
+        | (std::uint32_t(p[3]) << 24);
+}
+
+inline std::uint32_t
+crc32_bytewise(std::uint32_t crc, const std::byte* data, std::size_t size) noexcept {
+    for (auto stop = data + size; data != stop; ++data) {
+        crc = (crc >> 8) ^ crc_tables[0][(crc ^ std::uint32_t(*data)) & 0xff];
+    }
+    return crc;
+}
+
+/**
+ * Portable CRC-32 that consumes sixteen bytes per step using sixteen lookup
+ * tables.
+ */
+std::uint32_t crc32_slice16(std::uint32_t crc, const std::byte* data, std::size_t size) noexcept {
+    const auto& T = crc_tables;
+    while (size >= 16) {
+        const auto a = load_le32(data) ^ crc;
+        const auto b = load_le32(data + 4);
+        const auto c = load_le32(data + 8);
+        const auto d = load_le32(data + 12);
+        // clang-format off
+        crc = T[15][a & 0xff] ^ T[14][(a >> 8) & 0xff] ^ T[13][(a >> 16) & 0xff] ^ T[12][a >> 24]
+            ^ T[11][b & 0xff] ^ T[10][(b >> 8) & 0xff] ^ T[9][(b >> 16) & 0xff]  ^ T[8][b >> 24]
+            ^ T[7][c & 0xff]  ^ T[6][(c >> 8) & 0xff]  ^ T[5][(c >> 16) & 0xff]  ^ T[4][c >> 24]
+            ^ T[3][d & 0xff]  ^ T[2][(d >> 8) & 0xff]  ^ T[1][(d >> 16) & 0xff]  ^ T[0][d >> 24];
+        // clang-format on
+        data += 16;
+        size -= 16;
+    }
+    return crc32_bytewise(crc, data, size);
+}
+
+#if NEO_CRC32_HAVE_PCLMUL
+
+bool cpu_has_pclmul() noexcept {
+    unsigned int ecx = 0;
+#if defined(_MSC_VER) && !defined(__clang__)
+    int regs[4] = {};
+    ::__cpuid(regs, 1);
+    ecx = static_cast<unsigned int>(regs[2]);
+#else
+    unsigned int eax = 0, ebx = 0, edx = 0;
+    if (!::__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+#endif
+    const bool has_pclmul = ecx & (1u << 1);
+    const bool has_sse41  = ecx & (1u << 19);
+    return has_pclmul && has_sse41;
+}
+
+/**
+ * CRC-32 by folding 64 bytes at a time with carry-less multiplication, then
+ * reducing with Barrett reduction. From Intel's "Fast CRC Computation for
+ * Generic Polynomials Using PCLMULQDQ Instruction". Requires `size >= 64` and
+ * `size % 16 == 0`.
+ */
+NEO_CRC32_TARGET_PCLMUL std::uint32_t
+crc32_pclmul_kernel(std::uint32_t crc, const std::byte* data, std::size_t size) noexcept {
+    // The bit-reflected folding constants for the CRC-32 polynomial
+    alignas(16) static const std::uint64_t k1k2[] = {0x0154442bd4, 0x01c6e41596};
+    alignas(16) static const std::uint64_t k3k4[] = {0x01751997d0, 0x00ccaa009e};
+    alignas(16) static const std::uint64_t k5k0[] = {0x0163cd6124, 0x0000000000};
+    alignas(16) static const std::uint64_t poly[] = {0x01db710641, 0x01f7011641};
+
+    auto load = [](const std::byte* p) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    };
+
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, y5, y6, y7, y8;
+
+    x1 = load(data + 0x00);
+    x2 = load(data + 0x10);
+    x3 = load(data + 0x20);
+    x4 = load(data + 0x30);
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k1k2));
+    data += 64;
+    size -= 64;
+
+    // Fold four lanes in parallel, 64 bytes at a time
+    while (size >= 64) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+
+        y5 = load(data + 0x00);
+        y6 = load(data + 0x10);
+        y7 = load(data + 0x20);
+        y8 = load(data + 0x30);
+
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+
+        data += 64;
+        size -= 64;
+    }
+
+    // Fold the four lanes into one
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k3k4));
+    for (auto next : {x2, x3, x4}) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, next), x5);
+    }
+
+    // Fold the remaining 16-byte blocks
+    while (size >= 16) {
+        x2 = load(data);
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+        data += 16;
+        size -= 16;
+    }
+
+    // Fold 128 bits down to 64 bits
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1 = _mm_srli_si128(x1, 8);
+    x1 = _mm_xor_si128(x1, x2);
+
+    x0 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, x3);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction down to 32 bits
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(poly));
+    x2 = _mm_and_si128(x1, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return static_cast<std::uint32_t>(_mm_extract_epi32(x1, 1));
+}
+
+std::uint32_t crc32_pclmul(std::uint32_t crc, const std::byte* data, std::size_t size) noexcept {
+    if (size < 64) {
+        // Not worth the setup cost
+        return crc32_slice16(crc, data, size);
+    }
+    const auto n_folded = size & ~std::size_t(15);
+    crc                 = crc32_pclmul_kernel(crc, data, n_folded);
+    return crc32_bytewise(crc, data + n_folded, size - n_folded);
+}
+
+#endif
+
+using crc32_impl_fn = std::uint32_t (*)(std::uint32_t, const std::byte*, std::size_t) noexcept;
+
+crc32_impl_fn select_crc32_impl() noexcept {
+#if NEO_CRC32_HAVE_PCLMUL
+    if (cpu_has_pclmul()) {
+        return &crc32_pclmul;
+    }
+#endif
+    return &crc32_slice16;
+}
+
+}  // namespace
+
+std::uint32_t
+neo::detail::crc32_update(std::uint32_t crc, const std::byte* data, std::size_t size) noexcept {
+    static const crc32_impl_fn impl = select_crc32_impl();
+    return impl(crc, data, size);
+}
+
+std::uint32_t crc32::calc_parallel(const_buffer buf, unsigned thread_count) {
+    if (thread_count == 0) {
+        thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    // Don't bother spawning threads for slices smaller than this
+    constexpr std::size_t min_slice_size = 1024 * 1024;
+    const auto            max_slices = std::max<std::size_t>(buf.size() / min_slice_size, 1);
+    const auto            n_slices   = std::min<std::size_t>(thread_count, max_slices);
+    if (n_slices == 1) {
+        return calc(buf);
+    }
+
+    const auto                 slice_size = buf.size() / n_slices;
+    std::vector<std::uint32_t> crcs(n_slices);
+    // If starting a thread throws, the threads that were started are joined as we unwind
+    std::vector<std::jthread> threads;
+    threads.reserve(n_slices - 1);
+    // Slices [0, n-1) are done on other threads
+    for (auto i = 0u; i < n_slices - 1; ++i) {
+        threads.emplace_back([&, i] {
+            crcs[i] = calc(const_buffer(buf.data() + i * slice_size, slice_size));
+        });
+    }
+    // The final slice takes the remainder, and we do it on this thread
+    const auto last_offset = (n_slices - 1) * slice_size;
+    const auto last_size   = buf.size() - last_offset;
+    crcs.back()            = calc(const_buffer(buf.data() + last_offset, last_size));
+    for (auto& thr : threads) {
+        thr.join();
+    }
+
+    auto crc = crcs[0];
+    for (auto i = 1u; i < n_slices; ++i) {
+        const auto len = (i == n_slices - 1) ? last_size : slice_size;
+        crc            = combine(crc, crcs[i], len);
+    }
+    return crc;
+}
@@ -0,0 +1 @@
+#include "./decompress.hpp"
@@ -0,0 +1,309 @@
+#include "./gzip_seek_index.hpp"
+
+#include "./deflate.hpp"
+
+#include <neo/assert.hpp>
+
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+
+using namespace neo;
+
+namespace {
+
+constexpr char        index_magic[8]   = {'n', 'e', 'o', 'g', 'z', 'i', 'x', '1'};
+constexpr std::size_t max_window_size  = 32 * 1024;
+constexpr std::size_t input_chunk_size = 1024 * 64;
+
+// A window compresses to no more than this, in the manner of compressBound()
+constexpr std::size_t max_compressed_window_size = max_window_size + max_window_size / 1000 + 64;
+
+void write_le(std::ostream& out, std::uint64_t v, int n_bytes) {
+    char bytes[8];
+    for (auto i = 0; i < n_bytes; ++i) {
+        bytes[i] = static_cast<char>(v & 0xff);
+        v >>= 8;
+    }
+    out.write(bytes, n_bytes);
+}
+
+std::uint64_t read_le(std::istream& in, int n_bytes) {
+    unsigned char bytes[8];
+    in.read(reinterpret_cast<char*>(bytes), n_bytes);
+    if (in.gcount() != n_bytes) {
+        throw std::runtime_error("Unexpected end of gzip seek index");
+    }
+    std::uint64_t v = 0;
+    for (auto i = n_bytes; i > 0; --i) {
+        v = (v << 8) | bytes[i - 1];
+    }
+    return v;
+}
+
+std::vector<std::byte> compress_window(deflate_compressor& comp, const std::vector<std::byte>& w) {
+    comp.reset();
+    std::vector<std::byte> ret(w.size() + 256);
+    auto                   in  = const_buffer(w.data(), w.size());
+    std::size_t            pos = 0;
+    while (true) {
+        auto res = comp(mutable_buffer(ret.data() + pos, ret.size() - pos), in, flush::finish);
+        in += res.bytes_read;
+        pos += res.bytes_written;
+        if (res.done) {
+            break;
+        }
+        ret.resize(ret.size() * 2);
+    }
+    ret.resize(pos);
+    return ret;
+}
+
+std::vector<std::byte> expand_window(inflate_decompressor&         decomp,
+                                     const std::vector<std::byte>& compressed,
+                                     std::size_t                   size) {
+    decomp.reset();
+    std::vector<std::byte> ret(size);
+    auto res = decomp(mutable_buffer(ret.data(), ret.size()),
+                      const_buffer(compressed.data(), compressed.size()));
+    if (!res.done || res.bytes_written != size) {
+        throw std::runtime_error("Corrupted window in gzip seek index");
+    }
+    return ret;
+}
+
+}  // namespace
+
+const gzip_seek_point* gzip_seek_index::find(std::uint64_t uncompressed_offset) const noexcept {
+    auto it = std::upper_bound(_points.cbegin(),
+                               _points.cend(),
+                               uncompressed_offset,
+                               [](std::uint64_t off, const gzip_seek_point& pt) {
+                                   return off < pt.uncompressed_offset;
+                               });
+    if (it == _points.cbegin()) {
+        return nullptr;
+    }
+    return &*std::prev(it);
+}
+
+void gzip_seek_index::write(std::ostream& out) const {
+    out.write(index_magic, sizeof index_magic);
+    write_le(out, _span, 8);
+    write_le(out, _points.size(), 8);
+    deflate_compressor comp{deflate_options{.level = 9, .window_bits = 15}};
+    for (auto& pt : _points) {
+        auto compressed = compress_window(comp, pt.window);
+        write_le(out, pt.compressed_offset, 8);
+        write_le(out, pt.uncompressed_offset, 8);
+        write_le(out, static_cast<std::uint64_t>(pt.bits), 1);
+        write_le(out, pt.window.size(), 4);
+        write_le(out, compressed.size(), 4);
+        out.write(reinterpret_cast<const char*>(compressed.data()),
+                  static_cast<std::streamsize>(compressed.size()));
+    }
+}
+
+gzip_seek_index gzip_seek_index::read(std::istream& in) {
+    char magic[sizeof index_magic] = {};
+    in.read(magic, sizeof magic);
+    if (!std::equal(std::begin(magic), std::end(magic), std::begin(index_magic))) {
+        throw std::runtime_error("Data is not a gzip seek index");
+    }
+    gzip_seek_index ret;
+    ret._span        = read_le(in, 8);
+    const auto count = read_le(in, 8);
+
+    inflate_decompressor   decomp;
+    std::vector<std::byte> compressed;
+    for (auto i = 0ull; i < count; ++i) {
+        gzip_seek_point pt;
+        pt.compressed_offset     = read_le(in, 8);
+        pt.uncompressed_offset   = read_le(in, 8);
+        pt.bits                  = static_cast<int>(read_le(in, 1));
+        const auto window_size   = read_le(in, 4);
+        const auto compress_size = read_le(in, 4);
+        if (pt.bits > 7 || window_size > max_window_size
+            || compress_size > max_compressed_window_size) {
+            throw std::runtime_error("Invalid access point in gzip seek index");
+        }
+        compressed.resize(compress_size);
+        in.read(reinterpret_cast<char*>(compressed.data()),
+                static_cast<std::streamsize>(compressed.size()));
+        if (static_cast<std::size_t>(in.gcount()) != compressed.size()) {
+            throw std::runtime_error("Unexpected end of gzip seek index");
+        }
+        pt.window = expand_window(decomp, compressed, window_size);
+        ret._points.push_back(std::move(pt));
+    }
+    return ret;
+}
+
+gzip_seek_index gzip_seek_index::build(std::istream& in, std::uint64_t span) {
+    gzip_seek_index_builder builder{span};
+    std::vector<std::byte>  in_buf(input_chunk_size);
+    std::vector<std::byte>  out_buf(input_chunk_size * 4);
+    while (true) {
+        in.read(reinterpret_cast<char*>(in_buf.data()),
+                static_cast<std::streamsize>(in_buf.size()));
+        auto chunk = const_buffer(in_buf.data(), static_cast<std::size_t>(in.gcount()));
+        if (chunk.empty()) {
+            throw std::runtime_error("Unexpected end of gzip data while building a seek index");
+        }
+        while (!chunk.empty()) {
+            auto res = builder(mutable_buffer(out_buf.data(), out_buf.size()), chunk);
+            chunk += res.bytes_read;
+            if (res.done) {
+                return builder.index();
+            }
+        }
+    }
+}
+
+gzip_seek_index_builder::gzip_seek_index_builder(std::uint64_t span) {
+    neo_assert(expects, span > 0, "gzip seek index span must be non-zero");
+    _index._span = span;
+    _gz.decompressor().stop_at_block_boundaries(true);
+}
+
+void gzip_seek_index_builder::reset() noexcept {
+    _gz.reset();
+    _index._points.clear();
+    _total_in   = 0;
+    _total_out  = 0;
+    _last_point = 0;
+}
+
+decompress_result gzip_seek_index_builder::operator()(mutable_buffer out, const_buffer in) {
+    decompress_result acc;
+    while (true) {
+        auto res = _gz(out, in);
+        out += res.bytes_written;
+        in += res.bytes_read;
+        _total_in += res.bytes_read;
+        _total_out += res.bytes_written;
+        acc += res;
+        if (res.done) {
+            break;
+        }
+        // The inner decompressor stops at each block boundary, and the gzip decompressor returns
+        // to us immediately when that happens. Record the boundary before deciding whether to
+        // return, as it may coincide with the end of the output.
+        const bool at_boundary = _gz.decompressor().at_block_boundary();
+        if (at_boundary && _total_out - _last_point >= _index._span) {
+            _add_point();
+        }
+        if (in.empty() || out.empty()) {
+            break;
+        }
+        if (!at_boundary && res.bytes_read == 0 && res.bytes_written == 0) {
+            break;
+        }
+    }
+    return acc;
+}
+
+void gzip_seek_index_builder::_add_point() {
+    auto& infl = _gz.decompressor();
+
+    gzip_seek_point pt;
+    pt.compressed_offset   = _total_in;
+    pt.uncompressed_offset = _total_out;
+    pt.bits                = infl.unused_bits();
+    pt.window.resize(max_window_size);
+    pt.window.resize(infl.get_window(mutable_buffer(pt.window.data(), pt.window.size())));
+    _index._points.push_back(std::move(pt));
+    _last_point = _total_out;
+}
+
+gzip_random_access_source::gzip_random_access_source(std::istream& in, gzip_seek_index idx)
+    : _in(&in)
+    , _index(std::move(idx))
+    , _in_buf(input_chunk_size)
+    , _out_buf(input_chunk_size) {
+    seek(0);
+}
+
+bool gzip_random_access_source::_fill() {
+    _out_offset += _out_end;
+    _out_pos = 0;
+    _out_end = 0;
+    while (!_done) {
+        if (_in_avail.empty()) {
+            _in->read(reinterpret_cast<char*>(_in_buf.data()),
+                      static_cast<std::streamsize>(_in_buf.size()));
+            _in_avail = const_buffer(_in_buf.data(), static_cast<std::size_t>(_in->gcount()));
+            if (_in_avail.empty()) {
+                throw std::runtime_error("Unexpected end of gzip data");
+            }
+        }
+        auto out = mutable_buffer(_out_buf.data(), _out_buf.size());
+        auto res = _use_raw ? _raw(out, _in_avail) : _gz(out, _in_avail);
+        _in_avail += res.bytes_read;
+        _out_end = res.bytes_written;
+        _done    = res.done;
+        if (_out_end != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const_buffer gzip_random_access_source::next(std::size_t n) {
+    if (_out_pos == _out_end && !_fill()) {
+        return {};
+    }
+    return const_buffer(_out_buf.data() + _out_pos, std::min(n, _out_end - _out_pos));
+}
+
+void gzip_random_access_source::consume(std::size_t n) noexcept {
+    neo_assert(expects,
+               n <= _out_end - _out_pos,
+               "Consumed more bytes than were available from the gzip_random_access_source",
+               n,
+               _out_end - _out_pos);
+    _out_pos += n;
+}
+
+void gzip_random_access_source::seek(std::uint64_t uncompressed_offset) {
+    const auto pt = _index.find(uncompressed_offset);
+    _in->clear();
+    _in_avail = {};
+    _done     = false;
+    _out_pos  = 0;
+    _out_end  = 0;
+    if (pt == nullptr) {
+        // Start from the beginning of the file
+        _in->seekg(0);
+        _gz.reset();
+        _use_raw    = false;
+        _out_offset = 0;
+    } else {
+        // Start from the access point. If it is not on a byte boundary, the decompressor must
+        // first take the remaining bits of the prior byte.
+        _in->seekg(static_cast<std::streamoff>(pt->compressed_offset - (pt->bits ? 1 : 0)));
+        _raw.reset();
+        if (pt->bits) {
+            const auto c = _in->get();
+            if (c == std::istream::traits_type::eof()) {
+                throw std::runtime_error("Unexpected end of gzip data");
+            }
+            _raw.prime(pt->bits, c >> (8 - pt->bits));
+        }
+        _raw.set_dictionary(const_buffer(pt->window.data(), pt->window.size()));
+        _use_raw    = true;
+        _out_offset = pt->uncompressed_offset;
+    }
+    if (!*_in) {
+        throw std::runtime_error("Failed to seek in gzip data");
+    }
+    // Decompress and discard data until we reach the requested offset
+    while (_out_offset + _out_end <= uncompressed_offset) {
+        if (!_fill()) {
+            break;
+        }
+    }
+    _out_pos = static_cast<std::size_t>(
+        std::min<std::uint64_t>(uncompressed_offset - _out_offset, _out_end));
+}
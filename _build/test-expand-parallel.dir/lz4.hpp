@@ -0,0 +1,140 @@
+#pragma once
+
+#include <neo/compress.hpp>
+#include <neo/decompress.hpp>
+
+#include <neo/buffer_algorithm/transform.hpp>
+#include <neo/const_buffer.hpp>
+#include <neo/mutable_buffer.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace neo {
+
+/**
+ * The largest size of an uncompressed block in an LZ4 frame. Larger blocks
+ * compress slightly better, but need more memory on both ends.
+ */
+enum class lz4_block_size {
+    max_64kb  = 4,
+    max_256kb = 5,
+    max_1mb   = 6,
+    max_4mb   = 7,
+};
+
+/**
+ * Parameters that control the behavior of an lz4_compressor.
+ */
+struct lz4_options {
+    /**
+     * The compression level. Zero is the fast default, negative levels trade
+     * ratio for even more speed, and levels from 3 to 12 use the much slower
+     * high-compression mode.
+     */
+    int level = 0;
+    /// The size of the blocks that make up the frame
+    lz4_block_size block_size = lz4_block_size::max_64kb;
+    /// Append a checksum of the content to the frame
+    bool checksum = true;
+};
+
+/**
+ * A buffer transformer that compresses data as an LZ4 frame.
+ *
+ * The frame is finished by flush::finish. Every other flush mode makes all
+ * data given so far decodable by a reader of the output.
+ *
+ * The LZ4 frame API can only write into a buffer that is large enough for an
+ * entire compressed block. When the output given to operator() is large
+ * enough, blocks are compressed directly into it. Otherwise they are
+ * compressed into an internal buffer and copied out over as many calls as
+ * needed.
+ */
+class lz4_compressor {
+    // An LZ4F_cctx, kept opaque so that users need not see lz4frame.h
+    void*       _cctx = nullptr;
+    lz4_options _opts;
+
+    std::vector<std::byte> _staging;
+    // The compressed data in _staging that has not yet been written out
+    const_buffer _pending;
+
+    bool _started     = false;
+    bool _end_written = false;
+    bool _finished    = false;
+
+    std::size_t _drain(mutable_buffer& out) noexcept;
+
+public:
+    explicit lz4_compressor(const lz4_options& opts);
+    lz4_compressor()
+        : lz4_compressor(lz4_options()) {}
+    ~lz4_compressor();
+
+    lz4_compressor(lz4_compressor&& o) noexcept;
+    lz4_compressor& operator=(lz4_compressor&& o) noexcept;
+
+    compress_result operator()(mutable_buffer out, const_buffer in, flush f = flush::no_flush);
+
+    /// Begin a new frame. The options are retained.
+    void reset() noexcept;
+
+    const lz4_options& options() const noexcept { return _opts; }
+};
+
+/**
+ * Options for an lz4_decompressor
+ */
+struct lz4_decompress_options {
+    /**
+     * Decode a sequence of concatenated frames as a single stream. As with
+     * gzip_decompress_options::multi_member, the decompressor never reports
+     * `done` in this mode. Use at_frame_boundary() to check that the input
+     * did not end part-way through a frame.
+     */
+    bool multi_frame = false;
+};
+
+/**
+ * A buffer transformer that decompresses data in the LZ4 frame format.
+ */
+class lz4_decompressor {
+    // An LZ4F_dctx, kept opaque so that users need not see lz4frame.h
+    void*                  _dctx = nullptr;
+    lz4_decompress_options _opts;
+    bool                   _frame_done = false;
+
+public:
+    explicit lz4_decompressor(const lz4_decompress_options& opts);
+    lz4_decompressor()
+        : lz4_decompressor(lz4_decompress_options()) {}
+    ~lz4_decompressor();
+
+    lz4_decompressor(lz4_decompressor&& o) noexcept;
+    lz4_decompressor& operator=(lz4_decompressor&& o) noexcept;
+
+    decompress_result operator()(mutable_buffer out, const_buffer in);
+
+    void reset() noexcept;
+
+    /**
+     * Whether the decompressor is between frames, i.e. at least one frame has
+     * been fully decoded and no part of another has been read.
+     */
+    bool at_frame_boundary() const noexcept { return _frame_done; }
+
+    const lz4_decompress_options& options() const noexcept { return _opts; }
+};
+
+/**
+ * A step of this size is enough for the compressor to write 64 KiB blocks
+ * directly into the output, rather than into its internal buffer.
+ */
+template <>
+constexpr std::size_t buffer_transform_dynamic_growth_hint_v<lz4_compressor> = 1024 * 256;
+
+template <>
+constexpr std::size_t buffer_transform_dynamic_growth_hint_v<lz4_decompressor> = 1024 * 1024 * 4;
+
+}  // namespace neo
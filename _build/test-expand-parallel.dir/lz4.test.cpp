@@ -0,0 +1,111 @@
+#include <neo/lz4.hpp>
+
+#include <neo/buffer_algorithm/transform.hpp>
+#include <neo/dynbuf_io.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <random>
+
+namespace {
+
+std::string make_text() {
+    std::string text;
+    for (auto i = 0; i < 20000; ++i) {
+        text += "Line " + std::to_string(i % 97) + " of a payload that needs compressing\n";
+    }
+    // Incompressible data ends up in uncompressed blocks
+    std::mt19937 rng{42};
+    for (auto i = 0; i < 100000; ++i) {
+        text.push_back(static_cast<char>(rng()));
+    }
+    return text;
+}
+
+std::string compress_str(neo::lz4_compressor& comp, const std::string& text) {
+    neo::dynbuf_io<std::string> compressed;
+    auto res = neo::buffer_transform(comp, compressed, neo::const_buffer(text));
+    res += neo::buffer_transform(comp, compressed, neo::const_buffer(), neo::flush::finish);
+    compressed.shrink_uncommitted();
+    CHECK(res.done);
+    CHECK(res.bytes_read == text.size());
+    return std::move(compressed.storage());
+}
+
+}  // namespace
+
+TEST_CASE("Compress/decompress with LZ4") {
+    const auto text       = make_text();
+    auto       level      = GENERATE(-1, 0, 9);
+    auto       block_size = GENERATE(neo::lz4_block_size::max_64kb, neo::lz4_block_size::max_4mb);
+
+    neo::lz4_compressor comp{neo::lz4_options{.level = level, .block_size = block_size}};
+    const auto          compressed = compress_str(comp, text);
+    CHECK(compressed.size() < text.size());
+
+    neo::lz4_decompressor       decomp;
+    neo::dynbuf_io<std::string> plain;
+    auto res = neo::buffer_transform(decomp, plain, neo::const_buffer(compressed));
+    plain.shrink_uncommitted();
+    CHECK(res.done);
+    CHECK(res.bytes_read == compressed.size());
+    CHECK(plain.storage() == text);
+
+    // The compressor can be reused after a reset
+    comp.reset();
+    CHECK(compress_str(comp, text) == compressed);
+}
+
+TEST_CASE("Compress with LZ4 into small pieces of output") {
+    const auto text = make_text();
+
+    auto out_size = GENERATE(std::size_t(1), std::size_t(300), std::size_t(100000));
+
+    neo::lz4_compressor comp;
+    std::string         compressed;
+    std::string         out_buf(out_size, '\0');
+    std::size_t         n_read = 0;
+    bool                done   = false;
+    while (!done) {
+        auto res = comp(neo::mutable_buffer(out_buf),
+                        neo::const_buffer(text) + n_read,
+                        neo::flush::finish);
+        REQUIRE((res.bytes_read || res.bytes_written || res.done));
+        compressed.append(out_buf.data(), res.bytes_written);
+        n_read += res.bytes_read;
+        done = res.done;
+    }
+    CHECK(n_read == text.size());
+
+    neo::lz4_decompressor       decomp;
+    neo::dynbuf_io<std::string> plain;
+    neo::buffer_transform(decomp, plain, neo::const_buffer(compressed));
+    plain.shrink_uncommitted();
+    CHECK(plain.storage() == text);
+}
+
+TEST_CASE("Decompress concatenated LZ4 frames") {
+    const auto          text = make_text();
+    neo::lz4_compressor comp;
+    auto                both = compress_str(comp, text);
+    comp.reset();
+    both += compress_str(comp, "Another frame");
+
+    neo::lz4_decompressor       decomp{neo::lz4_decompress_options{.multi_frame = true}};
+    neo::dynbuf_io<std::string> plain;
+    neo::buffer_transform(decomp, plain, neo::const_buffer(both));
+    plain.shrink_uncommitted();
+    CHECK(plain.storage() == text + "Another frame");
+    CHECK(decomp.at_frame_boundary());
+}
+
+TEST_CASE("Reject corrupt LZ4 data") {
+    const auto          text = make_text();
+    neo::lz4_compressor comp;
+    auto                compressed = compress_str(comp, text);
+    compressed[compressed.size() / 2] ^= 0x55;
+
+    neo::lz4_decompressor       decomp;
+    neo::dynbuf_io<std::string> plain;
+    CHECK_THROWS(neo::buffer_transform(decomp, plain, neo::const_buffer(compressed)));
+}
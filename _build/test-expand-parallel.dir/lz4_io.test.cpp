@@ -0,0 +1,54 @@
+#include "./lz4_io.hpp"
+
+#include <neo/dynbuf_io.hpp>
+#include <neo/string_io.hpp>
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("Compress a string with lz4_sink") {
+    std::string text;
+    for (auto i = 0; i < 100; ++i) {
+        text += "I am a line of text that will be compressed with LZ4.\n";
+    }
+
+    neo::string_dynbuf_io lz4_data;
+    neo::lz4_sink         lz4_out{lz4_data, neo::lz4_options{.level = 9}};
+    neo::buffer_copy(lz4_out, neo::const_buffer(text));
+    lz4_out.finish();
+
+    neo::string_dynbuf_io plain;
+    neo::lz4_source       lz4_in{lz4_data};
+    neo::buffer_copy(plain, lz4_in);
+    CHECK(plain.string() == text);
+
+    neo::string_dynbuf_io compressed;
+    neo::lz4_compress(compressed, neo::const_buffer(text));
+    neo::string_dynbuf_io decompressed;
+    neo::lz4_decompress(decompressed, compressed);
+    CHECK(decompressed.string() == text);
+}
+
+TEST_CASE("Flush an lz4_sink mid-stream") {
+    neo::string_dynbuf_io lz4_data;
+    neo::lz4_sink         lz4_out{lz4_data};
+
+    neo::buffer_copy(lz4_out, neo::const_buffer("Hello, "));
+    lz4_out.flush();
+
+    // Everything written so far can be decompressed, even though the frame is incomplete
+    neo::lz4_decompressor decomp;
+    std::string           partial;
+    partial.resize(64);
+    auto lz4_str = std::string(lz4_data.read_area_view());
+    auto res
+        = neo::buffer_transform(decomp, neo::mutable_buffer(partial), neo::const_buffer(lz4_str));
+    partial.resize(res.bytes_written);
+    CHECK_FALSE(res.done);
+    CHECK(partial == "Hello, ");
+
+    neo::buffer_copy(lz4_out, neo::const_buffer("world!"));
+    lz4_out.finish();
+    neo::string_dynbuf_io plain;
+    neo::lz4_decompress(plain, lz4_data);
+    CHECK(plain.string() == "Hello, world!");
+}
@@ -0,0 +1,209 @@
+#pragma once
+
+#include "./compress.hpp"
+#include "./deflate.hpp"
+
+#include <neo/buffer_sink.hpp>
+#include <neo/buffer_source.hpp>
+#include <neo/buffers_consumer.hpp>
+#include <neo/ref.hpp>
+#include <neo/transform_io.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+
+namespace neo {
+
+/**
+ * Options for a parallel_gzip_compressor.
+ */
+struct parallel_gzip_options {
+    /// Parameters for compressing each block
+    deflate_options deflate = {.window_bits = 15};
+    /// The number of worker threads. If zero, uses the number of hardware threads.
+    unsigned thread_count = 0;
+    /// The amount of input that is compressed as a single unit by a worker
+    std::size_t block_size = 128 * 1024;
+};
+
+/**
+ * A compressor that generates a single gzip stream, compressing the data on
+ * multiple threads in the style of pigz.
+ *
+ * The input is split into fixed-size blocks. Each block is compressed
+ * independently, primed with the final 32 KiB of the data preceding it as a
+ * dictionary, so little compression ratio is lost. The compressed blocks are
+ * stitched together in order, and the CRC-32 of the blocks is combined for the
+ * trailer. The result is a standard single-member gzip stream.
+ */
+class parallel_gzip_compressor {
+    struct state;
+    std::unique_ptr<state> _state;
+
+public:
+    explicit parallel_gzip_compressor(const parallel_gzip_options& opts);
+    parallel_gzip_compressor()
+        : parallel_gzip_compressor(parallel_gzip_options()) {}
+    ~parallel_gzip_compressor();
+
+    parallel_gzip_compressor(parallel_gzip_compressor&&) noexcept;
+    parallel_gzip_compressor& operator=(parallel_gzip_compressor&&) noexcept;
+
+    compress_result operator()(mutable_buffer out, const_buffer in, flush f = flush::no_flush);
+
+    void reset() noexcept;
+};
+
+template <>
+constexpr std::size_t buffer_transform_dynamic_growth_hint_v<parallel_gzip_compressor> = 1024
+    * 1024 * 4;
+
+/**
+ * @brief Adapt a buffer_sink with gzip-based compression using multiple threads.
+ *
+ * @tparam Sink The underlying buffer sink (A file, socket, etc.)
+ */
+template <buffer_sink Sink>
+class parallel_gzip_sink : public buffer_transform_sink<Sink, parallel_gzip_compressor> {
+public:
+    explicit parallel_gzip_sink(Sink&& out, const parallel_gzip_options& opts = {})
+        : parallel_gzip_sink::buffer_transform_sink{NEO_FWD(out),
+                                                    parallel_gzip_compressor{opts}} {}
+
+    std::size_t finish() {
+        return buffer_transform(this->transformer(), this->sink(), const_buffer(), flush::finish)
+            .bytes_written;
+    }
+};
+
+template <buffer_sink S>
+explicit parallel_gzip_sink(S &&) -> parallel_gzip_sink<S>;
+
+template <buffer_sink S>
+parallel_gzip_sink(S&&, const parallel_gzip_options&) -> parallel_gzip_sink<S>;
+
+/**
+ * Options for a parallel_gzip_decoder.
+ */
+struct parallel_gzip_decompress_options {
+    /// The number of worker threads. If zero, uses the number of hardware threads.
+    unsigned thread_count = 0;
+    /**
+     * Members that are larger than this, and are not BGZF blocks, are
+     * decompressed on the calling thread rather than buffered for a worker.
+     * This bounds the memory used for streams that are a single large member.
+     */
+    std::size_t max_member_size = 1024 * 1024 * 64;
+};
+
+/**
+ * Decompresses a stream of concatenated gzip members, decompressing multiple
+ * members concurrently on worker threads. This is the engine behind
+ * parallel_gzip_source.
+ *
+ * Member boundaries are found from the BSIZE field of BGZF blocks, or else by
+ * searching for the gzip magic number. A boundary found by searching is
+ * verified by checking that the preceding member ends exactly at that point,
+ * and the search is resumed if it does not. If no boundary is found within
+ * `max_member_size` bytes, the remainder of the stream is decompressed
+ * sequentially on the calling thread.
+ */
+class parallel_gzip_decoder {
+    struct state;
+    std::unique_ptr<state> _state;
+
+public:
+    explicit parallel_gzip_decoder(const parallel_gzip_decompress_options& opts);
+    parallel_gzip_decoder()
+        : parallel_gzip_decoder(parallel_gzip_decompress_options()) {}
+    ~parallel_gzip_decoder();
+
+    parallel_gzip_decoder(parallel_gzip_decoder&&) noexcept;
+    parallel_gzip_decoder& operator=(parallel_gzip_decoder&&) noexcept;
+
+    /// Whether the decoder would like more compressed input before returning more output
+    bool wants_input() const noexcept;
+
+    /// Give more compressed input to the decoder. All of the input is taken.
+    void feed(const_buffer in);
+
+    /// Signal that there is no more compressed input.
+    void finish_input();
+
+    /**
+     * Obtain decompressed data, in order. This may wait for a worker to
+     * finish. Returns an empty buffer if more input is needed (when
+     * wants_input() is true) or if the end of the data has been reached (when
+     * done() is true).
+     */
+    const_buffer output();
+
+    /// Discard the given number of bytes from the front of output()
+    void consume_output(std::size_t n) noexcept;
+
+    /// Whether all of the data has been decompressed and read
+    bool done() const noexcept;
+};
+
+/**
+ * @brief A buffer_source that decompresses a stream of gzip members (as
+ * produced by BGZF or by concatenating gzip files) using multiple threads.
+ *
+ * A stream that is a single gzip member is still decompressed correctly, but
+ * without any parallelism.
+ *
+ * @tparam Source The underlying buffer source (A file, socket, etc.)
+ */
+template <buffer_source Source>
+class parallel_gzip_source {
+    [[no_unique_address]] wrap_refs_t<Source> _source;
+    parallel_gzip_decoder                     _decoder;
+
+    // The amount of compressed data to request from the source at a time
+    static constexpr std::size_t _input_chunk_size = 1024 * 256;
+
+public:
+    explicit parallel_gzip_source(Source&& in, const parallel_gzip_decompress_options& opts = {})
+        : _source(NEO_FWD(in))
+        , _decoder(opts) {}
+
+    NEO_DECL_UNREF_GETTER(source, _source);
+
+    const_buffer next(std::size_t n) {
+        while (true) {
+            auto out = _decoder.output();
+            if (!out.empty()) {
+                return out.first(std::min(n, out.size()));
+            }
+            if (_decoder.done()) {
+                return {};
+            }
+            // The decoder needs more input
+            auto&& part = unref(_source).next(_input_chunk_size);
+            buffers_consumer in{part};
+            if (in.empty()) {
+                _decoder.finish_input();
+                continue;
+            }
+            std::size_t n_fed = 0;
+            while (!in.empty()) {
+                auto cb = in.next_contiguous();
+                _decoder.feed(cb);
+                in.consume(cb.size());
+                n_fed += cb.size();
+            }
+            unref(_source).consume(n_fed);
+        }
+    }
+
+    void consume(std::size_t n) noexcept { _decoder.consume_output(n); }
+};
+
+template <buffer_source S>
+explicit parallel_gzip_source(S &&) -> parallel_gzip_source<S>;
+
+template <buffer_source S>
+parallel_gzip_source(S&&, const parallel_gzip_decompress_options&) -> parallel_gzip_source<S>;
+
+}  // namespace neo
@@ -0,0 +1,196 @@
+#include "./zstd.hpp"
+
+#include <neo/assert.hpp>
+
+#include <zstd.h>
+
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+#define MY_CCTX (static_cast<::ZSTD_CCtx*>(_cctx))
+#define MY_DCTX (static_cast<::ZSTD_DCtx*>(_dctx))
+
+using namespace neo;
+
+namespace {
+
+// A 3-byte block header and one byte of RLE data decode to at most 128 KiB, so a Zstandard frame
+// cannot expand data by more than this factor, and a larger content size is not believed
+constexpr std::size_t max_zstd_ratio = 1024 * 128 / 4;
+
+::ZSTD_EndDirective zstd_directive(neo::flush f) noexcept {
+    switch (f) {
+    case flush::no_flush:
+        return ZSTD_e_continue;
+    case flush::finish:
+        return ZSTD_e_end;
+    case flush::partial:
+    case flush::sync:
+    case flush::full:
+    case flush::block:
+        return ZSTD_e_flush;
+    }
+    neo_assert_always(expects, false, "Invalid flush mode given to zstd_compressor", int(f));
+    return ZSTD_e_continue;
+}
+
+[[noreturn]] void throw_zstd_error(const char* what, std::size_t rc) {
+    throw std::runtime_error(std::string(what) + ": " + ::ZSTD_getErrorName(rc));
+}
+
+void set_cparam(::ZSTD_CCtx* cctx, ::ZSTD_cParameter param, int value) {
+    auto rc = ::ZSTD_CCtx_setParameter(cctx, param, value);
+    if (::ZSTD_isError(rc)) {
+        throw_zstd_error("Invalid zstd compression parameter", rc);
+    }
+}
+
+}  // namespace
+
+zstd_compressor::zstd_compressor(const zstd_options& opts)
+    : _cctx(::ZSTD_createCCtx())
+    , _opts(opts) {
+    if (!_cctx) {
+        throw std::bad_alloc();
+    }
+    try {
+        set_cparam(MY_CCTX, ZSTD_c_compressionLevel, opts.level);
+        set_cparam(MY_CCTX, ZSTD_c_checksumFlag, opts.checksum ? 1 : 0);
+        if (opts.window_log) {
+            set_cparam(MY_CCTX, ZSTD_c_windowLog, opts.window_log);
+        }
+        auto n_threads
+            = opts.thread_count ? opts.thread_count : std::thread::hardware_concurrency();
+        if (n_threads > 1) {
+            // Fails if libzstd does not support multithreading, in which case we compress on the
+            // calling thread
+            ::ZSTD_CCtx_setParameter(MY_CCTX, ZSTD_c_nbWorkers, static_cast<int>(n_threads));
+        }
+    } catch (...) {
+        ::ZSTD_freeCCtx(MY_CCTX);
+        throw;
+    }
+}
+
+zstd_compressor::~zstd_compressor() { ::ZSTD_freeCCtx(MY_CCTX); }
+
+zstd_compressor::zstd_compressor(zstd_compressor&& o) noexcept
+    : _cctx(std::exchange(o._cctx, nullptr))
+    , _opts(o._opts)
+    , _finished(o._finished) {}
+
+zstd_compressor& zstd_compressor::operator=(zstd_compressor&& o) noexcept {
+    std::swap(_cctx, o._cctx);
+    std::swap(_opts, o._opts);
+    std::swap(_finished, o._finished);
+    return *this;
+}
+
+void zstd_compressor::reset() noexcept {
+    ::ZSTD_CCtx_reset(MY_CCTX, ZSTD_reset_session_only);
+    _finished = false;
+}
+
+compress_result zstd_compressor::operator()(mutable_buffer out, const_buffer in, flush f) {
+    if (_finished) {
+        // Further calls would begin a new frame. The application must call reset() for that.
+        return {.done = true};
+    }
+    ::ZSTD_inBuffer  zin{in.data(), in.size(), 0};
+    ::ZSTD_outBuffer zout{out.data(), out.size(), 0};
+    const auto       directive = zstd_directive(f);
+    std::size_t      rc        = 0;
+    do {
+        // With worker threads, ZSTD_e_continue returns as soon as it makes any progress, so we
+        // keep going until one of the buffers is exhausted
+        rc = ::ZSTD_compressStream2(MY_CCTX, &zout, &zin, directive);
+        if (::ZSTD_isError(rc)) {
+            throw_zstd_error("zstd compression failed", rc);
+        }
+    } while (zin.pos != zin.size && zout.pos != zout.size);
+    // For a flush or end directive, zero means that everything has been written out
+    _finished = directive == ZSTD_e_end && rc == 0;
+    return {
+        .bytes_written = zout.pos,
+        .bytes_read    = zin.pos,
+        .done          = _finished,
+    };
+}
+
+zstd_decompressor::zstd_decompressor(const zstd_decompress_options& opts)
+    : _dctx(::ZSTD_createDCtx())
+    , _opts(opts) {
+    if (!_dctx) {
+        throw std::bad_alloc();
+    }
+    if (opts.window_log_max) {
+        auto rc = ::ZSTD_DCtx_setParameter(MY_DCTX, ZSTD_d_windowLogMax, opts.window_log_max);
+        if (::ZSTD_isError(rc)) {
+            ::ZSTD_freeDCtx(MY_DCTX);
+            throw_zstd_error("Invalid zstd decompression parameter", rc);
+        }
+    }
+}
+
+zstd_decompressor::~zstd_decompressor() { ::ZSTD_freeDCtx(MY_DCTX); }
+
+zstd_decompressor::zstd_decompressor(zstd_decompressor&& o) noexcept
+    : _dctx(std::exchange(o._dctx, nullptr))
+    , _opts(o._opts)
+    , _frame_done(o._frame_done) {}
+
+zstd_decompressor& zstd_decompressor::operator=(zstd_decompressor&& o) noexcept {
+    std::swap(_dctx, o._dctx);
+    std::swap(_opts, o._opts);
+    std::swap(_frame_done, o._frame_done);
+    return *this;
+}
+
+void zstd_decompressor::reset() noexcept {
+    ::ZSTD_DCtx_reset(MY_DCTX, ZSTD_reset_session_only);
+    _frame_done = false;
+}
+
+decompress_result zstd_decompressor::operator()(mutable_buffer out, const_buffer in) {
+    ::ZSTD_inBuffer  zin{in.data(), in.size(), 0};
+    ::ZSTD_outBuffer zout{out.data(), out.size(), 0};
+    while (!_frame_done || (_opts.multi_frame && zin.pos != zin.size)) {
+        // Another frame may begin here in multi-frame mode
+        _frame_done = false;
+        auto rc     = ::ZSTD_decompressStream(MY_DCTX, &zout, &zin);
+        if (::ZSTD_isError(rc)) {
+            throw_zstd_error("zstd decompression failed", rc);
+        }
+        if (rc != 0) {
+            // More input is needed, or the output is full
+            break;
+        }
+        // Zero means that a frame was fully decoded and flushed
+        _frame_done = true;
+    }
+    return {
+        .bytes_written = zout.pos,
+        .bytes_read    = zin.pos,
+        .done          = _frame_done && !_opts.multi_frame,
+    };
+}
+
+std::optional<std::size_t> neo::zstd_frame_content_size(const_buffer frame) noexcept {
+    auto size = ::ZSTD_getFrameContentSize(frame.data(), frame.size());
+    if (size == ZSTD_CONTENTSIZE_UNKNOWN || size == ZSTD_CONTENTSIZE_ERROR) {
+        return std::nullopt;
+    }
+    return static_cast<std::size_t>(size);
+}
+
+std::optional<std::size_t> neo::zstd_output_size_hint(const_buffer frame) noexcept {
+    auto size = zstd_frame_content_size(frame);
+    if (!size) {
+        return std::nullopt;
+    }
+    return std::min(*size, frame.size() * max_zstd_ratio);
+}
@@ -0,0 +1,146 @@
+#include <neo/zstd.hpp>
+
+#include <neo/as_buffer.hpp>
+#include <neo/buffer_algorithm/transform.hpp>
+#include <neo/dynbuf_io.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+
+namespace {
+
+std::string make_text() {
+    std::string text;
+    for (auto i = 0; i < 20000; ++i) {
+        text += "Line " + std::to_string(i % 97) + " of an artifact that needs compressing\n";
+    }
+    return text;
+}
+
+std::string compress_str(neo::zstd_compressor& comp, const std::string& text) {
+    neo::dynbuf_io<std::string> compressed;
+    auto res = neo::buffer_transform(comp, compressed, neo::const_buffer(text));
+    res += neo::buffer_transform(comp, compressed, neo::const_buffer(), neo::flush::finish);
+    compressed.shrink_uncommitted();
+    CHECK(res.done);
+    CHECK(res.bytes_read == text.size());
+    return std::move(compressed.storage());
+}
+
+}  // namespace
+
+TEST_CASE("Compress/decompress with zstd") {
+    const auto text    = make_text();
+    auto       threads = GENERATE(1u, 4u);
+
+    neo::zstd_compressor comp{neo::zstd_options{.level = 5, .thread_count = threads}};
+    const auto           compressed = compress_str(comp, text);
+    CHECK(compressed.size() < text.size() / 10);
+
+    neo::zstd_decompressor      decomp;
+    neo::dynbuf_io<std::string> plain;
+    auto res = neo::buffer_transform(decomp, plain, neo::const_buffer(compressed));
+    plain.shrink_uncommitted();
+    CHECK(res.done);
+    CHECK(res.bytes_read == compressed.size());
+    CHECK(plain.storage() == text);
+
+    // The compressor can be reused after a reset
+    comp.reset();
+    CHECK(compress_str(comp, text) == compressed);
+}
+
+TEST_CASE("Each zstd compression step exhausts the input or the output") {
+    std::string text;
+    for (auto i = 0; i < 8; ++i) {
+        text += make_text();
+    }
+
+    // Worker threads may return early from each ZSTD_compressStream2() call
+    neo::zstd_compressor comp{neo::zstd_options{.thread_count = 4, .window_log = 17}};
+    std::string          out_buf(1024 * 64, '\0');
+    std::string          compressed;
+    std::size_t          n_read = 0;
+    while (n_read != text.size()) {
+        auto in  = neo::const_buffer(text) + n_read;
+        in       = in.first(std::min(in.size(), out_buf.size()));
+        auto res = comp(neo::mutable_buffer(out_buf), in);
+        REQUIRE((res.bytes_read == in.size() || res.bytes_written == out_buf.size()));
+        compressed.append(out_buf.data(), res.bytes_written);
+        n_read += res.bytes_read;
+    }
+    while (true) {
+        auto res = comp(neo::mutable_buffer(out_buf), neo::const_buffer(), neo::flush::finish);
+        compressed.append(out_buf.data(), res.bytes_written);
+        if (res.done) {
+            break;
+        }
+    }
+
+    neo::zstd_decompressor      decomp;
+    neo::dynbuf_io<std::string> plain;
+    neo::buffer_transform(decomp, plain, neo::const_buffer(compressed));
+    plain.shrink_uncommitted();
+    CHECK(plain.storage() == text);
+}
+
+TEST_CASE("Record the content size of a zstd frame compressed in one call") {
+    const auto text    = make_text();
+    auto       threads = GENERATE(1u, 4u);
+
+    neo::zstd_compressor comp{neo::zstd_options{.thread_count = threads}};
+    std::string          compressed(text.size(), '\0');
+    auto res = comp(neo::mutable_buffer(compressed), neo::const_buffer(text), neo::flush::finish);
+    REQUIRE(res.done);
+    CHECK(res.bytes_read == text.size());
+    compressed.resize(res.bytes_written);
+    CHECK(neo::zstd_frame_content_size(neo::const_buffer(compressed)) == text.size());
+    CHECK(neo::zstd_output_size_hint(neo::const_buffer(compressed)) == text.size());
+}
+
+TEST_CASE("Do not believe an impossible zstd frame content size") {
+    // A frame header that claims 1 TiB of content, followed by nothing
+    const unsigned char header[] = {
+        0x28, 0xb5, 0x2f, 0xfd, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+    };
+    const auto frame = neo::const_buffer(neo::as_buffer(header));
+    CHECK(neo::zstd_frame_content_size(frame) == std::size_t(1) << 40);
+    const auto hint = neo::zstd_output_size_hint(frame);
+    REQUIRE(hint);
+    CHECK(*hint < 1024 * 1024);
+}
+
+TEST_CASE("Decompress concatenated zstd frames") {
+    const auto           text = make_text();
+    neo::zstd_compressor comp;
+    auto                 both = compress_str(comp, text);
+    comp.reset();
+    both += compress_str(comp, "Another frame");
+
+    neo::zstd_decompressor      decomp{neo::zstd_decompress_options{.multi_frame = true}};
+    neo::dynbuf_io<std::string> plain;
+    neo::buffer_transform(decomp, plain, neo::const_buffer(both));
+    plain.shrink_uncommitted();
+    CHECK(plain.storage() == text + "Another frame");
+    CHECK(decomp.at_frame_boundary());
+
+    // Without multi_frame, decompression stops after the first frame
+    neo::zstd_decompressor      single;
+    neo::dynbuf_io<std::string> first;
+    auto res = neo::buffer_transform(single, first, neo::const_buffer(both));
+    first.shrink_uncommitted();
+    CHECK(res.done);
+    CHECK(first.storage() == text);
+}
+
+TEST_CASE("Reject corrupt zstd data") {
+    const auto           text = make_text();
+    neo::zstd_compressor comp;
+    auto                 compressed = compress_str(comp, text);
+    compressed[compressed.size() / 2] ^= 0x55;
+
+    neo::zstd_decompressor      decomp;
+    neo::dynbuf_io<std::string> plain;
+    CHECK_THROWS(neo::buffer_transform(decomp, plain, neo::const_buffer(compressed)));
+}
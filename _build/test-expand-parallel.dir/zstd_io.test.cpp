@@ -0,0 +1,72 @@
+#include "./zstd_io.hpp"
+
+#include <neo/dynbuf_io.hpp>
+#include <neo/string_io.hpp>
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("Compress a string with zstd_sink") {
+    std::string text;
+    for (auto i = 0; i < 100; ++i) {
+        text += "I am a line of text that will be compressed with zstd.\n";
+    }
+
+    neo::string_dynbuf_io zst_data;
+    neo::zstd_sink        zst_out{zst_data, neo::zstd_options{.level = 9}};
+    neo::buffer_copy(zst_out, neo::const_buffer(text));
+    zst_out.finish();
+
+    neo::string_dynbuf_io plain;
+    neo::zstd_source      zst_in{zst_data};
+    neo::buffer_copy(plain, zst_in);
+    CHECK(plain.string() == text);
+
+    neo::string_dynbuf_io compressed;
+    neo::zstd_compress(compressed, neo::const_buffer(text));
+    neo::string_dynbuf_io decompressed;
+    neo::zstd_decompress(decompressed, compressed);
+    CHECK(decompressed.string() == text);
+}
+
+TEST_CASE("Compress several zstd jobs with worker threads") {
+    std::string text;
+    for (auto i = 0; i < 100000; ++i) {
+        text += "Line " + std::to_string(i) + " of a file that is shared among the workers\n";
+    }
+
+    // A small window keeps each job small, so the input spans many of them
+    neo::string_dynbuf_io zst_data;
+    neo::zstd_sink        zst_out{zst_data, neo::zstd_options{.thread_count = 4, .window_log = 17}};
+    auto                  n_read = neo::buffer_copy(zst_out, neo::const_buffer(text));
+    zst_out.finish();
+    CHECK(n_read == text.size());
+
+    neo::string_dynbuf_io plain;
+    neo::zstd_decompress(plain, zst_data);
+    CHECK(plain.string() == text);
+}
+
+TEST_CASE("Flush a zstd_sink mid-stream") {
+    neo::string_dynbuf_io zst_data;
+    neo::zstd_sink        zst_out{zst_data};
+
+    neo::buffer_copy(zst_out, neo::const_buffer("Hello, "));
+    zst_out.flush();
+
+    // Everything written so far can be decompressed, even though the frame is incomplete
+    neo::zstd_decompressor decomp;
+    std::string            partial;
+    partial.resize(64);
+    auto zst_str = std::string(zst_data.read_area_view());
+    auto res
+        = neo::buffer_transform(decomp, neo::mutable_buffer(partial), neo::const_buffer(zst_str));
+    partial.resize(res.bytes_written);
+    CHECK_FALSE(res.done);
+    CHECK(partial == "Hello, ");
+
+    neo::buffer_copy(zst_out, neo::const_buffer("world!"));
+    zst_out.finish();
+    neo::string_dynbuf_io plain;
+    neo::zstd_decompress(plain, zst_data);
+    CHECK(plain.string() == "Hello, world!");
+}
@@ -0,0 +1,45 @@
+#include <neo/adler32.hpp>
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("Adler-32 some data") {
+    CHECK(neo::adler32::calc(neo::const_buffer("Wikipedia")) == 0x11E60398);
+    CHECK(neo::adler32::calc(neo::const_buffer("")) == 1);
+}
+
+TEST_CASE("Adler-32 in bulk matches the bytewise calculation") {
+    std::string data;
+    for (auto i = 0; i < 100'000; ++i) {
+        data.push_back(static_cast<char>((i * 7919) ^ (i >> 3)));
+    }
+    // All 0xff bytes make the sums grow as fast as possible
+    data.append(20'000, '\xff');
+
+    for (std::size_t size : {0, 1, 31, 32, 63, 64, 65, 200, 5552, 5553, 99'999, 120'000}) {
+        const auto part = neo::const_buffer(data).first(size);
+        // Feed one byte at a time, which never takes the bulk paths
+        neo::adler32 bytewise;
+        for (auto i = 0u; i < size; ++i) {
+            bytewise.feed(part.first(i + 1) + i);
+        }
+        CHECK(neo::adler32::calc(part) == bytewise.value());
+        // An unaligned start
+        if (size > 1) {
+            neo::adler32 bytewise_tail;
+            for (auto i = 1u; i < size; ++i) {
+                bytewise_tail.feed(part.first(i + 1) + i);
+            }
+            CHECK(neo::adler32::calc(part + 1) == bytewise_tail.value());
+        }
+    }
+}
+
+TEST_CASE("Combine Adler-32 values") {
+    const auto whole = neo::const_buffer("Wikipedia");
+    for (std::size_t split : {0, 1, 4, 8, 9}) {
+        const auto head = whole.first(split);
+        const auto tail = whole + split;
+        CHECK(neo::adler32::combine(neo::adler32::calc(head), neo::adler32::calc(tail), tail.size())
+              == 0x11E60398);
+    }
+}
@@ -0,0 +1,395 @@
+#include "./bgzf.hpp"
+
+#include <neo/assert.hpp>
+#include <neo/buffer_algorithm/copy.hpp>
+
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+
+using namespace neo;
+
+namespace {
+
+// ID1, ID2, CM, FLG, MTIME, XFL, OS, and XLEN
+constexpr std::size_t gzip_fixed_header_size = 12;
+// The position of BSIZE in a block, following the fixed header and the BGZF subfield header
+constexpr std::size_t bgzf_bsize_offset = 16;
+// A block holds at most 64 KiB of uncompressed data
+constexpr std::uint32_t bgzf_max_isize = 0x10000;
+
+// The BGZF subfield, with a placeholder BSIZE
+const std::byte bgzf_extra_field[] = {
+    std::byte('B'),
+    std::byte('C'),
+    std::byte(2),
+    std::byte(0),
+    std::byte(0),
+    std::byte(0),
+};
+
+// The empty block that marks the end of a BGZF file. These exact bytes are expected by htslib.
+const std::byte bgzf_eof_block[] = {
+    std::byte(0x1f), std::byte(0x8b), std::byte(0x08), std::byte(0x04), std::byte(0x00),
+    std::byte(0x00), std::byte(0x00), std::byte(0x00), std::byte(0x00), std::byte(0xff),
+    std::byte(0x06), std::byte(0x00), std::byte(0x42), std::byte(0x43), std::byte(0x02),
+    std::byte(0x00), std::byte(0x1b), std::byte(0x00), std::byte(0x03), std::byte(0x00),
+    std::byte(0x00), std::byte(0x00), std::byte(0x00), std::byte(0x00), std::byte(0x00),
+    std::byte(0x00), std::byte(0x00), std::byte(0x00),
+};
+
+std::uint16_t load_le16(const std::byte* p) noexcept {
+    return static_cast<std::uint16_t>(std::uint16_t(p[0]) | (std::uint16_t(p[1]) << 8));
+}
+
+std::uint32_t load_le32(const std::byte* p) noexcept {
+    return std::uint32_t(p[0]) | (std::uint32_t(p[1]) << 8) | (std::uint32_t(p[2]) << 16)
+        | (std::uint32_t(p[3]) << 24);
+}
+
+void write_le64(std::ostream& out, std::uint64_t v) {
+    char bytes[8];
+    for (auto& b : bytes) {
+        b = static_cast<char>(v & 0xff);
+        v >>= 8;
+    }
+    out.write(bytes, sizeof bytes);
+}
+
+std::uint64_t read_le64(std::istream& in) {
+    unsigned char bytes[8];
+    in.read(reinterpret_cast<char*>(bytes), sizeof bytes);
+    if (in.gcount() != sizeof bytes) {
+        throw std::runtime_error("Unexpected end of BGZF index");
+    }
+    std::uint64_t v = 0;
+    for (auto i = 8; i > 0; --i) {
+        v = (v << 8) | bytes[i - 1];
+    }
+    return v;
+}
+
+std::size_t read_some(std::istream& in, std::byte* dest, std::size_t size) {
+    in.read(reinterpret_cast<char*>(dest), static_cast<std::streamsize>(size));
+    return static_cast<std::size_t>(in.gcount());
+}
+
+/**
+ * Read an entire BGZF block from the stream into `block`. Returns `false` if
+ * the stream is at its end.
+ */
+bool read_bgzf_block(std::istream& in, std::vector<std::byte>& block) {
+    block.resize(gzip_fixed_header_size);
+    auto n_read = read_some(in, block.data(), block.size());
+    if (n_read == 0) {
+        return false;
+    }
+    if (n_read != block.size()) {
+        throw std::runtime_error("Truncated BGZF block header");
+    }
+    const auto xlen = load_le16(block.data() + 10);
+    block.resize(gzip_fixed_header_size + xlen);
+    if (read_some(in, block.data() + gzip_fixed_header_size, xlen) != xlen) {
+        throw std::runtime_error("Truncated BGZF block header");
+    }
+    const auto block_size = bgzf_block_size(const_buffer(block.data(), block.size()));
+    if (!block_size) {
+        throw std::runtime_error("Data is not BGZF compressed (missing BSIZE)");
+    }
+    // The smallest block is a header and an eight-byte trailer
+    if (*block_size < block.size() + 8) {
+        throw std::runtime_error("Invalid BGZF block size");
+    }
+    const auto header_size = block.size();
+    block.resize(*block_size);
+    const auto n_rest = *block_size - header_size;
+    if (read_some(in, block.data() + header_size, n_rest) != n_rest) {
+        throw std::runtime_error("Truncated BGZF block");
+    }
+    return true;
+}
+
+}  // namespace
+
+std::optional<std::size_t> neo::bgzf_block_size(const_buffer header) noexcept {
+    if (header.size() < gzip_fixed_header_size) {
+        return std::nullopt;
+    }
+    auto p = header.data();
+    if (p[0] != std::byte(0x1f) || p[1] != std::byte(0x8b) || p[2] != std::byte(0x08)
+        || (p[3] & std::byte(0x04)) == std::byte(0)) {
+        // Not a gzip header, or there is no FEXTRA
+        return std::nullopt;
+    }
+    const auto xlen = load_le16(p + 10);
+    if (header.size() < gzip_fixed_header_size + xlen) {
+        return std::nullopt;
+    }
+    // Search the subfields for "BC"
+    auto extra = const_buffer(p + gzip_fixed_header_size, xlen);
+    while (extra.size() >= 4) {
+        const auto slen = load_le16(extra.data() + 2);
+        if (extra.size() < 4u + slen) {
+            break;
+        }
+        if (extra[0] == std::byte('B') && extra[1] == std::byte('C') && slen == 2) {
+            return std::size_t(load_le16(extra.data() + 4)) + 1;
+        }
+        extra += 4u + slen;
+    }
+    return std::nullopt;
+}
+
+void bgzf_index::add(const bgzf_index_entry& e) {
+    neo_assert(expects,
+               _entries.empty()
+                   || (e.compressed_offset > _entries.back().compressed_offset
+                       && e.uncompressed_offset >= _entries.back().uncompressed_offset),
+               "BGZF index entries must be added in order",
+               e.compressed_offset,
+               e.uncompressed_offset);
+    _entries.push_back(e);
+}
+
+bgzf_index_entry bgzf_index::find(std::uint64_t uncompressed_offset) const noexcept {
+    // Find the last entry that begins at or before the offset
+    auto it = std::upper_bound(_entries.cbegin(),
+                               _entries.cend(),
+                               uncompressed_offset,
+                               [](std::uint64_t off, const bgzf_index_entry& e) {
+                                   return off < e.uncompressed_offset;
+                               });
+    if (it == _entries.cbegin()) {
+        return {};
+    }
+    return *std::prev(it);
+}
+
+void bgzf_index::write(std::ostream& out) const {
+    write_le64(out, _entries.size());
+    for (auto& e : _entries) {
+        write_le64(out, e.compressed_offset);
+        write_le64(out, e.uncompressed_offset);
+    }
+}
+
+bgzf_index bgzf_index::read(std::istream& in) {
+    bgzf_index ret;
+    const auto count = read_le64(in);
+    for (auto i = 0ull; i < count; ++i) {
+        bgzf_index_entry e;
+        e.compressed_offset   = read_le64(in);
+        e.uncompressed_offset = read_le64(in);
+        ret._entries.push_back(e);
+    }
+    return ret;
+}
+
+bgzf_index bgzf_index::build(std::istream& in) {
+    bgzf_index             ret;
+    std::vector<std::byte> block;
+    bgzf_index_entry       pos;
+    while (read_bgzf_block(in, block)) {
+        // The uncompressed size is the final four bytes of the block
+        const auto isize = load_le32(block.data() + block.size() - 4);
+        pos.compressed_offset += block.size();
+        pos.uncompressed_offset += isize;
+        if (isize != 0) {
+            ret.add(pos);
+        }
+    }
+    return ret;
+}
+
+bgzf_compressor::bgzf_compressor(const bgzf_options& opts)
+    : _gzip(deflate_compressor(opts.deflate)) {
+    _block.reserve(max_block_input);
+}
+
+void bgzf_compressor::reset() noexcept {
+    _block.clear();
+    _pending.clear();
+    _pending_pos         = 0;
+    _compressed_offset   = 0;
+    _uncompressed_offset = 0;
+    _index               = bgzf_index();
+    _eof_queued          = false;
+    _done                = false;
+}
+
+bool bgzf_compressor::_try_compress(gzip_compressor<deflate_compressor>& gz) {
+    gz.reset();
+    gz.set_extra_field(const_buffer(bgzf_extra_field));
+    const auto base = _pending.size();
+    _pending.resize(base + max_block_size);
+    auto res = gz(mutable_buffer(_pending.data() + base, max_block_size),
+                  const_buffer(_block.data(), _block.size()),
+                  flush::finish);
+    if (!res.done) {
+        _pending.resize(base);
+        return false;
+    }
+    _pending.resize(base + res.bytes_written);
+    // Fill in BSIZE, which is one less than the size of the block
+    const auto bsize                       = res.bytes_written - 1;
+    _pending[base + bgzf_bsize_offset]     = std::byte(bsize & 0xff);
+    _pending[base + bgzf_bsize_offset + 1] = std::byte(bsize >> 8);
+    _compressed_offset += res.bytes_written;
+    return true;
+}
+
+void bgzf_compressor::_queue_block() {
+    if (!_try_compress(_gzip)) {
+        // The data did not compress well enough to fit. Store it instead.
+        if (!_gzip_stored) {
+            _gzip_stored.emplace(
+                deflate_compressor(deflate_options{.level = 0, .window_bits = 15}));
+        }
+        auto stored_ok = _try_compress(*_gzip_stored);
+        neo_assert_always(invariant,
+                          stored_ok,
+                          "A stored BGZF block did not fit in the maximum block size",
+                          _block.size());
+    }
+    _uncompressed_offset += _block.size();
+    _index.add({_compressed_offset, _uncompressed_offset});
+    _block.clear();
+}
+
+compress_result bgzf_compressor::operator()(mutable_buffer out, const_buffer in, flush f) {
+    neo_assert(expects, !_done, "Application reused bgzf_compressor without calling .reset()");
+
+    const auto in_size  = in.size();
+    const auto out_size = out.size();
+
+    while (true) {
+        // Write out any pending compressed blocks
+        auto n_copied
+            = buffer_copy(out, const_buffer(_pending.data(), _pending.size()) + _pending_pos);
+        out += n_copied;
+        _pending_pos += n_copied;
+        if (_pending_pos != _pending.size()) {
+            // The output is full
+            break;
+        }
+        _pending.clear();
+        _pending_pos = 0;
+
+        if (!in.empty()) {
+            const auto n_take = std::min(in.size(), max_block_input - _block.size());
+            _block.insert(_block.end(), in.data(), in.data() + n_take);
+            in += n_take;
+            if (_block.size() == max_block_input) {
+                _queue_block();
+            }
+            continue;
+        }
+        // We've consumed all of the input
+        if (f == flush::no_flush) {
+            break;
+        }
+        if (!_block.empty()) {
+            // Any flush ends the current block
+            _queue_block();
+            continue;
+        }
+        if (f == flush::finish) {
+            if (!_eof_queued) {
+                _pending.insert(_pending.end(),
+                                std::begin(bgzf_eof_block),
+                                std::end(bgzf_eof_block));
+                _compressed_offset += sizeof bgzf_eof_block;
+                _eof_queued = true;
+                continue;
+            }
+            _done = true;
+        }
+        break;
+    }
+
+    return {
+        .bytes_written = out_size - out.size(),
+        .bytes_read    = in_size - in.size(),
+        .done          = _done,
+    };
+}
+
+bgzf_source::bgzf_source(std::istream& in)
+    : _in(&in) {}
+
+bgzf_source::bgzf_source(std::istream& in, bgzf_index idx)
+    : _in(&in)
+    , _index(std::move(idx)) {}
+
+bool bgzf_source::_read_block() {
+    while (true) {
+        if (!read_bgzf_block(*_in, _cblock)) {
+            return false;
+        }
+        const auto isize = load_le32(_cblock.data() + _cblock.size() - 4);
+        if (isize > bgzf_max_isize) {
+            // Don't trust a corrupted size with an allocation
+            throw std::runtime_error("Malformed BGZF block");
+        }
+        _block_uoffset += _block.size();
+        _block.resize(isize);
+        _pos = 0;
+        if (isize == 0) {
+            // An empty block, such as the end-of-file marker
+            continue;
+        }
+
+        _decomp.reset();
+        auto res = _decomp(mutable_buffer(_block.data(), _block.size()),
+                           const_buffer(_cblock.data(), _cblock.size()));
+        if (!res.done || res.bytes_read != _cblock.size() || res.bytes_written != isize) {
+            throw std::runtime_error("Malformed BGZF block");
+        }
+        return true;
+    }
+}
+
+const_buffer bgzf_source::next(std::size_t n) {
+    if (_pos == _block.size() && !_read_block()) {
+        return {};
+    }
+    return const_buffer(_block.data() + _pos, std::min(n, _block.size() - _pos));
+}
+
+void bgzf_source::consume(std::size_t n) noexcept {
+    neo_assert(expects,
+               n <= _block.size() - _pos,
+               "Consumed more bytes than were available from the bgzf_source",
+               n,
+               _block.size() - _pos);
+    _pos += n;
+}
+
+void bgzf_source::seek(std::uint64_t uncompressed_offset) {
+    if (!_index) {
+        _in->clear();
+        _in->seekg(0);
+        _index = bgzf_index::build(*_in);
+    }
+    const auto start = _index->find(uncompressed_offset);
+    _in->clear();
+    _in->seekg(static_cast<std::streamoff>(start.compressed_offset));
+    if (!*_in) {
+        throw std::runtime_error("Failed to seek in BGZF stream");
+    }
+    _block_uoffset = start.uncompressed_offset;
+    _block.clear();
+    _pos = 0;
+    // Skip blocks until we reach the one that contains the offset
+    while (_block_uoffset + _block.size() <= uncompressed_offset) {
+        if (!_read_block()) {
+            // Seeking to (or past) the end
+            _block_uoffset += _block.size();
+            _block.clear();
+            _pos = 0;
+            return;
+        }
+    }
+    _pos = static_cast<std::size_t>(uncompressed_offset - _block_uoffset);
+}
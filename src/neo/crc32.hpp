@@ -1,12 +1,66 @@
 #pragma once
 
 #include <neo/buffer_range.hpp>
+#include <neo/buffers_consumer.hpp>
 #include <neo/bytewise_iterator.hpp>
+#include <neo/const_buffer.hpp>
 
 #include <cstddef>
+#include <cstdint>
+#include <type_traits>
 
 namespace neo {
 
+namespace detail {
+
+/**
+ * Update a CRC-32 register with the given bytes, using the fastest method
+ * available on the running processor. The register is the bitwise inverse of
+ * the CRC value.
+ */
+std::uint32_t crc32_update(std::uint32_t crc, const std::byte* data, std::size_t size) noexcept;
+
+/**
+ * Multiply two polynomials modulo the CRC-32 polynomial. The operands and the
+ * result use the bit-reflected representation of the CRC.
+ */
+constexpr std::uint32_t crc32_multmodp(std::uint32_t a, std::uint32_t b) noexcept {
+    std::uint32_t m = std::uint32_t(1) << 31;
+    std::uint32_t p = 0;
+    while (true) {
+        if (a & m) {
+            p ^= b;
+            if ((a & (m - 1)) == 0) {
+                break;
+            }
+        }
+        m >>= 1;
+        b = (b & 1) ? (b >> 1) ^ 0xedb88320 : (b >> 1);
+    }
+    return p;
+}
+
+/**
+ * Compute x^(8n) modulo the CRC-32 polynomial: The operator that appends `n`
+ * zero bytes to a CRC.
+ */
+constexpr std::uint32_t crc32_x8nmodp(std::uint64_t n) noexcept {
+    // x^(2^k) mod P, starting with x^8 (one byte)
+    std::uint32_t x2k = std::uint32_t(1) << 23;
+    // x^0 == 1
+    std::uint32_t p = std::uint32_t(1) << 31;
+    while (n) {
+        if (n & 1) {
+            p = crc32_multmodp(x2k, p);
+        }
+        n >>= 1;
+        x2k = crc32_multmodp(x2k, x2k);
+    }
+    return p;
+}
+
+}  // namespace detail
+
 class crc32 {
     static constexpr std::uint32_t _crc_table[256] = {
         0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419, 0x706af48f, 0xe963a535,
@@ -50,12 +104,27 @@ class crc32 {
 
     std::uint32_t _crc_val = 0xff'ff'ff'ff;
 
+    /// Process each contiguous buffer in bulk
+    template <buffer_range Buffers>
+    void _feed_bulk(const Buffers& bufs) noexcept {
+        buffers_consumer in{bufs};
+        while (!in.empty()) {
+            auto part = in.next_contiguous();
+            _crc_val  = detail::crc32_update(_crc_val, part.data(), part.size());
+            in.consume(part.size());
+        }
+    }
+
 public:
     template <buffer_range Buffers>
     constexpr void feed(const Buffers& bufs) noexcept {
-        for (std::byte byte : bytewise_iterator{bufs}) {
-            auto index = (_crc_val ^ std::uint32_t(byte)) & 0xff;
-            _crc_val   = (_crc_val >> 8) ^ _crc_table[index];
+        if (std::is_constant_evaluated()) {
+            for (std::byte byte : bytewise_iterator{bufs}) {
+                auto index = (_crc_val ^ std::uint32_t(byte)) & 0xff;
+                _crc_val   = (_crc_val >> 8) ^ _crc_table[index];
+            }
+        } else {
+            _feed_bulk(bufs);
         }
     }
 
@@ -67,6 +136,28 @@ public:
         c.feed(bufs);
         return c.value();
     }
+
+    /**
+     * Given the CRC-32 of two sequences of bytes A and B, compute the CRC-32 of
+     * the concatenation of A and B, without access to the bytes themselves.
+     *
+     * @param crc_a The CRC-32 of the first sequence
+     * @param crc_b The CRC-32 of the second sequence
+     * @param len_b The length of the second sequence
+     */
+    static constexpr std::uint32_t
+    combine(std::uint32_t crc_a, std::uint32_t crc_b, std::uint64_t len_b) noexcept {
+        return detail::crc32_multmodp(detail::crc32_x8nmodp(len_b), crc_a) ^ crc_b;
+    }
+
+    /**
+     * Calculate the CRC-32 of a large buffer by checksumming slices of it on
+     * multiple threads and combining the results.
+     *
+     * @param thread_count The number of threads to use. If zero, uses the
+     * number of hardware threads.
+     */
+    static std::uint32_t calc_parallel(const_buffer buf, unsigned thread_count = 0);
 };
 
 }  // namespace neo
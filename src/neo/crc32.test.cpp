@@ -6,3 +6,43 @@ TEST_CASE("CRC-32 some data") {
     CHECK(neo::crc32::calc(neo::const_buffer("The quick brown fox jumps over the lazy dog"))
           == 0x414FA339);
 }
+
+TEST_CASE("CRC-32 in bulk matches the bytewise calculation") {
+    std::string data;
+    for (auto i = 0; i < 100'000; ++i) {
+        data.push_back(static_cast<char>((i * 7919) ^ (i >> 3)));
+    }
+    CHECK(neo::crc32::calc(neo::const_buffer("123456789")) == 0xCBF43926);
+
+    for (std::size_t size : {0, 1, 15, 16, 63, 64, 65, 200, 4096, 99'999}) {
+        const auto part = neo::const_buffer(data).first(size);
+        // Feed one byte at a time, which never takes the bulk paths
+        neo::crc32 bytewise;
+        for (auto i = 0u; i < size; ++i) {
+            bytewise.feed(part.first(i + 1) + i);
+        }
+        CHECK(neo::crc32::calc(part) == bytewise.value());
+    }
+}
+
+TEST_CASE("Combine CRC-32 values") {
+    const auto whole = neo::const_buffer("The quick brown fox jumps over the lazy dog");
+    for (std::size_t split : {0, 1, 10, 42, 43}) {
+        const auto head = whole.first(split);
+        const auto tail = whole + split;
+        CHECK(neo::crc32::combine(neo::crc32::calc(head), neo::crc32::calc(tail), tail.size())
+              == 0x414FA339);
+    }
+}
+
+TEST_CASE("CRC-32 a large buffer in parallel") {
+    std::string data;
+    data.resize(1024 * 1024 * 5 + 17);
+    for (auto i = 0u; i < data.size(); ++i) {
+        data[i] = static_cast<char>(i * 31 + (i >> 11));
+    }
+    const auto expect = neo::crc32::calc(neo::const_buffer(data));
+    CHECK(neo::crc32::calc_parallel(neo::const_buffer(data)) == expect);
+    CHECK(neo::crc32::calc_parallel(neo::const_buffer(data), 3) == expect);
+    CHECK(neo::crc32::calc_parallel(neo::const_buffer(data), 1) == expect);
+}
@@ -3,35 +3,140 @@
 #include <zlib.h>
 
 #include <ostream>
+#include <stdexcept>
+#include <utility>
 
 #define MY_Z_STATE (*static_cast<::z_stream*>(_z_stream_ptr))
 
 using namespace neo;
 
-neo::deflate_compressor::deflate_compressor(deflate_compressor::allocator_type alloc) noexcept
-    : compression_base(alloc) {
-    ::deflateInit2(&MY_Z_STATE, 5, Z_DEFLATED, -12, 8, Z_DEFAULT_STRATEGY);
+namespace {
+
+int zlib_flush_mode(neo::flush f) noexcept {
+    switch (f) {
+    case flush::no_flush:
+        return Z_NO_FLUSH;
+    case flush::partial:
+        return Z_PARTIAL_FLUSH;
+    case flush::sync:
+        return Z_SYNC_FLUSH;
+    case flush::full:
+        return Z_FULL_FLUSH;
+    case flush::finish:
+        return Z_FINISH;
+    case flush::block:
+        return Z_BLOCK;
+    }
+    neo_assert_always(expects, false, "Invalid flush mode given to deflate_compressor", int(f));
+    return Z_NO_FLUSH;
+}
+
+void check_options(const deflate_options& opts) {
+    neo_assert(expects,
+               opts.level >= Z_DEFAULT_COMPRESSION && opts.level <= 9,
+               "Invalid deflate compression level",
+               opts.level);
+    neo_assert(expects,
+               opts.window_bits >= 9 && opts.window_bits <= 15,
+               "Invalid deflate window size",
+               opts.window_bits);
+    neo_assert(expects,
+               opts.mem_level >= 1 && opts.mem_level <= 9,
+               "Invalid deflate memory level",
+               opts.mem_level);
 }
 
-deflate_compressor::~deflate_compressor() {
+}  // namespace
+
+template <stream_stats_policy Stats>
+basic_deflate_compressor<Stats>::basic_deflate_compressor(const deflate_options& opts,
+                                                          allocator_type         alloc) noexcept
+    : compression_base(alloc, Stats::enabled)
+    , _opts(opts) {
+    check_options(opts);
+    // Negative window bits generates a raw DEFLATE stream without a zlib header
+    auto rc = ::deflateInit2(&MY_Z_STATE,
+                             opts.level,
+                             Z_DEFLATED,
+                             -opts.window_bits,
+                             opts.mem_level,
+                             static_cast<int>(opts.strategy));
+    neo_assert_always(invariant,
+                      rc == Z_OK,
+                      "deflateInit2() failed unexpectedly",
+                      rc,
+                      opts.level,
+                      opts.window_bits,
+                      opts.mem_level);
+}
+
+template <stream_stats_policy Stats>
+basic_deflate_compressor<Stats>::~basic_deflate_compressor() {
     if (_z_stream_ptr) {
         ::deflateEnd(&MY_Z_STATE);
     }
 }
 
-void neo::deflate_compressor::reset() noexcept { ::deflateReset(&MY_Z_STATE); }
+template <stream_stats_policy Stats>
+void basic_deflate_compressor<Stats>::reset() noexcept {
+    ::deflateReset(&MY_Z_STATE);
+}
 
-neo::compress_result
-neo::deflate_compressor::operator()(neo::mutable_buffer out, neo::const_buffer in, neo::flush f) {
-    neo::compress_result acc;
+template <stream_stats_policy Stats>
+void basic_deflate_compressor<Stats>::set_dictionary(const_buffer dict) {
+    auto rc = ::deflateSetDictionary(&MY_Z_STATE,
+                                     reinterpret_cast<const ::Bytef*>(dict.data()),
+                                     static_cast<::uInt>(dict.size()));
+    if (rc != Z_OK) {
+        throw std::runtime_error("Failed to set the deflate dictionary");
+    }
+}
+
+template <stream_stats_policy Stats>
+void basic_deflate_compressor<Stats>::set_params(int level, deflate_strategy strategy) {
+    auto new_opts     = options();
+    new_opts.level    = level;
+    new_opts.strategy = strategy;
+    check_options(new_opts);
+    _pending_params = new_opts;
+}
 
+template <stream_stats_policy Stats>
+compress_result
+basic_deflate_compressor<Stats>::_compress(mutable_buffer out, const_buffer in, neo::flush f) {
     ::z_stream& strm = MY_Z_STATE;
     strm.next_in     = const_cast<::Byte*>(reinterpret_cast<const ::Byte*>(in.data()));
     strm.avail_in    = static_cast<uInt>(in.size());
     strm.next_out    = reinterpret_cast<::Byte*>(out.data());
     strm.avail_out   = static_cast<uInt>(out.size());
 
-    auto result = ::deflate(&strm, f == flush::finish ? Z_FINISH : Z_NO_FLUSH);
+    if (_pending_params) {
+        // Hide the input from zlib while changing parameters: Only the data given prior to this
+        // call should be compressed with the old parameters.
+        strm.avail_in = 0;
+        auto result   = _stats.timed(&stream_stats::codec_time, [&] {
+            return ::deflateParams(&strm,
+                                   _pending_params->level,
+                                   static_cast<int>(_pending_params->strategy));
+        });
+        strm.avail_in = static_cast<uInt>(in.size());
+        if (result == Z_BUF_ERROR) {
+            // Not enough room to flush the data that was compressed with the old parameters. We'll
+            // try again on the next call.
+            return {.bytes_written = out.size() - strm.avail_out};
+        }
+        neo_assert(invariant,
+                   result == Z_OK,
+                   "deflateParams() failed unexpectedly",
+                   result,
+                   _pending_params->level,
+                   int(_pending_params->strategy));
+        _opts = *std::exchange(_pending_params, std::nullopt);
+    }
+
+    const auto mode = zlib_flush_mode(f);
+    const auto result
+        = _stats.timed(&stream_stats::codec_time, [&] { return ::deflate(&strm, mode); });
     neo_assert(invariant,
                result == Z_OK || result == Z_STREAM_END || result == Z_BUF_ERROR,
                "deflate() failed unexpectedly. ??",
@@ -46,3 +151,6 @@ neo::deflate_compressor::operator()(neo::mutable_buffer out, neo::const_buffer i
         .done          = result == Z_STREAM_END,
     };
 }
+
+template class neo::basic_deflate_compressor<no_stream_stats>;
+template class neo::basic_deflate_compressor<record_stream_stats>;
@@ -7,10 +7,19 @@
 #include <filesystem>
 #include <fstream>
 #include <sstream>
+#include <type_traits>
 
 static const auto ROOT_DIR_PATH
     = std::filesystem::path(__FILE__).append("../../..").lexically_normal();
 
+static_assert(std::is_nothrow_constructible_v<neo::deflate_compressor, neo::deflate_options>,
+              "Constructing a deflate_compressor does not throw");
+
+// deflate_compressor is a class that users may forward-declare
+namespace neo {
+class deflate_compressor;
+}  // namespace neo
+
 TEST_CASE("Compress some data") {
     neo::deflate_compressor c;
 
@@ -106,3 +115,70 @@ TEST_CASE("Big compress") {
     CHECK(defl_res.bytes_read == big_str.size());
     CHECK(defl_res.bytes_written == compressed.storage().size());
 }
+
+TEST_CASE("Compress with custom options") {
+    std::string text;
+    for (auto i = 0; i < 200; ++i) {
+        text += "The quick brown fox jumps over the lazy dog. ";
+    }
+
+    auto compress_with = [&](const neo::deflate_options& opts) {
+        neo::dynbuf_io<std::string> compressed;
+        neo::deflate_compressor     defl{opts};
+        auto                        res = neo::buffer_transform(defl,
+                                         compressed,
+                                         neo::const_buffer(text),
+                                         neo::flush::finish);
+        compressed.shrink_uncommitted();
+        CHECK(res.done);
+        CHECK(res.bytes_read == text.size());
+        return compressed.storage().size();
+    };
+
+    auto default_size = compress_with({});
+    auto best_size    = compress_with({.level = 9, .window_bits = 15, .mem_level = 9});
+    auto huff_size    = compress_with({.strategy = neo::deflate_strategy::huffman_only});
+    CHECK(best_size <= default_size);
+    // Huffman-only cannot take advantage of the repetition
+    CHECK(huff_size > default_size);
+    // -1 selects zlib's default level
+    CHECK(compress_with({.level = -1}) == compress_with({.level = 6}));
+}
+
+TEST_CASE("Change compression parameters mid-stream") {
+    neo::dynbuf_io<std::string> compressed;
+    neo::deflate_compressor     defl{neo::deflate_options{.level = 1}};
+    CHECK(defl.options().level == 1);
+
+    std::string text = "Hello, DEFLATE! Hello, DEFLATE! Hello, DEFLATE!";
+    auto        res  = neo::buffer_transform(defl, compressed, neo::const_buffer(text));
+    defl.set_params(9, neo::deflate_strategy::filtered);
+    CHECK(defl.options().level == 9);
+    res += neo::buffer_transform(defl, compressed, neo::const_buffer(text));
+    defl.set_params(0, neo::deflate_strategy::default_strategy);
+    res += neo::buffer_transform(defl, compressed, neo::const_buffer(text), neo::flush::finish);
+    compressed.shrink_uncommitted();
+    CHECK(res.done);
+    CHECK(res.bytes_read == text.size() * 3);
+    CHECK(res.bytes_written == compressed.storage().size());
+    CHECK(defl.options().level == 0);
+}
+
+TEST_CASE("Sync flush makes all input available") {
+    neo::dynbuf_io<std::string> compressed;
+    neo::deflate_compressor     defl;
+
+    std::string text = "Hello, DEFLATE!";
+    auto        res  = neo::buffer_transform(defl, compressed, neo::const_buffer(text));
+    // Without a flush, the compressor holds on to the data
+    const auto n_unflushed = res.bytes_written;
+    res += neo::buffer_transform(defl, compressed, neo::const_buffer(), neo::flush::sync);
+    CHECK_FALSE(res.done);
+    CHECK(res.bytes_read == text.size());
+    CHECK(res.bytes_written > n_unflushed);
+    compressed.shrink_uncommitted();
+    // A sync flush ends with an empty stored block
+    const auto& str = compressed.storage();
+    REQUIRE(str.size() >= 4);
+    CHECK(str.substr(str.size() - 4) == std::string("\x00\x00\xff\xff", 4));
+}
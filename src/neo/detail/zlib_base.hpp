@@ -10,6 +10,10 @@ class compression_base {
 public:
     using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
 
+private:
+    // The allocation functions given to zlib
+    struct _zalloc_fns;
+
 protected:
     struct _zstream_proto {
         std::byte*    next_in;
@@ -32,12 +36,24 @@ protected:
 
     void* _z_stream_ptr = nullptr;
 
-    explicit compression_base(allocator_type alloc);
+    // Only updated if allocations are tracked
+    std::size_t _bytes_allocated      = 0;
+    std::size_t _peak_bytes_allocated = 0;
+
+    /**
+     * If `track_allocations` is true, the bytes that zlib holds through the
+     * allocator are counted for peak_bytes_allocated(). Otherwise, the
+     * allocation functions given to zlib do no counting at all.
+     */
+    explicit compression_base(allocator_type alloc, bool track_allocations = false);
     compression_base(compression_base&&) noexcept;
     ~compression_base();
 
 public:
     allocator_type get_allocator() const noexcept { return _alloc; }
+
+    /// The most bytes held at once by the codec's state, if allocations are tracked
+    std::size_t peak_bytes_allocated() const noexcept { return _peak_bytes_allocated; }
 };
 
 }  // namespace neo::detail
\ No newline at end of file
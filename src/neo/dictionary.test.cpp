@@ -0,0 +1,133 @@
+#include <neo/dictionary.hpp>
+
+#include <neo/deflate.hpp>
+#include <neo/fast_inflate.hpp>
+#include <neo/gzip.hpp>
+#include <neo/inflate.hpp>
+
+#include <neo/buffer_algorithm/transform.hpp>
+#include <neo/dynbuf_io.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <random>
+
+namespace {
+
+std::string make_message(std::mt19937& rng) {
+    return R"({"type":"order_update","order_id":)" + std::to_string(rng() % 100000)
+        + R"(,"status":")" + (rng() % 2 ? "shipped" : "pending")
+        + R"(","customer":{"name":"user)" + std::to_string(rng() % 500)
+        + R"(","country":"US"},"items":[{"sku":"SKU-)" + std::to_string(rng() % 50)
+        + R"(","quantity":)" + std::to_string(rng() % 9) + "}]}";
+}
+
+std::vector<std::string> make_samples(std::mt19937& rng) {
+    std::vector<std::string> samples;
+    for (auto i = 0; i < 3000; ++i) {
+        samples.push_back(make_message(rng));
+    }
+    return samples;
+}
+
+template <typename Algo>
+std::string transform_str(Algo& algo, const std::string& in) {
+    neo::dynbuf_io<std::string> out;
+    neo::buffer_transform(algo, out, neo::const_buffer(in), neo::flush::finish);
+    out.shrink_uncommitted();
+    return std::move(out.storage());
+}
+
+template <typename Algo>
+std::string decompress_str(Algo& algo, const std::string& in) {
+    neo::dynbuf_io<std::string> out;
+    neo::buffer_transform(algo, out, neo::const_buffer(in));
+    out.shrink_uncommitted();
+    return std::move(out.storage());
+}
+
+}  // namespace
+
+TEST_CASE("Train a dictionary") {
+    std::mt19937 rng{42};
+    const auto   samples = make_samples(rng);
+
+    auto dict = neo::train_dictionary(samples);
+    CHECK(dict.size() == 1024 * 32);
+
+    dict = neo::train_dictionary(samples, neo::dictionary_training_options{.max_size = 1000});
+    CHECK(dict.size() <= 1000);
+    CHECK_FALSE(dict.empty());
+
+    // Samples that fit in the dictionary are used as-is
+    dict = neo::train_dictionary(std::vector<std::string>{"abc", "def"});
+    CHECK(dict.size() == 6);
+
+    // A dictionary smaller than a segment is a single, shorter segment
+    dict = neo::train_dictionary(samples, neo::dictionary_training_options{.max_size = 40});
+    CHECK(dict.size() == 40);
+    // There is no room for a single match
+    dict = neo::train_dictionary(samples, neo::dictionary_training_options{.max_size = 4});
+    CHECK(dict.empty());
+}
+
+TEST_CASE("Compress small messages with a preset dictionary") {
+    std::mt19937 rng{42};
+    const auto   dict    = neo::train_dictionary(make_samples(rng));
+    const auto   dict_cb = neo::const_buffer(dict.data(), dict.size());
+
+    std::size_t plain_size = 0;
+    std::size_t dict_size  = 0;
+    for (auto i = 0; i < 50; ++i) {
+        const auto msg = make_message(rng);
+
+        neo::deflate_compressor plain_defl;
+        plain_size += transform_str(plain_defl, msg).size();
+
+        neo::deflate_compressor defl;
+        defl.set_dictionary(dict_cb);
+        const auto compressed = transform_str(defl, msg);
+        dict_size += compressed.size();
+
+        neo::inflate_decompressor infl;
+        infl.set_dictionary(dict_cb);
+        CHECK(decompress_str(infl, compressed) == msg);
+
+        neo::fast_inflate_decompressor fast_infl;
+        fast_infl.set_dictionary(dict_cb);
+        CHECK(decompress_str(fast_infl, compressed) == msg);
+    }
+    CHECK(dict_size * 2 < plain_size);
+}
+
+TEST_CASE("Carry the dictionary ID in gzip data") {
+    std::mt19937 rng{42};
+    const auto   dict    = neo::train_dictionary(make_samples(rng));
+    const auto   dict_cb = neo::const_buffer(dict.data(), dict.size());
+    const auto   msg     = make_message(rng);
+
+    neo::gzip_compressor<neo::deflate_compressor> comp;
+    comp.set_dictionary(dict_cb);
+    const auto gzipped = transform_str(comp, msg);
+
+    // The dictionary is applied again after a reset
+    comp.reset();
+    CHECK(transform_str(comp, msg) == gzipped);
+
+    neo::gzip_decompressor<neo::inflate_decompressor> decomp;
+    decomp.set_dictionary(dict_cb);
+    CHECK(decompress_str(decomp, gzipped) == msg);
+
+    neo::gzip_decompressor<neo::fast_inflate_decompressor> fast_decomp;
+    fast_decomp.set_dictionary(dict_cb);
+    CHECK(decompress_str(fast_decomp, gzipped) == msg);
+
+    // Without the dictionary, or with a different one, the data is rejected
+    neo::gzip_decompressor<neo::inflate_decompressor> no_dict;
+    CHECK_THROWS(decompress_str(no_dict, gzipped));
+
+    const auto other = neo::train_dictionary(std::vector<std::string>{msg});
+    neo::gzip_decompressor<neo::inflate_decompressor> wrong_dict;
+    wrong_dict.set_dictionary(neo::const_buffer(other.data(), other.size()));
+    CHECK_THROWS(decompress_str(wrong_dict, gzipped));
+}
@@ -0,0 +1,850 @@
+#include "./fast_inflate.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace neo;
+
+namespace {
+
+/// DEFLATE permits matches to reach back this far into the output
+constexpr std::size_t window_size = 32 * 1024;
+
+/// The longest match that DEFLATE can encode
+constexpr std::size_t max_match_length = 258;
+
+/**
+ * The fast loop refills the bit buffer by loading eight bytes at once, and may
+ * write up to seven bytes past the end of a match.
+ */
+constexpr std::size_t fast_in_margin  = 8;
+constexpr std::size_t fast_out_margin = max_match_length + 8;
+
+/**
+ * The largest number of bits needed to decode a single item: A length code
+ * with its extra bits, followed by a distance code with its extra bits.
+ */
+constexpr unsigned max_item_bits = 15 + 5 + 15 + 13;
+
+constexpr unsigned litlen_table_bits  = 10;
+constexpr unsigned dist_table_bits    = 8;
+constexpr unsigned precode_table_bits = 7;
+
+constexpr std::uint16_t length_base[] = {3,  4,  5,  6,  7,  8,  9,  10,  11,  13,
+                                         15, 17, 19, 23, 27, 31, 35, 43,  51,  59,
+                                         67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr std::uint8_t  length_extra[]
+    = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+
+constexpr std::uint16_t dist_base[]  = {1,    2,    3,    4,    5,    7,     9,     13,
+                                       17,   25,   33,   49,   65,   97,    129,   193,
+                                       257,  385,  513,  769,  1025, 1537,  2049,  3073,
+                                       4097, 6145, 8193, 12289, 16385, 24577};
+constexpr std::uint8_t  dist_extra[] = {0, 0, 0, 0, 1, 1, 2,  2,  3,  3,  4,  4,  5,  5,  6,
+                                       6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+/// The order in which the code lengths of the precode are stored
+constexpr std::uint8_t precode_order[]
+    = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+[[noreturn]] void throw_corrupt(const char* what) {
+    throw std::runtime_error(std::string("Data inflate failed. Corrupted? (") + what + ")");
+}
+
+enum class entry_kind : std::uint8_t {
+    /// An invalid code. `length` is the number of bits needed to be sure of that.
+    invalid,
+    /// A literal byte, or a precode symbol. `value` is the byte/symbol
+    literal,
+    /// A length or distance. `value` is the base, followed by `extra` extra bits
+    match,
+    /// The end of the block
+    end_of_block,
+    /// A pointer to a subtable at `value`, indexed by the next `extra` bits
+    subtable,
+};
+
+struct table_entry {
+    std::uint16_t value  = 0;
+    std::uint8_t  length = 0;
+    entry_kind    kind   = entry_kind::invalid;
+    std::uint8_t  extra  = 0;
+};
+
+using decode_table = std::vector<table_entry>;
+
+enum class code_type { precode, litlen, dist };
+
+table_entry entry_for_symbol(code_type type, unsigned sym) noexcept {
+    switch (type) {
+    case code_type::precode:
+        return {.value = std::uint16_t(sym), .kind = entry_kind::literal};
+    case code_type::litlen:
+        if (sym < 256) {
+            return {.value = std::uint16_t(sym), .kind = entry_kind::literal};
+        } else if (sym == 256) {
+            return {.kind = entry_kind::end_of_block};
+        } else if (sym < 286) {
+            return {.value = length_base[sym - 257],
+                    .kind  = entry_kind::match,
+                    .extra = length_extra[sym - 257]};
+        }
+        return {};
+    case code_type::dist:
+        if (sym < 30) {
+            return {.value = dist_base[sym], .kind = entry_kind::match, .extra = dist_extra[sym]};
+        }
+        return {};
+    }
+    return {};
+}
+
+/**
+ * Build a lookup table for the canonical Huffman code with the given code
+ * lengths. The main table is indexed by the next `table_bits` bits of input.
+ * Codes longer than that are resolved by a second lookup in a subtable that is
+ * just large enough for the longest code sharing its prefix.
+ */
+void build_decode_table(decode_table&       table,
+                        const std::uint8_t* lengths,
+                        unsigned            n_symbols,
+                        unsigned            table_bits,
+                        code_type           type) {
+    std::array<unsigned, 16> count = {};
+    for (auto i = 0u; i < n_symbols; ++i) {
+        ++count[lengths[i]];
+    }
+    count[0] = 0;
+
+    int  left    = 1;
+    auto n_codes = 0u;
+    for (auto len = 1u; len < 16; ++len) {
+        left = (left << 1) - int(count[len]);
+        n_codes += count[len];
+        if (left < 0) {
+            throw_corrupt("Over-subscribed Huffman code");
+        }
+    }
+    // As with zlib, the only incomplete codes permitted are a single code of length one, and an
+    // empty code (a block with no distance codes)
+    const bool single_short_code = n_codes == 1 && count[1] == 1;
+    if (left > 0 && (type == code_type::precode || (n_codes != 0 && !single_short_code))) {
+        throw_corrupt("Incomplete Huffman code");
+    }
+
+    std::array<unsigned, 16> next_code = {};
+    for (auto len = 1u; len < 16; ++len) {
+        next_code[len] = (next_code[len - 1] + count[len - 1]) << 1;
+    }
+
+    const auto main_size = 1u << table_bits;
+    // Codes are stored most-significant-bit first, but read from the bit buffer from the bottom
+    std::array<std::uint16_t, 288> reversed;
+    std::array<std::uint8_t, 1u << 11> sub_bits = {};
+    for (auto sym = 0u; sym < n_symbols; ++sym) {
+        const auto len = lengths[sym];
+        if (len == 0) {
+            continue;
+        }
+        auto code = next_code[len]++;
+        auto rev  = 0u;
+        for (auto i = 0u; i < len; ++i) {
+            rev  = (rev << 1) | (code & 1);
+            code >>= 1;
+        }
+        reversed[sym] = std::uint16_t(rev);
+        if (len > table_bits) {
+            auto& sb = sub_bits[rev & (main_size - 1)];
+            sb       = std::max(sb, std::uint8_t(len - table_bits));
+        }
+    }
+
+    auto total_size = main_size;
+    for (auto i = 0u; i < main_size; ++i) {
+        if (sub_bits[i]) {
+            total_size += 1u << sub_bits[i];
+        }
+    }
+    table.assign(total_size, table_entry{.length = std::uint8_t(table_bits)});
+    auto next_sub = main_size;
+    for (auto i = 0u; i < main_size; ++i) {
+        if (sub_bits[i]) {
+            table[i] = {.value  = std::uint16_t(next_sub),
+                        .length = std::uint8_t(table_bits),
+                        .kind   = entry_kind::subtable,
+                        .extra  = sub_bits[i]};
+            // Slots of the subtable that are never filled need all of its bits to be identified
+            std::fill_n(table.begin() + next_sub,
+                        1u << sub_bits[i],
+                        table_entry{.length = sub_bits[i]});
+            next_sub += 1u << sub_bits[i];
+        }
+    }
+
+    for (auto sym = 0u; sym < n_symbols; ++sym) {
+        const auto len = lengths[sym];
+        if (len == 0) {
+            continue;
+        }
+        auto       entry = entry_for_symbol(type, sym);
+        const auto rev   = reversed[sym];
+        if (len <= table_bits) {
+            entry.length = len;
+            for (auto i = unsigned(rev); i < main_size; i += 1u << len) {
+                table[i] = entry;
+            }
+        } else {
+            const auto& sub      = table[rev & (main_size - 1)];
+            const auto  sub_size = 1u << sub.extra;
+            const auto  sub_len  = len - table_bits;
+            entry.length         = std::uint8_t(sub_len);
+            for (auto i = unsigned(rev) >> table_bits; i < sub_size; i += 1u << sub_len) {
+                table[sub.value + i] = entry;
+            }
+        }
+    }
+}
+
+struct fixed_tables {
+    decode_table litlen;
+    decode_table dist;
+
+    fixed_tables() {
+        std::array<std::uint8_t, 288> lit_lengths;
+        std::fill_n(lit_lengths.begin(), 144, std::uint8_t(8));
+        std::fill_n(lit_lengths.begin() + 144, 112, std::uint8_t(9));
+        std::fill_n(lit_lengths.begin() + 256, 24, std::uint8_t(7));
+        std::fill_n(lit_lengths.begin() + 280, 8, std::uint8_t(8));
+        build_decode_table(litlen, lit_lengths.data(), 288, litlen_table_bits, code_type::litlen);
+
+        std::array<std::uint8_t, 32> dist_lengths;
+        dist_lengths.fill(5);
+        build_decode_table(dist, dist_lengths.data(), 32, dist_table_bits, code_type::dist);
+    }
+};
+
+const fixed_tables& get_fixed_tables() {
+    static const fixed_tables tables;
+    return tables;
+}
+
+std::uint64_t load_le64(const std::byte* p) noexcept {
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof v);
+    if constexpr (std::endian::native == std::endian::big) {
+        v = ((v & 0x00000000ffffffffull) << 32) | ((v & 0xffffffff00000000ull) >> 32);
+        v = ((v & 0x0000ffff0000ffffull) << 16) | ((v & 0xffff0000ffff0000ull) >> 16);
+        v = ((v & 0x00ff00ff00ff00ffull) << 8) | ((v & 0xff00ff00ff00ff00ull) >> 8);
+    }
+    return v;
+}
+
+}  // namespace
+
+struct fast_inflate_decompressor::state {
+    enum class decode_step {
+        block_header,
+        stored_header,
+        stored_copy,
+        dynamic_header,
+        precode_lengths,
+        code_lengths,
+        codes,
+        done,
+    };
+
+    /// Why a decoding step returned
+    enum class progress {
+        /// The step is complete. Continue with the next one
+        advanced,
+        need_input,
+        output_full,
+    };
+
+    /// The input and output of a single call
+    struct cursor {
+        const std::byte* in_begin;
+        const std::byte* ip;
+        const std::byte* in_end;
+        std::byte*       out_begin;
+        std::byte*       op;
+        std::byte*       out_end;
+    };
+
+    decode_step step        = decode_step::block_header;
+    bool        final_block = false;
+
+    /**
+     * Input bits that have been read but not decoded, from the bottom up.
+     * Outside of the fast loop, all bits above `bit_count` are zero.
+     */
+    std::uint64_t bit_buf   = 0;
+    unsigned      bit_count = 0;
+
+    // The dynamic block header being read
+    unsigned                          n_litlen   = 0;
+    unsigned                          n_dist     = 0;
+    unsigned                          n_precode  = 0;
+    unsigned                          n_read     = 0;
+    std::array<std::uint8_t, 19>      precode_lengths{};
+    std::array<std::uint8_t, 286 + 30> code_lengths{};
+
+    decode_table        precode_table;
+    decode_table        dyn_litlen_table;
+    decode_table        dyn_dist_table;
+    const table_entry*  litlen = nullptr;
+    const table_entry*  dist   = nullptr;
+
+    // The bytes remaining in the current stored block
+    std::size_t stored_remaining = 0;
+
+    // A match that did not fit in the previous output
+    std::size_t match_remaining = 0;
+    std::size_t match_dist      = 0;
+
+    // The most recent output, as a ring buffer
+    std::array<std::byte, window_size> window;
+    std::size_t                        window_pos  = 0;
+    std::size_t                        window_fill = 0;
+
+    void reset() noexcept {
+        step             = decode_step::block_header;
+        final_block      = false;
+        bit_buf          = 0;
+        bit_count        = 0;
+        stored_remaining = 0;
+        match_remaining  = 0;
+        match_dist       = 0;
+        window_pos       = 0;
+        window_fill      = 0;
+    }
+
+    /// Load bytes from the input until there are at least `n` bits available
+    bool pull(cursor& c, unsigned n) noexcept {
+        while (bit_count < n && c.ip != c.in_end) {
+            bit_buf |= std::uint64_t(*c.ip++) << bit_count;
+            bit_count += 8;
+        }
+        return bit_count >= n;
+    }
+
+    unsigned peek(unsigned at, unsigned n) const noexcept {
+        return unsigned(bit_buf >> at) & ((1u << n) - 1);
+    }
+
+    void drop(unsigned n) noexcept {
+        bit_buf >>= n;
+        bit_count -= n;
+    }
+
+    std::size_t history(const cursor& c) const noexcept {
+        return window_fill + static_cast<std::size_t>(c.op - c.out_begin);
+    }
+
+    /**
+     * Copy as much of a match as will fit in the output, reading from the
+     * window if the match reaches back before this call's output.
+     */
+    std::size_t copy_match(cursor& c, std::size_t len, std::size_t distance) noexcept {
+        const auto n         = std::min(len, static_cast<std::size_t>(c.out_end - c.op));
+        auto       remaining = n;
+        while (remaining) {
+            const auto produced = static_cast<std::size_t>(c.op - c.out_begin);
+            std::size_t chunk;
+            if (distance > produced) {
+                const auto back = distance - produced;
+                const auto src  = (window_pos + window_size - back) % window_size;
+                chunk           = std::min({remaining, back, window_size - src});
+                std::memcpy(c.op, window.data() + src, chunk);
+            } else if (distance >= remaining) {
+                chunk = remaining;
+                std::memcpy(c.op, c.op - distance, chunk);
+            } else {
+                // The match overlaps its own output
+                chunk    = remaining;
+                auto src = c.op - distance;
+                for (std::size_t i = 0; i < chunk; ++i) {
+                    c.op[i] = src[i];
+                }
+            }
+            c.op += chunk;
+            remaining -= chunk;
+        }
+        return n;
+    }
+
+    /// Replace the window with the last bytes of `dict`
+    void set_window(const_buffer dict) noexcept {
+        if (dict.size() > window_size) {
+            dict += dict.size() - window_size;
+        }
+        if (!dict.empty()) {
+            std::memcpy(window.data(), dict.data(), dict.size());
+        }
+        window_pos  = dict.size() % window_size;
+        window_fill = dict.size();
+    }
+
+    /// Append the output of a call to the window
+    void update_window(const cursor& c) noexcept {
+        const auto produced = static_cast<std::size_t>(c.op - c.out_begin);
+        if (produced == 0) {
+            return;
+        }
+        if (produced >= window_size) {
+            std::memcpy(window.data(), c.op - window_size, window_size);
+            window_pos  = 0;
+            window_fill = window_size;
+            return;
+        }
+        const auto first = std::min(produced, window_size - window_pos);
+        std::memcpy(window.data() + window_pos, c.out_begin, first);
+        std::memcpy(window.data(), c.out_begin + first, produced - first);
+        window_pos  = (window_pos + produced) % window_size;
+        window_fill = std::min(window_size, window_fill + produced);
+    }
+
+    progress read_block_header(cursor& c) {
+        if (!pull(c, 3)) {
+            return progress::need_input;
+        }
+        final_block     = peek(0, 1);
+        const auto type = peek(1, 2);
+        drop(3);
+        switch (type) {
+        case 0:
+            step = decode_step::stored_header;
+            break;
+        case 1: {
+            auto& fixed = get_fixed_tables();
+            litlen      = fixed.litlen.data();
+            dist        = fixed.dist.data();
+            step        = decode_step::codes;
+            break;
+        }
+        case 2:
+            step = decode_step::dynamic_header;
+            break;
+        default:
+            throw_corrupt("Invalid block type");
+        }
+        return progress::advanced;
+    }
+
+    progress read_stored_header(cursor& c) {
+        // Stored blocks begin on a byte boundary
+        drop(bit_count % 8);
+        if (!pull(c, 32)) {
+            return progress::need_input;
+        }
+        const auto len  = peek(0, 16);
+        const auto nlen = peek(16, 16);
+        if (len != (~nlen & 0xffff)) {
+            throw_corrupt("Invalid stored block length");
+        }
+        drop(32);
+        stored_remaining = len;
+        step             = decode_step::stored_copy;
+        return progress::advanced;
+    }
+
+    progress copy_stored(cursor& c) noexcept {
+        // Bytes may already have been loaded into the bit buffer
+        while (stored_remaining && bit_count >= 8 && c.op != c.out_end) {
+            *c.op++ = std::byte(bit_buf & 0xff);
+            drop(8);
+            --stored_remaining;
+        }
+        const auto n = std::min({stored_remaining,
+                                 static_cast<std::size_t>(c.out_end - c.op),
+                                 static_cast<std::size_t>(c.in_end - c.ip)});
+        if (n) {
+            std::memcpy(c.op, c.ip, n);
+        }
+        c.op += n;
+        c.ip += n;
+        stored_remaining -= n;
+        if (stored_remaining == 0) {
+            step = final_block ? decode_step::done : decode_step::block_header;
+            return progress::advanced;
+        }
+        return c.op == c.out_end ? progress::output_full : progress::need_input;
+    }
+
+    progress read_dynamic_header(cursor& c) {
+        if (!pull(c, 14)) {
+            return progress::need_input;
+        }
+        n_litlen  = peek(0, 5) + 257;
+        n_dist    = peek(5, 5) + 1;
+        n_precode = peek(10, 4) + 4;
+        drop(14);
+        if (n_litlen > 286 || n_dist > 30) {
+            throw_corrupt("Too many length or distance symbols");
+        }
+        precode_lengths.fill(0);
+        n_read = 0;
+        step   = decode_step::precode_lengths;
+        return progress::advanced;
+    }
+
+    progress read_precode_lengths(cursor& c) {
+        while (n_read < n_precode) {
+            if (!pull(c, 3)) {
+                return progress::need_input;
+            }
+            precode_lengths[precode_order[n_read++]] = std::uint8_t(peek(0, 3));
+            drop(3);
+        }
+        build_decode_table(precode_table,
+                           precode_lengths.data(),
+                           19,
+                           precode_table_bits,
+                           code_type::precode);
+        n_read = 0;
+        step   = decode_step::code_lengths;
+        return progress::advanced;
+    }
+
+    progress read_code_lengths(cursor& c) {
+        const auto n_total = n_litlen + n_dist;
+        while (n_read < n_total) {
+            // A precode symbol is at most seven bits, followed by at most seven extra bits
+            pull(c, 14);
+            const auto e = precode_table[peek(0, precode_table_bits)];
+            if (e.length > bit_count) {
+                return progress::need_input;
+            }
+            if (e.kind == entry_kind::invalid) {
+                throw_corrupt("Invalid code lengths");
+            }
+            if (e.value < 16) {
+                code_lengths[n_read++] = std::uint8_t(e.value);
+                drop(e.length);
+                continue;
+            }
+            std::uint8_t rep_value = 0;
+            unsigned     n_extra;
+            unsigned     rep_base;
+            if (e.value == 16) {
+                if (n_read == 0) {
+                    throw_corrupt("Repeated code length with no previous length");
+                }
+                rep_value = code_lengths[n_read - 1];
+                n_extra   = 2;
+                rep_base  = 3;
+            } else if (e.value == 17) {
+                n_extra  = 3;
+                rep_base = 3;
+            } else {
+                n_extra  = 7;
+                rep_base = 11;
+            }
+            if (e.length + n_extra > bit_count) {
+                return progress::need_input;
+            }
+            const auto rep = rep_base + peek(e.length, n_extra);
+            drop(e.length + n_extra);
+            if (n_read + rep > n_total) {
+                throw_corrupt("Too many code lengths");
+            }
+            std::fill_n(code_lengths.begin() + n_read, rep, rep_value);
+            n_read += rep;
+        }
+        if (code_lengths[256] == 0) {
+            throw_corrupt("Missing end-of-block code");
+        }
+        build_decode_table(dyn_litlen_table,
+                           code_lengths.data(),
+                           n_litlen,
+                           litlen_table_bits,
+                           code_type::litlen);
+        build_decode_table(dyn_dist_table,
+                           code_lengths.data() + n_litlen,
+                           n_dist,
+                           dist_table_bits,
+                           code_type::dist);
+        litlen = dyn_litlen_table.data();
+        dist   = dyn_dist_table.data();
+        step   = decode_step::codes;
+        return progress::advanced;
+    }
+
+    /**
+     * Decode symbols while there is plenty of input and output space. Returns
+     * `true` if the end of the block was reached.
+     */
+    bool decode_fast(cursor& c) {
+        constexpr auto litlen_mask = (1u << litlen_table_bits) - 1;
+        constexpr auto dist_mask   = (1u << dist_table_bits) - 1;
+
+        auto ip        = c.ip;
+        auto op        = c.op;
+        auto bit_buf   = this->bit_buf;
+        auto bit_count = this->bit_count;
+        auto consume   = [&](unsigned n) {
+            bit_buf >>= n;
+            bit_count -= n;
+        };
+        auto bits = [&](unsigned n) { return unsigned(bit_buf) & ((1u << n) - 1); };
+
+        bool block_end = false;
+        while (static_cast<std::size_t>(c.in_end - ip) >= fast_in_margin
+               && static_cast<std::size_t>(c.out_end - op) >= fast_out_margin) {
+            // Top up the bit buffer to at least 56 bits, enough for any single item. The bits
+            // above `bit_count` belong to the next unread byte, so OR-ing it in again is harmless.
+            bit_buf |= load_le64(ip) << bit_count;
+            const auto n_bytes = (63 - bit_count) / 8;
+            ip += n_bytes;
+            bit_count += n_bytes * 8;
+
+            auto e = litlen[bits(litlen_table_bits)];
+            if (e.kind == entry_kind::subtable) {
+                consume(e.length);
+                e = litlen[e.value + bits(e.extra)];
+            }
+            if (e.kind == entry_kind::literal) {
+                consume(e.length);
+                *op++ = std::byte(e.value);
+                // Two more literals from the main table fit in what remains of the buffer
+                e = litlen[bit_buf & litlen_mask];
+                if (e.kind != entry_kind::literal) {
+                    continue;
+                }
+                consume(e.length);
+                *op++ = std::byte(e.value);
+                e     = litlen[bit_buf & litlen_mask];
+                if (e.kind != entry_kind::literal) {
+                    continue;
+                }
+                consume(e.length);
+                *op++ = std::byte(e.value);
+                continue;
+            }
+            if (e.kind == entry_kind::end_of_block) {
+                consume(e.length);
+                block_end = true;
+                break;
+            }
+            if (e.kind != entry_kind::match) {
+                throw_corrupt("Invalid literal/length code");
+            }
+            consume(e.length);
+            const std::size_t len = e.value + bits(e.extra);
+            consume(e.extra);
+
+            auto d = dist[bit_buf & dist_mask];
+            if (d.kind == entry_kind::subtable) {
+                consume(d.length);
+                d = dist[d.value + bits(d.extra)];
+            }
+            if (d.kind != entry_kind::match) {
+                throw_corrupt("Invalid distance code");
+            }
+            consume(d.length);
+            const std::size_t distance = d.value + bits(d.extra);
+            consume(d.extra);
+
+            const auto produced = static_cast<std::size_t>(op - c.out_begin);
+            if (distance > produced) {
+                if (distance > window_fill + produced) {
+                    throw_corrupt("Distance too far back");
+                }
+                c.op = op;
+                copy_match(c, len, distance);
+                op = c.op;
+                continue;
+            }
+            auto src = op - distance;
+            auto end = op + len;
+            if (distance >= 8) {
+                // May write up to seven bytes past the match, which will be overwritten later
+                while (op < end) {
+                    std::memcpy(op, src, 8);
+                    op += 8;
+                    src += 8;
+                }
+            } else if (distance == 1) {
+                std::memset(op, int(*src), len);
+            } else {
+                while (op < end) {
+                    *op++ = *src++;
+                }
+            }
+            op = end;
+        }
+        c.ip            = ip;
+        c.op            = op;
+        this->bit_buf   = bit_count ? bit_buf & (~std::uint64_t(0) >> (64 - bit_count)) : 0;
+        this->bit_count = bit_count;
+        return block_end;
+    }
+
+    /**
+     * Decode the symbols of a compressed block, one complete item at a time.
+     * Nothing is consumed unless all of the bits of an item are available.
+     */
+    progress decode_codes(cursor& c) {
+        while (true) {
+            if (match_remaining) {
+                match_remaining -= copy_match(c, match_remaining, match_dist);
+                if (match_remaining) {
+                    return progress::output_full;
+                }
+            }
+            if (decode_fast(c)) {
+                break;
+            }
+
+            pull(c, max_item_bits);
+            auto e    = litlen[peek(0, litlen_table_bits)];
+            auto used = unsigned(e.length);
+            if (used > bit_count) {
+                return progress::need_input;
+            }
+            if (e.kind == entry_kind::subtable) {
+                e = litlen[e.value + peek(used, e.extra)];
+                used += e.length;
+                if (used > bit_count) {
+                    return progress::need_input;
+                }
+            }
+            if (e.kind == entry_kind::literal) {
+                if (c.op == c.out_end) {
+                    return progress::output_full;
+                }
+                drop(used);
+                *c.op++ = std::byte(e.value);
+                continue;
+            }
+            if (e.kind == entry_kind::end_of_block) {
+                drop(used);
+                break;
+            }
+            if (e.kind != entry_kind::match) {
+                throw_corrupt("Invalid literal/length code");
+            }
+            if (used + e.extra > bit_count) {
+                return progress::need_input;
+            }
+            const std::size_t len = e.value + peek(used, e.extra);
+            used += e.extra;
+
+            auto d = dist[peek(used, dist_table_bits)];
+            if (used + d.length > bit_count) {
+                return progress::need_input;
+            }
+            if (d.kind == entry_kind::subtable) {
+                used += d.length;
+                d = dist[d.value + peek(used, d.extra)];
+                if (used + d.length > bit_count) {
+                    return progress::need_input;
+                }
+            }
+            if (d.kind != entry_kind::match) {
+                throw_corrupt("Invalid distance code");
+            }
+            used += d.length;
+            if (used + d.extra > bit_count) {
+                return progress::need_input;
+            }
+            const std::size_t distance = d.value + peek(used, d.extra);
+            used += d.extra;
+            drop(used);
+
+            if (distance > history(c)) {
+                throw_corrupt("Distance too far back");
+            }
+            match_remaining = len;
+            match_dist      = distance;
+        }
+        step = final_block ? decode_step::done : decode_step::block_header;
+        return progress::advanced;
+    }
+
+    decompress_result decompress(mutable_buffer out, const_buffer in) {
+        if (step == decode_step::done) {
+            return {.done = true};
+        }
+        cursor c{
+            .in_begin  = in.data(),
+            .ip        = in.data(),
+            .in_end    = in.data() + in.size(),
+            .out_begin = out.data(),
+            .op        = out.data(),
+            .out_end   = out.data() + out.size(),
+        };
+
+        auto p = progress::advanced;
+        while (p == progress::advanced && step != decode_step::done) {
+            switch (step) {
+            case decode_step::block_header:
+                p = read_block_header(c);
+                break;
+            case decode_step::stored_header:
+                p = read_stored_header(c);
+                break;
+            case decode_step::stored_copy:
+                p = copy_stored(c);
+                break;
+            case decode_step::dynamic_header:
+                p = read_dynamic_header(c);
+                break;
+            case decode_step::precode_lengths:
+                p = read_precode_lengths(c);
+                break;
+            case decode_step::code_lengths:
+                p = read_code_lengths(c);
+                break;
+            case decode_step::codes:
+                p = decode_codes(c);
+                break;
+            case decode_step::done:
+                break;
+            }
+        }
+
+        if (p != progress::need_input) {
+            // Whole bytes left in the bit buffer may belong to whatever follows the DEFLATE
+            // stream, so hand them back. (When more input is needed, every buffered bit is part
+            // of the item being decoded.)
+            const auto n_back = std::min(std::size_t(bit_count / 8),
+                                         static_cast<std::size_t>(c.ip - c.in_begin));
+            c.ip -= n_back;
+            bit_count -= unsigned(n_back * 8);
+            bit_buf &= bit_count ? ~std::uint64_t(0) >> (64 - bit_count) : 0;
+        }
+        update_window(c);
+        return {
+            .bytes_written = static_cast<std::size_t>(c.op - c.out_begin),
+            .bytes_read    = static_cast<std::size_t>(c.ip - c.in_begin),
+            .done          = step == decode_step::done,
+        };
+    }
+};
+
+fast_inflate_decompressor::fast_inflate_decompressor()
+    : _state(std::make_unique<state>()) {}
+
+fast_inflate_decompressor::~fast_inflate_decompressor() = default;
+
+fast_inflate_decompressor::fast_inflate_decompressor(fast_inflate_decompressor&&) noexcept
+    = default;
+fast_inflate_decompressor&
+fast_inflate_decompressor::operator=(fast_inflate_decompressor&&) noexcept = default;
+
+decompress_result fast_inflate_decompressor::operator()(mutable_buffer out, const_buffer in) {
+    return _state->decompress(out, in);
+}
+
+void fast_inflate_decompressor::reset() noexcept { _state->reset(); }
+
+void fast_inflate_decompressor::set_dictionary(const_buffer window) noexcept {
+    _state->set_window(window);
+}
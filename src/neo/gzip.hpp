@@ -3,6 +3,8 @@
 #include <neo/compress.hpp>
 #include <neo/crc32.hpp>
 #include <neo/decompress.hpp>
+#include <neo/dictionary.hpp>
+#include <neo/stream_stats.hpp>
 
 #include <neo/assert.hpp>
 #include <neo/buffer_algorithm/copy.hpp>
@@ -12,25 +14,57 @@
 #include <neo/ref.hpp>
 #include <neo/switch_coro.hpp>
 
+#include <algorithm>
 #include <stdexcept>
+#include <type_traits>
 
 namespace neo {
 
+namespace detail {
+
+/// Match (de)compressors that can be given a preset dictionary
+template <typename T>
+concept accepts_dictionary = requires(T& algo, const_buffer dict) {
+    algo.set_dictionary(dict);
+};
+
+}  // namespace detail
+
 /**
  * A gzip_compressor compresses a stream as a gzip stream, using `InnerCompressor`
  * to compress the actual body data.
+ *
+ * @tparam Stats A stream_stats_policy. With record_stream_stats, stats()
+ * reports the bytes, calls, and yields of the compressor, and the time spent
+ * in the inner compressor and computing the CRC.
  */
-template <compressor_algorithm InnerCompressor>
+template <compressor_algorithm InnerCompressor, stream_stats_policy Stats = no_stream_stats>
 class gzip_compressor {
     [[no_unique_address]] wrap_refs_t<InnerCompressor> _compressor;
 
+    [[no_unique_address]] detail::stream_stats_recorder<Stats::enabled> _stats;
+
     // Magic [0x1f, 0x8b] compresstion type DEFLATE [0x08]
     static inline const_buffer _fixed_header = const_buffer{"\x1f\x8b\x08"};
     // We don't support mtime yet
     static inline const_buffer _mtime = const_buffer{"\xde\xad\xbe\xef"};
 
+    /**
+     * The input is handed to the inner compressor in pieces of this size, so
+     * that the CRC of each piece is computed while it is still hot in the cache.
+     */
+    static constexpr std::size_t _crc_chunk_size = 1024 * 64;
+
+    /// The size of the "DC" FEXTRA subfield that holds the ID of a preset dictionary
+    static constexpr std::size_t _dict_field_size = 8;
+
     const_buffer  _header_buf = _fixed_header;
     const_buffer  _mtime_buf  = _mtime;
+    const_buffer  _extra;
+    const_buffer  _extra_buf;
+    const_buffer  _dictionary;
+    std::uint32_t _dictionary_id  = 0;
+    bool          _has_dictionary = false;
     crc32         _crc;
     std::uint32_t _size                   = 0;
     std::size_t   _num_crc_bytes_written  = 0;
@@ -66,13 +100,102 @@ class gzip_compressor {
         return false;
     }
 
+    constexpr bool _has_extra_field() const noexcept { return _has_dictionary || !_extra.empty(); }
+
+    constexpr std::size_t _xlen() const noexcept {
+        return _extra.size() + (_has_dictionary ? _dict_field_size : 0);
+    }
+
 public:
     constexpr gzip_compressor() = default;
     constexpr explicit gzip_compressor(InnerCompressor&& c)
         : _compressor(NEO_FWD(c)) {}
 
-    constexpr void reset() noexcept { *this = gzip_compressor(); }
+    NEO_DECL_UNREF_GETTER(compressor, _compressor);
+
+    /**
+     * Reset the compressor to begin a new gzip stream. The inner compressor is
+     * reset in-place, so any parameters it was given are retained. If a
+     * dictionary was given, it is given to the inner compressor again.
+     */
+    constexpr void reset() noexcept {
+        unref(_compressor).reset();
+        using inner_type = std::remove_cvref_t<decltype(unref(_compressor))>;
+        if constexpr (detail::accepts_dictionary<inner_type>) {
+            if (_has_dictionary) {
+                unref(_compressor).set_dictionary(_dictionary);
+            }
+        }
+        _header_buf             = _fixed_header;
+        _mtime_buf              = _mtime;
+        _extra_buf              = _extra;
+        _crc                    = crc32();
+        _size                   = 0;
+        _num_crc_bytes_written  = 0;
+        _num_size_bytes_written = 0;
+        _coro                   = 0;
+    }
+
+    /**
+     * Set the FEXTRA field to write in the header of the stream. The buffer is
+     * not copied: It must remain valid until the header has been written.
+     * Must be called before any output is generated.
+     */
+    constexpr void set_extra_field(const_buffer extra) noexcept {
+        neo_assert(expects,
+                   _coro == 0,
+                   "gzip_compressor::set_extra_field() called after output was generated");
+        neo_assert(expects,
+                   extra.size() <= 0xffff - _dict_field_size,
+                   "gzip FEXTRA field is too large",
+                   extra.size());
+        _extra     = extra;
+        _extra_buf = extra;
+    }
+
+    /**
+     * Compress using a preset dictionary, such as one from train_dictionary().
+     * The ID of the dictionary is written in a "DC" subfield of the FEXTRA
+     * field, so that a gzip_decompressor can check that it was given the same
+     * dictionary. Other gzip implementations cannot decompress the data.
+     *
+     * The buffer is not copied: It must remain valid for as long as the
+     * compressor is used, as reset() gives it to the inner compressor again.
+     * Must be called before any output is generated.
+     */
+    void set_dictionary(const_buffer dict) {
+        neo_assert(expects,
+                   _coro == 0,
+                   "gzip_compressor::set_dictionary() called after output was generated");
+        unref(_compressor).set_dictionary(dict);
+        _dictionary     = dict;
+        _dictionary_id  = dictionary_id(dict);
+        _has_dictionary = true;
+    }
+
+    /**
+     * Get the statistics recorded since construction. These accumulate across
+     * calls to reset(). The peak allocator usage is that of the inner
+     * compressor, if it records one.
+     */
+    stream_stats stats() const noexcept requires Stats::enabled {
+        auto ret                 = _stats.values();
+        ret.peak_bytes_allocated = detail::peak_bytes_allocated_of(unref(_compressor));
+        return ret;
+    }
+
+    constexpr compress_result
+    operator()(mutable_buffer out, const_buffer in, flush f = flush::no_flush) noexcept {
+        if constexpr (Stats::enabled) {
+            auto res = _stats.timed(&stream_stats::total_time, [&] { return _step(out, in, f); });
+            _stats.record_call(res.bytes_read, res.bytes_written, !res.done);
+            return res;
+        } else {
+            return _step(out, in, f);
+        }
+    }
 
+private:
 /**
  * Write the entire contents of `Buf` into `Dest`
  */
@@ -97,8 +220,7 @@ public:
     Out += 1;                                                                                      \
     NEO_FN_MACRO_END
 
-    constexpr compress_result
-    operator()(mutable_buffer out, const_buffer in, flush f = flush::no_flush) noexcept {
+    constexpr compress_result _step(mutable_buffer out, const_buffer in, flush f) noexcept {
         neo_assert(expects,
                    !NEO_CORO_IS_FINISHED(_coro),
                    "Application reused gzip_compressor without calling .reset()");
@@ -113,34 +235,67 @@ public:
         };
 
         bool compress_done = false;
+        bool made_progress = false;
 
         NEO_CORO_BEGIN(_coro);
 
         // Flush the header
         FLUSH_BUF(out, _header_buf);
-        // The flags byte (all zero, for now)
-        PUT_BYTE(out, std::byte(0x00));
+        // The flags byte. We only set FEXTRA, if needed.
+        PUT_BYTE(out, _has_extra_field() ? std::byte(0x04) : std::byte(0x00));
         // Flush the mtime bytes
         FLUSH_BUF(out, _mtime_buf);
         // No interesting extra flags:
         PUT_BYTE(out, std::byte(0x00));
         // Flush the OS (0xff == unknown)
         PUT_BYTE(out, std::byte(0xff));
+        if (_has_extra_field()) {
+            // XLEN, followed by the extra field itself
+            PUT_BYTE(out, std::byte(_xlen() & 0xff));
+            PUT_BYTE(out, std::byte(_xlen() >> 8));
+            if (_has_dictionary) {
+                // The "DC" subfield, with a four-byte little-endian dictionary ID
+                PUT_BYTE(out, std::byte('D'));
+                PUT_BYTE(out, std::byte('C'));
+                PUT_BYTE(out, std::byte(4));
+                PUT_BYTE(out, std::byte(0));
+                PUT_BYTE(out, std::byte(_dictionary_id));
+                PUT_BYTE(out, std::byte(_dictionary_id >> 8));
+                PUT_BYTE(out, std::byte(_dictionary_id >> 16));
+                PUT_BYTE(out, std::byte(_dictionary_id >> 24));
+            }
+            FLUSH_BUF(out, _extra_buf);
+        }
 
         // Write the actual body of data
         while (true) {
             {
-                // Compress some data into `out`
+                // Compress a piece of the input into `out`. The flush only applies once we
+                // reach the final piece.
                 using std::as_const;
-                auto compress_res = unref(_compressor)(as_const(out), as_const(in), f);
+                const auto in_part   = in.first(std::min(in.size(), _crc_chunk_size));
+                const bool last_part = in_part.size() == in.size();
+                const auto compress_res = _stats.timed(&stream_stats::codec_time, [&] {
+                    return unref(_compressor)(as_const(out),
+                                              in_part,
+                                              last_part ? f : flush::no_flush);
+                });
                 // Update the running CRC
-                _crc.feed(in.first(compress_res.bytes_read));
+                _stats.timed(&stream_stats::checksum_time, [&] {
+                    _crc.feed(in.first(compress_res.bytes_read));
+                });
                 // Update the running size count
                 _size += static_cast<std::uint32_t>(compress_res.bytes_read);
                 // Advance our buffers by the used space
                 out += compress_res.bytes_written;
                 in += compress_res.bytes_read;
                 compress_done = compress_res.done;
+                made_progress = compress_res.bytes_read || compress_res.bytes_written;
+            }
+
+            if (!compress_done && !in.empty() && !out.empty() && made_progress) {
+                // There is more input, and room to put it
+                continue;
             }
 
             if (!compress_done) {
@@ -217,10 +372,49 @@ public:
 template <typename C>
 gzip_compressor(C &&) -> gzip_compressor<C>;
 
-template <decompressor_algorithm InnerDecompressor>
+/**
+ * Options for a gzip_decompressor
+ */
+struct gzip_decompress_options {
+    /**
+     * Check the CRC-32 and the size stored in the trailer of the stream. This
+     * should only be disabled for trusted data, such as data that the
+     * application generated itself.
+     */
+    bool verify_checksum = true;
+    /**
+     * Decode a stream of concatenated gzip members (as produced by pigz,
+     * bgzip, or `cat a.gz b.gz`) as a single stream. Since another member may
+     * always follow, the decompressor never reports `done` in this mode: The
+     * data ends when the input ends. Use at_member_boundary() to check that the
+     * input did not end part-way through a member.
+     */
+    bool multi_member = false;
+};
+
+/**
+ * A gzip_decompressor decompresses a gzip stream, using `InnerDecompressor` to
+ * decompress the actual body data.
+ *
+ * @tparam Stats A stream_stats_policy. With record_stream_stats, stats()
+ * reports the bytes, calls, and yields of the decompressor, and the time spent
+ * in the inner decompressor and verifying the CRC.
+ */
+template <decompressor_algorithm InnerDecompressor, stream_stats_policy Stats = no_stream_stats>
 class gzip_decompressor {
     [[no_unique_address]] wrap_refs_t<InnerDecompressor> _decompress;
 
+    [[no_unique_address]] detail::stream_stats_recorder<Stats::enabled> _stats;
+
+    /**
+     * The output is requested from the inner decompressor in pieces of this
+     * size, so that the CRC of each piece is computed while it is still hot in
+     * the cache.
+     */
+    static constexpr std::size_t _crc_chunk_size = 1024 * 64;
+
+    gzip_decompress_options _opts;
+
     int _coro = 0;
 
     template <std::size_t Len>
@@ -232,6 +426,11 @@ class gzip_decompressor {
         constexpr arrbuf(const arrbuf& other)
             : bytes(other.bytes)
             , buf(as_buffer(bytes)) {}
+
+        constexpr void reset() noexcept {
+            bytes = {};
+            buf   = mutable_buffer(bytes);
+        }
     };
 
     arrbuf<2> _magic;
@@ -250,8 +449,13 @@ class gzip_decompressor {
     arrbuf<4>        _stored_crc32;
     arrbuf<4>        _stored_size;
 
-    std::size_t _actual_size = 0;
-    crc32       _actual_crc;
+    std::uint64_t _actual_size = 0;
+    crc32         _actual_crc;
+    bool          _member_done = false;
+
+    const_buffer  _dictionary;
+    std::uint32_t _dictionary_id  = 0;
+    bool          _has_dictionary = false;
 
     constexpr std::uint16_t _xlen_uint16() const noexcept {
         return std::uint16_t(
@@ -278,13 +482,124 @@ class gzip_decompressor {
     constexpr bool _fname_set() const noexcept { return int(_flags) & 1 << 3; }
     constexpr bool _fcomment_set() const noexcept { return int(_flags) & 1 << 4; }
 
+    /**
+     * If the FEXTRA field of the current member names a preset dictionary with
+     * a "DC" subfield, give the dictionary to the inner decompressor.
+     */
+    void _load_member_dictionary() {
+        const auto& f    = _fextra.bytes;
+        const auto  xlen = std::size_t(_xlen_uint16());
+        std::size_t pos  = 0;
+        while (pos + 4 <= xlen) {
+            const auto len = std::size_t(f[pos + 2]) | (std::size_t(f[pos + 3]) << 8);
+            if (f[pos] != std::byte('D') || f[pos + 1] != std::byte('C') || len != 4
+                || pos + 8 > xlen) {
+                pos += 4 + len;
+                continue;
+            }
+            const auto id = (std::uint32_t(f[pos + 4])            //
+                             | (std::uint32_t(f[pos + 5]) << 8)   //
+                             | (std::uint32_t(f[pos + 6]) << 16)  //
+                             | (std::uint32_t(f[pos + 7]) << 24));
+            if (!_has_dictionary) {
+                throw std::runtime_error("gzip member requires a preset dictionary");
+            }
+            if (id != _dictionary_id) {
+                throw std::runtime_error(
+                    "gzip member was compressed with a different preset dictionary");
+            }
+            using inner_type = std::remove_cvref_t<decltype(unref(_decompress))>;
+            if constexpr (detail::accepts_dictionary<inner_type>) {
+                unref(_decompress).set_dictionary(_dictionary);
+            } else {
+                throw std::runtime_error("The inner decompressor does not support dictionaries");
+            }
+            return;
+        }
+    }
+
+    constexpr void _reset_member() noexcept {
+        unref(_decompress).reset();
+        _flags              = std::byte{0};
+        _compression_method = std::byte{};
+        _xfl                = std::byte{};
+        _os                 = std::byte{};
+        _magic.reset();
+        _mtime.reset();
+        _xlen.reset();
+        _fextra.reset();
+        _fname.reset();
+        _comment.reset();
+        _hcrc.reset();
+        _stored_crc32.reset();
+        _stored_size.reset();
+        _actual_size = 0;
+        _actual_crc  = crc32();
+    }
+
 public:
     constexpr gzip_decompressor() = default;
-    constexpr explicit gzip_decompressor(InnerDecompressor&& c)
-        : _decompress(NEO_FWD(c)) {}
+    constexpr explicit gzip_decompressor(const gzip_decompress_options& opts)
+        : _opts(opts) {}
+    constexpr explicit gzip_decompressor(InnerDecompressor&&            c,
+                                         const gzip_decompress_options& opts = {})
+        : _decompress(NEO_FWD(c))
+        , _opts(opts) {}
+
+    NEO_DECL_UNREF_GETTER(decompressor, _decompress);
+
+    const gzip_decompress_options& options() const noexcept { return _opts; }
+
+    /**
+     * Reset the decompressor to begin a new gzip stream. The options and the
+     * inner decompressor are retained.
+     */
+    constexpr void reset() noexcept {
+        _reset_member();
+        _coro        = 0;
+        _member_done = false;
+    }
+
+    /**
+     * Whether the decompressor is between gzip members, i.e. at least one
+     * member has been fully decoded and no part of another has been read.
+     */
+    constexpr bool at_member_boundary() const noexcept { return _member_done; }
+
+    /**
+     * Provide the preset dictionary for members that were compressed with one
+     * by gzip_compressor::set_dictionary(). A member that names a different
+     * dictionary is rejected. The buffer is not copied: It must remain valid
+     * for as long as the decompressor is used.
+     */
+    void set_dictionary(const_buffer dict) {
+        _dictionary     = dict;
+        _dictionary_id  = dictionary_id(dict);
+        _has_dictionary = true;
+    }
+
+    /**
+     * Get the statistics recorded since construction. These accumulate across
+     * calls to reset(). The peak allocator usage is that of the inner
+     * decompressor, if it records one.
+     */
+    stream_stats stats() const noexcept requires Stats::enabled {
+        auto ret                 = _stats.values();
+        ret.peak_bytes_allocated = detail::peak_bytes_allocated_of(unref(_decompress));
+        return ret;
+    }
 
-    constexpr void reset() noexcept { *this = gzip_decompressor(); }
+    constexpr decompress_result operator()(mutable_buffer out, const_buffer in) {
+        if constexpr (Stats::enabled) {
+            auto res = _stats.timed(&stream_stats::total_time, [&] { return _step(out, in); });
+            _stats.record_call(res.bytes_read, res.bytes_written, !res.done);
+            return res;
+        } else {
+            return _step(out, in);
+        }
+    }
 
+private:
 /**
  * Continually read bytes into Arr until Arr is full
  */
@@ -342,7 +657,7 @@ public:
     Buf += 1;                                                                                      \
     NEO_FN_MACRO_END
 
-    constexpr decompress_result operator()(mutable_buffer out, const_buffer in) {
+    constexpr decompress_result _step(mutable_buffer out, const_buffer in) {
         const auto out_init = out;
         const auto in_init  = in;
         auto       calc_ret = [&] {
@@ -359,77 +674,105 @@ public:
 
         NEO_CORO_BEGIN(_coro);
 
-        // Read the magic number
-        CORO_READ_BUF(_magic, in);
-        if (_magic.bytes[0] != std::byte(0x1f) || _magic.bytes[1] != std::byte(0x8b)) {
-            // Invalid magic number
-            throw std::runtime_error("Invalid gzip magic number");
-        }
+        while (true) {
+            // Read the magic number
+            CORO_READ_BUF(_magic, in);
+            if (_magic.bytes[0] != std::byte(0x1f) || _magic.bytes[1] != std::byte(0x8b)) {
+                // Invalid magic number
+                throw std::runtime_error("Invalid gzip magic number");
+            }
 
-        // Read the various gzip header bits
-        CORO_READ_BYTE(_compression_method, in);
-        CORO_READ_BYTE(_flags, in);
-        CORO_READ_BUF(_mtime, in);
-        CORO_READ_BYTE(_xfl, in);
-        CORO_READ_BYTE(_os, in);
-
-        // Optional, fextra:
-        if (_fextra_set()) {
-            CORO_READ_BUF(_xlen, in);
-            if (_xlen_uint16() > _fextra.buf.size()) {
-                throw std::runtime_error("gzip xlen is larger than supported");
+            // Read the various gzip header bits
+            CORO_READ_BYTE(_compression_method, in);
+            CORO_READ_BYTE(_flags, in);
+            CORO_READ_BUF(_mtime, in);
+            CORO_READ_BYTE(_xfl, in);
+            CORO_READ_BYTE(_os, in);
+
+            // Optional, fextra:
+            if (_fextra_set()) {
+                CORO_READ_BUF(_xlen, in);
+                if (_xlen_uint16() > _fextra.buf.size()) {
+                    throw std::runtime_error("gzip xlen is larger than supported");
+                }
+                _fextra.buf = _fextra.buf.first(_xlen_uint16());
+                CORO_READ_BUF(_fextra, in);
+                _load_member_dictionary();
             }
-            _fextra.buf = _fextra.buf.first(_xlen_uint16());
-            CORO_READ_BUF(_fextra, in);
-        }
 
-        // Optional, filename:
-        if (_fname_set()) {
-            CORO_READ_ZSTR(_fname, in);
-        }
+            // Optional, filename:
+            if (_fname_set()) {
+                CORO_READ_ZSTR(_fname, in);
+            }
 
-        // Optional: file comment
-        if (_fcomment_set()) {
-            CORO_READ_ZSTR(_comment, in);
-        }
+            // Optional: file comment
+            if (_fcomment_set()) {
+                CORO_READ_ZSTR(_comment, in);
+            }
 
-        // Optional, a header CRC, although we don't actually validate this (yet)
-        if (_fhcrc_set()) {
-            CORO_READ_BUF(_hcrc, in);
-        }
+            // Optional, a header CRC, although we don't actually validate this (yet)
+            if (_fhcrc_set()) {
+                CORO_READ_BUF(_hcrc, in);
+            }
 
-        // Decompress the actual body of the file:
-        while (true) {
-            {
-                // Decompress more
-                const auto decomp_res = unref(_decompress)(std::as_const(out), std::as_const(in));
-                // Update the running CRC
-                _actual_crc.feed(out.first(decomp_res.bytes_written));
-                // Advance our buffers
-                in += decomp_res.bytes_read;
-                out += decomp_res.bytes_written;
-                // Track how much we've read
-                _actual_size += decomp_res.bytes_written;
-                if (decomp_res.done) {
-                    break;
+            // Decompress the actual body of the file:
+            while (true) {
+                {
+                    // Decompress a piece of the output
+                    const auto out_part   = out.first(std::min(out.size(), _crc_chunk_size));
+                    const auto decomp_res = _stats.timed(&stream_stats::codec_time, [&] {
+                        return unref(_decompress)(out_part, std::as_const(in));
+                    });
+                    // Update the running CRC
+                    if (_opts.verify_checksum) {
+                        _stats.timed(&stream_stats::checksum_time, [&] {
+                            _actual_crc.feed(out.first(decomp_res.bytes_written));
+                        });
+                    }
+                    // Advance our buffers
+                    in += decomp_res.bytes_read;
+                    out += decomp_res.bytes_written;
+                    // Track how much we've read
+                    _actual_size += decomp_res.bytes_written;
+                    if (decomp_res.done) {
+                        break;
+                    }
+                    if (decomp_res.bytes_written == out_part.size() && !out.empty()) {
+                        // We filled the piece, and there is room for more
+                        continue;
+                    }
                 }
+                // We aren't done yet, so yield until we get more data
+                NEO_CORO_YIELD(calc_ret());
             }
-            // We aren't done yet, so yield until we get more data
-            NEO_CORO_YIELD(calc_ret());
-        }
 
-        // Read the trailing CRC and data size
-        CORO_READ_BUF(_stored_crc32, in);
-        CORO_READ_BUF(_stored_size, in);
+            // Read the trailing CRC and data size
+            CORO_READ_BUF(_stored_crc32, in);
+            CORO_READ_BUF(_stored_size, in);
 
-        // Check that the CRC matches
-        if (_actual_crc.value() != _stored_crc_uint32()) {
-            throw std::runtime_error("CRC-32 check failed");
-        }
+            if (_opts.verify_checksum) {
+                // Check that the CRC matches
+                if (_actual_crc.value() != _stored_crc_uint32()) {
+                    throw std::runtime_error("CRC-32 check failed");
+                }
 
-        // And the data size:
-        if (_actual_size != _stored_size_uint32()) {
-            throw std::runtime_error("Data length mismatch");
+                // And the data size. The stored size is only the low 32 bits.
+                if (static_cast<std::uint32_t>(_actual_size) != _stored_size_uint32()) {
+                    throw std::runtime_error("Data length mismatch");
+                }
+            }
+
+            _member_done = true;
+            if (!_opts.multi_member) {
+                break;
+            }
+
+            // Another member may follow. Wait until we see more input.
+            _reset_member();
+            while (in.empty()) {
+                NEO_CORO_YIELD(calc_ret());
+            }
+            _member_done = false;
         }
 
         NEO_CORO_END;
@@ -445,4 +788,7 @@ public:
 template <decompressor_algorithm D>
 explicit gzip_decompressor(D &&) -> gzip_decompressor<D>;
 
+template <decompressor_algorithm D>
+gzip_decompressor(D&&, const gzip_decompress_options&) -> gzip_decompressor<D>;
+
 }  // namespace neo
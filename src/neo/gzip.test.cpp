@@ -54,3 +54,36 @@ TEST_CASE("Decompress with metadata") {
     plain.shrink_uncommitted();
     CHECK(plain.storage() == "asdf");
 }
+
+TEST_CASE("Checksum verification can be disabled") {
+    std::string text;
+    for (auto i = 0; i < 20000; ++i) {
+        text += "Some data to compress " + std::to_string(i) + "\n";
+    }
+    neo::gzip_compressor<neo::deflate_compressor> comp;
+    neo::dynbuf_io<std::string>                   gzipped;
+    neo::buffer_transform(comp, gzipped, neo::const_buffer(text));
+    neo::buffer_transform(comp, gzipped, neo::const_buffer(), neo::flush::finish);
+    gzipped.shrink_uncommitted();
+
+    // Corrupt the stored CRC-32
+    auto corrupt = gzipped.storage();
+    corrupt[corrupt.size() - 6] ^= 0x40;
+
+    neo::gzip_decompressor<neo::inflate_decompressor> checked;
+    neo::dynbuf_io<std::string>                       out;
+    CHECK_THROWS_AS(neo::buffer_transform(checked, out, neo::const_buffer(corrupt)),
+                    std::runtime_error);
+
+    neo::gzip_decompressor<neo::inflate_decompressor> unchecked{
+        neo::gzip_decompress_options{.verify_checksum = false}};
+    for (auto i = 0; i < 2; ++i) {
+        // Resetting keeps the options
+        unchecked.reset();
+        neo::dynbuf_io<std::string> plain;
+        auto res = neo::buffer_transform(unchecked, plain, neo::const_buffer(corrupt));
+        plain.shrink_uncommitted();
+        CHECK(res.done);
+        CHECK(plain.storage() == text);
+    }
+}
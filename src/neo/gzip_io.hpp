@@ -3,57 +3,300 @@
 #include "./deflate.hpp"
 #include "./gzip.hpp"
 #include "./inflate.hpp"
+#include "./one_shot.hpp"
 
 #include <neo/buffer_sink.hpp>
 #include <neo/buffer_source.hpp>
 #include <neo/transform_io.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <istream>
+#include <optional>
+#include <stdexcept>
+
 namespace neo {
 
+/**
+ * @brief Controls when a gzip_sink automatically flushes its pending data.
+ *
+ * A flush makes all data written so far decodable by a reader of the stream, at
+ * the cost of a few bytes of output (and some compression ratio). The policy is
+ * checked whenever data is committed to the sink. Use gzip_sink::flush_if_due()
+ * to apply a time-based policy while the writer is otherwise idle.
+ */
+struct gzip_flush_policy {
+    /// Flush after this many bytes have been written since the last flush. Zero disables.
+    std::size_t max_pending_bytes = 0;
+    /// Flush once data has been pending for at least this long. Zero disables.
+    std::chrono::milliseconds max_delay{0};
+    /// The kind of flush to perform
+    flush mode = flush::sync;
+
+    constexpr bool enabled() const noexcept {
+        return max_pending_bytes != 0 || max_delay.count() != 0;
+    }
+};
+
+namespace detail {
+
+/// The compressor of a gzip_sink that records the given statistics
+template <stream_stats_policy Stats>
+using gzip_sink_compressor_t = gzip_compressor<deflate_compressor_for_t<Stats>, Stats>;
+
+/// The decompressor of a gzip_source that records the given statistics
+template <stream_stats_policy Stats>
+using gzip_source_decompressor_t = gzip_decompressor<inflate_decompressor_for_t<Stats>, Stats>;
+
+}  // namespace detail
+
 /**
  * @brief Adapt a buffer_sink with gzip-based compression.
  *
  * @tparam Sink The underlying buffer sink (A file, socket, etc.)
+ * @tparam Stats A stream_stats_policy. With record_stream_stats, stats() reports
+ * the work done by the sink and its compressor.
  */
-template <buffer_sink Sink>
-class gzip_sink : public buffer_transform_sink<Sink, gzip_compressor<deflate_compressor>> {
+template <buffer_sink Sink, stream_stats_policy Stats = no_stream_stats>
+class gzip_sink : public buffer_transform_sink<Sink, detail::gzip_sink_compressor_t<Stats>> {
+    using clock = std::chrono::steady_clock;
+
+    gzip_flush_policy _flush_policy;
+    std::size_t       _pending_bytes = 0;
+    clock::time_point _pending_since;
+
+    [[no_unique_address]] detail::stream_stats_recorder<Stats::enabled> _stats;
+
+    template <typename Func>
+    decltype(auto) _timed_call(Func&& fn) {
+        if constexpr (Stats::enabled) {
+            _stats.record_call(0, 0, false);
+            return _stats.timed(&stream_stats::total_time, fn);
+        } else {
+            return fn();
+        }
+    }
+
 public:
+    using compressor_type = detail::gzip_sink_compressor_t<Stats>;
+
     explicit gzip_sink(Sink&& out)
         : gzip_sink::buffer_transform_sink{NEO_FWD(out), {}} {}
 
+    gzip_sink(Sink&& out, const deflate_options& opts, const gzip_flush_policy& policy = {})
+        : gzip_sink::buffer_transform_sink{
+            NEO_FWD(out),
+            compressor_type{detail::deflate_compressor_for_t<Stats>{opts}}}
+        , _flush_policy(policy) {}
+
+    /**
+     * @brief Change the compression level and strategy for subsequent data.
+     *
+     * Data that has already been written is unaffected.
+     */
+    void set_params(int level, deflate_strategy strategy) {
+        this->transformer().compressor().set_params(level, strategy);
+    }
+
+    void set_flush_policy(const gzip_flush_policy& policy) noexcept { _flush_policy = policy; }
+
+    void commit(std::size_t n) {
+        _timed_call([&] { gzip_sink::buffer_transform_sink::commit(n); });
+        if (!_flush_policy.enabled() || n == 0) {
+            return;
+        }
+        if (_pending_bytes == 0) {
+            _pending_since = clock::now();
+        }
+        _pending_bytes += n;
+        flush_if_due();
+    }
+
+    /**
+     * @brief Flush all data written so far through to the underlying sink, so
+     * that it can be decoded by a reader without waiting for more data.
+     *
+     * @returns The number of bytes written to the underlying sink.
+     */
+    std::size_t flush(neo::flush mode = neo::flush::sync) {
+        _pending_bytes = 0;
+        return _timed_call([&] {
+            return buffer_transform(this->transformer(), this->sink(), const_buffer(), mode)
+                .bytes_written;
+        });
+    }
+
+    /**
+     * @brief Perform a flush if the flush policy says one is due.
+     *
+     * @returns The number of bytes written to the underlying sink.
+     */
+    std::size_t flush_if_due() {
+        if (_pending_bytes == 0) {
+            return 0;
+        }
+        const bool size_due = _flush_policy.max_pending_bytes != 0
+            && _pending_bytes >= _flush_policy.max_pending_bytes;
+        const bool time_due = _flush_policy.max_delay.count() != 0
+            && clock::now() - _pending_since >= _flush_policy.max_delay;
+        if (size_due || time_due) {
+            return flush(_flush_policy.mode);
+        }
+        return 0;
+    }
+
     std::size_t finish() {
-        return buffer_transform(this->transformer(), this->sink(), const_buffer(), flush::finish)
-            .bytes_written;
+        _pending_bytes = 0;
+        return _timed_call([&] {
+            return buffer_transform(this->transformer(),
+                                    this->sink(),
+                                    const_buffer(),
+                                    neo::flush::finish)
+                .bytes_written;
+        });
+    }
+
+    /**
+     * @brief Get the statistics recorded since construction.
+     *
+     * The calls are those to commit(), flush(), and finish(). The time spent
+     * in those calls outside of the compressor, including the time spent
+     * writing to the underlying sink, is counted as copy_time.
+     */
+    stream_stats stats() const noexcept requires Stats::enabled {
+        auto        ret   = this->transformer().stats();
+        const auto& own   = _stats.values();
+        const auto  outer = std::max(own.total_time - ret.total_time, stream_stats::duration{});
+        ret.calls         = own.calls;
+        ret.total_time    = own.total_time;
+        ret.copy_time += outer;
+        return ret;
     }
 };
 
 template <buffer_sink S>
 explicit gzip_sink(S &&) -> gzip_sink<S>;
 
+template <buffer_sink S, typename... Args>
+gzip_sink(S&&, const deflate_options&, Args&&...) -> gzip_sink<S>;
+
 /**
  * @brief Adapt a buffer_source with gzip-based decompression.
  *
  * @tparam Source The underlying buffer source (A file, socket, etc.)
+ * @tparam Stats A stream_stats_policy. With record_stream_stats, stats() reports
+ * the work done by the source and its decompressor.
  */
-template <buffer_source Source>
+template <buffer_source Source, stream_stats_policy Stats = no_stream_stats>
 class gzip_source
-    : public buffer_transform_source<Source, gzip_decompressor<inflate_decompressor>> {
+    : public buffer_transform_source<Source, detail::gzip_source_decompressor_t<Stats>> {
+    [[no_unique_address]] detail::stream_stats_recorder<Stats::enabled> _stats;
+
+    auto _next(std::size_t n) {
+        if constexpr (Stats::enabled) {
+            _stats.record_call(0, 0, false);
+            return _stats.timed(&stream_stats::total_time,
+                                [&] { return gzip_source::buffer_transform_source::next(n); });
+        } else {
+            return gzip_source::buffer_transform_source::next(n);
+        }
+    }
+
 public:
-    explicit gzip_source(Source&& in)
-        : gzip_source::buffer_transform_source{NEO_FWD(in), {}} {}
+    using decompressor_type = detail::gzip_source_decompressor_t<Stats>;
+
+    explicit gzip_source(Source&& in, const gzip_decompress_options& opts = {})
+        : gzip_source::buffer_transform_source{NEO_FWD(in), decompressor_type{opts}} {}
+
+    /**
+     * @brief Get the next piece of decompressed data.
+     *
+     * With gzip_decompress_options::multi_member, throws if the underlying
+     * source ends part-way through a member.
+     */
+    auto next(std::size_t n) {
+        auto part = _next(n);
+        if (part.size() == 0 && n != 0 && this->transformer().options().multi_member
+            && !this->transformer().at_member_boundary()) {
+            throw std::runtime_error("gzip data ended part-way through a member");
+        }
+        return part;
+    }
+
+    /**
+     * @brief Get the statistics recorded since construction.
+     *
+     * The calls are those to next(). The time spent in next() outside of the
+     * decompressor, including the time spent reading from the underlying
+     * source, is counted as copy_time.
+     */
+    stream_stats stats() const noexcept requires Stats::enabled {
+        auto        ret   = this->transformer().stats();
+        const auto& own   = _stats.values();
+        const auto  outer = std::max(own.total_time - ret.total_time, stream_stats::duration{});
+        ret.calls         = own.calls;
+        ret.total_time    = own.total_time;
+        ret.copy_time += outer;
+        return ret;
+    }
 };
 
 template <buffer_source S>
 explicit gzip_source(S &&) -> gzip_source<S>;
 
+template <buffer_source S>
+gzip_source(S&&, const gzip_decompress_options&) -> gzip_source<S>;
+
+namespace detail {
+
+/// Whether the input is a single contiguous buffer
+template <typename In>
+concept contiguous_buffer_input = requires(In&& in) {
+    const_buffer(in);
+};
+
+/**
+ * Estimate the decompressed size of the given gzip input, if the input is
+ * contiguous or is backed by a seekable stream.
+ */
+template <typename In>
+std::optional<std::size_t> gzip_input_size_hint(In&& in) {
+    if constexpr (contiguous_buffer_input<In>) {
+        return gzip_output_size_hint(const_buffer(in));
+    } else if constexpr (requires { static_cast<std::istream&>(in.stream()); }) {
+        return gzip_output_size_hint(static_cast<std::istream&>(in.stream()));
+    } else {
+        return std::nullopt;
+    }
+}
+
+}  // namespace detail
+
 /**
  * @brief Compress the given input and write it as a gzip-stream to the given output.
  *
+ * If the input is a single contiguous buffer and the output can provide room
+ * for deflateBound() bytes, the data is compressed in one step directly into
+ * the output.
+ *
  * @returns the number of bytes written to the output.
  */
 template <buffer_output Out, buffer_input In>
-std::size_t gzip_compress(Out&& out, In&& in) {
-    gzip_sink gz_out{ensure_buffer_sink(out)};
+std::size_t gzip_compress(Out&& out, In&& in, const deflate_options& opts = {}) {
+    if constexpr (detail::contiguous_buffer_input<In>) {
+        auto&&     sink  = ensure_buffer_sink(out);
+        const auto cb    = const_buffer(in);
+        const auto bound = gzip_compress_bound(cb.size(), opts);
+        auto&&     area  = sink.prepare(bound);
+        if constexpr (std::convertible_to<decltype(area), mutable_buffer>) {
+            if (mutable_buffer(area).size() >= bound) {
+                const auto n = gzip_compress_buffer(mutable_buffer(area), cb, opts);
+                sink.commit(n);
+                return n;
+            }
+        }
+    }
+    gzip_sink gz_out{ensure_buffer_sink(out), opts};
     auto      n = buffer_copy(gz_out, in);
     n += gz_out.finish();
     return n;
@@ -63,12 +306,22 @@ std::size_t gzip_compress(Out&& out, In&& in) {
  * @brief Decompress the given gzip-compressed input, and write the decompressed data to the given
  * output.
  *
+ * If the input is contiguous or is a seekable stream, the size of the output
+ * is read from the gzip trailer and room for all of it is prepared in the
+ * output at once.
+ *
  * @returns The number of bytes written to the output.
  */
 template <buffer_output Out, buffer_input In>
-std::size_t gzip_decompress(Out&& out, In&& in) {
-    gzip_source gz_in{ensure_buffer_source(in)};
-    auto        n = buffer_copy(out, gz_in);
+std::size_t gzip_decompress(Out&& out, In&& in, const gzip_decompress_options& opts = {}) {
+    auto&& sink = ensure_buffer_sink(out);
+    if (!opts.multi_member) {
+        if (auto size = detail::gzip_input_size_hint(in)) {
+            sink.prepare(*size);
+        }
+    }
+    gzip_source gz_in{ensure_buffer_source(in), opts};
+    auto        n = buffer_copy(sink, gz_in);
     return n;
 }
 
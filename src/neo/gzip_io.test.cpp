@@ -1,9 +1,13 @@
 #include "./gzip_io.hpp"
 
+#include <neo/dynbuf_io.hpp>
+#include <neo/iostream_io.hpp>
 #include <neo/string_io.hpp>
 
 #include <catch2/catch.hpp>
 
+#include <sstream>
+
 TEST_CASE("Compress a simple string") {
     neo::string_dynbuf_io gz_data;
     neo::gzip_sink        gz_out{gz_data};
@@ -32,3 +36,130 @@ TEST_CASE("Compress a simple string") {
     neo::gzip_decompress(decompressed, compressed);
     CHECK(decompressed.string() == pasta);
 }
+
+TEST_CASE("Compress with non-default options") {
+    std::string text;
+    for (auto i = 0; i < 100; ++i) {
+        text += "I am a line of text that will be compressed with gzip.\n";
+    }
+
+    neo::string_dynbuf_io gz_data;
+    neo::gzip_sink        gz_out{gz_data, neo::deflate_options{.level = 9, .window_bits = 15}};
+    neo::buffer_copy(gz_out, neo::const_buffer(text));
+    gz_out.set_params(1, neo::deflate_strategy::rle);
+    neo::buffer_copy(gz_out, neo::const_buffer(text));
+    gz_out.finish();
+
+    neo::string_dynbuf_io plain;
+    neo::gzip_decompress(plain, gz_data);
+    CHECK(plain.string() == text + text);
+}
+
+TEST_CASE("Flush a gzip_sink mid-stream") {
+    neo::string_dynbuf_io gz_data;
+    neo::gzip_sink        gz_out{gz_data};
+
+    neo::buffer_copy(gz_out, neo::const_buffer("Hello, "));
+    gz_out.flush();
+
+    // Everything written so far can be decompressed, even though the stream is incomplete
+    neo::inflate_decompressor infl;
+    std::string               partial;
+    partial.resize(64);
+    auto gz_str = std::string(gz_data.read_area_view());
+    // Skip the 10-byte gzip header
+    auto res = neo::buffer_transform(infl,
+                                     neo::mutable_buffer(partial),
+                                     neo::const_buffer(gz_str) + 10);
+    partial.resize(res.bytes_written);
+    CHECK(partial == "Hello, ");
+
+    neo::buffer_copy(gz_out, neo::const_buffer("world!"));
+    gz_out.finish();
+    neo::string_dynbuf_io plain;
+    neo::gzip_decompress(plain, gz_data);
+    CHECK(plain.string() == "Hello, world!");
+}
+
+TEST_CASE("Automatically flush a gzip_sink") {
+    neo::string_dynbuf_io gz_data;
+    neo::gzip_sink        gz_out{gz_data,
+                          neo::deflate_options{},
+                          neo::gzip_flush_policy{.max_pending_bytes = 10}};
+
+    neo::buffer_copy(gz_out, neo::const_buffer("Hello"));
+    const auto n_before = gz_data.string().size();
+    neo::buffer_copy(gz_out, neo::const_buffer(", world!"));
+    // We've passed the threshold, so the data has been flushed
+    CHECK(gz_data.string().size() > n_before);
+    gz_out.finish();
+
+    neo::string_dynbuf_io plain;
+    neo::gzip_decompress(plain, gz_data);
+    CHECK(plain.string() == "Hello, world!");
+}
+
+TEST_CASE("Decompress concatenated gzip members") {
+    neo::string_dynbuf_io first;
+    neo::gzip_compress(first, neo::const_buffer("I am the first member. "));
+    neo::string_dynbuf_io second;
+    neo::gzip_compress(second, neo::const_buffer("I am the second member."));
+
+    neo::string_dynbuf_io both;
+    neo::buffer_copy(both, neo::const_buffer(first.read_area_view()));
+    neo::buffer_copy(both, neo::const_buffer(second.read_area_view()));
+
+    // By default, only the first member is decoded
+    neo::string_dynbuf_io one;
+    neo::gzip_decompress(one, neo::const_buffer(both.read_area_view()));
+    CHECK(one.string() == "I am the first member. ");
+
+    neo::string_dynbuf_io plain;
+    neo::gzip_decompress(plain,
+                         neo::const_buffer(both.read_area_view()),
+                         neo::gzip_decompress_options{.multi_member = true});
+    CHECK(plain.string() == "I am the first member. I am the second member.");
+}
+
+TEST_CASE("Reject truncated concatenated gzip members") {
+    neo::string_dynbuf_io first;
+    neo::gzip_compress(first, neo::const_buffer("I am the first member. "));
+    neo::string_dynbuf_io second;
+    neo::gzip_compress(second, neo::const_buffer("I am the second member."));
+    const auto both = std::string(first.read_area_view()) + std::string(second.read_area_view());
+
+    const auto opts = neo::gzip_decompress_options{.multi_member = true};
+    // Cut off part of the header, and then part of the trailer, of the second member
+    const auto cut = GENERATE_COPY(first.read_area_view().size() + 4, both.size() - 3);
+
+    neo::string_dynbuf_io plain;
+    CHECK_THROWS_AS(neo::gzip_decompress(plain, neo::const_buffer(both).first(cut), opts),
+                    std::runtime_error);
+}
+
+TEST_CASE("Size the output of gzip_compress/gzip_decompress up front") {
+    std::string text;
+    for (auto i = 0; i < 50000; ++i) {
+        text += "Line " + std::to_string(i) + " of a large file\n";
+    }
+
+    // Compressing a contiguous buffer reserves deflateBound() once, rather than growing in steps
+    neo::dynbuf_io<std::string> gz_data;
+    neo::gzip_compress(gz_data, neo::const_buffer(text));
+    CHECK(gz_data.storage().size() <= neo::gzip_compress_bound(text.size()));
+    gz_data.shrink_uncommitted();
+    const auto gz_str = gz_data.storage();
+
+    // Decompressing a contiguous buffer reserves exactly the size in the trailer
+    neo::dynbuf_io<std::string> plain;
+    neo::gzip_decompress(plain, neo::const_buffer(gz_str));
+    CHECK(plain.storage().size() == text.size());
+    CHECK(plain.storage() == text);
+
+    // Likewise for a seekable stream
+    std::istringstream          strm{gz_str};
+    neo::dynbuf_io<std::string> from_stream;
+    neo::gzip_decompress(from_stream, neo::iostream_io{strm});
+    CHECK(from_stream.storage().size() == text.size());
+    CHECK(from_stream.storage() == text);
+}
@@ -0,0 +1,142 @@
+#include "./gzip_seek_index.hpp"
+
+#include "./gzip_io.hpp"
+
+#include <neo/string_io.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <sstream>
+
+TEST_CASE("Random access into a gzip file") {
+    std::string text;
+    for (auto i = 0; i < 100000; ++i) {
+        text += "Line " + std::to_string(i * 7919 % 100003) + " of the log file\n";
+    }
+    neo::string_dynbuf_io gz_data;
+    neo::gzip_compress(gz_data, neo::const_buffer(text), neo::deflate_options{.window_bits = 15});
+
+    std::istringstream gz_in{std::string(gz_data.read_area_view())};
+    auto               idx = neo::gzip_seek_index::build(gz_in, 256 * 1024);
+    CHECK(idx.points().size() > 4);
+    CHECK(idx.find(0) == nullptr);
+
+    // Round-trip the index through its serialized form
+    std::stringstream idx_data;
+    idx.write(idx_data);
+    auto idx2 = neo::gzip_seek_index::read(idx_data);
+    REQUIRE(idx2.points().size() == idx.points().size());
+    CHECK(idx2.points().back().window == idx.points().back().window);
+
+    gz_in.clear();
+    neo::gzip_random_access_source in{gz_in, std::move(idx2)};
+
+    auto read_at = [&](std::uint64_t offset, std::size_t size) {
+        in.seek(offset);
+        std::string ret;
+        while (ret.size() < size) {
+            auto part = in.next(size - ret.size());
+            if (part.size() == 0) {
+                break;
+            }
+            ret.append(std::string_view(part));
+            in.consume(part.size());
+        }
+        return ret;
+    };
+
+    CHECK(read_at(text.size() - 100, 100) == text.substr(text.size() - 100));
+    CHECK(read_at(1234567, 200) == text.substr(1234567, 200));
+    CHECK(read_at(12, 200) == text.substr(12, 200));
+    const auto pt_offset = idx.points()[2].uncompressed_offset;
+    CHECK(read_at(pt_offset, 100) == text.substr(pt_offset, 100));
+    CHECK(read_at(pt_offset - 1, 100) == text.substr(pt_offset - 1, 100));
+    CHECK(read_at(text.size(), 100) == "");
+}
+
+TEST_CASE("Build a seek index as part of a decompression") {
+    std::string text;
+    for (auto i = 0; i < 100000; ++i) {
+        text += "Line " + std::to_string(i * 7919 % 100003) + " of the log file\n";
+    }
+    neo::string_dynbuf_io gz_data;
+    neo::gzip_compress(gz_data, neo::const_buffer(text), neo::deflate_options{.window_bits = 15});
+    const auto gz_str = std::string(gz_data.read_area_view());
+
+    std::istringstream gz_in{gz_str};
+    const auto         expect = neo::gzip_seek_index::build(gz_in, 256 * 1024);
+    REQUIRE(expect.points().size() > 1);
+
+    neo::gzip_seek_index_builder builder{256 * 1024};
+    std::string                  plain;
+
+    SECTION("Through a source and a sink") {
+        neo::string_dynbuf_io gz_src;
+        neo::buffer_copy(gz_src, neo::const_buffer(gz_str));
+        neo::string_dynbuf_io out;
+        auto                  res = neo::buffer_transform(builder, out, gz_src);
+        CHECK(res.done);
+        CHECK(res.bytes_read == gz_str.size());
+        plain = std::string(out.read_area_view());
+    }
+
+    SECTION("With output parts that end on an access point") {
+        // Each step must exhaust the input or the output, and a block boundary that lands just as
+        // the output fills must still be recorded.
+        const auto part_size = static_cast<std::size_t>(expect.points()[0].uncompressed_offset);
+        std::string part;
+        part.resize(part_size);
+        auto in = neo::const_buffer(gz_str);
+        while (true) {
+            auto res = neo::buffer_transform(builder, neo::mutable_buffer(part), in);
+            in += res.bytes_read;
+            plain.append(part, 0, res.bytes_written);
+            if (res.done) {
+                break;
+            }
+            REQUIRE(res.bytes_written == part_size);
+        }
+    }
+
+    CHECK(plain == text);
+    const auto& points = builder.index().points();
+    REQUIRE(points.size() == expect.points().size());
+    for (auto i = 0u; i < points.size(); ++i) {
+        CHECK(points[i].compressed_offset == expect.points()[i].compressed_offset);
+        CHECK(points[i].uncompressed_offset == expect.points()[i].uncompressed_offset);
+        CHECK(points[i].bits == expect.points()[i].bits);
+    }
+}
+
+TEST_CASE("Reject a corrupt gzip seek index") {
+    std::string text;
+    for (auto i = 0; i < 100000; ++i) {
+        text += "Line " + std::to_string(i * 7919 % 100003) + " of the log file\n";
+    }
+    neo::string_dynbuf_io gz_data;
+    neo::gzip_compress(gz_data, neo::const_buffer(text), neo::deflate_options{.window_bits = 15});
+
+    std::istringstream gz_in{std::string(gz_data.read_area_view())};
+    auto               idx = neo::gzip_seek_index::build(gz_in, 256 * 1024);
+    REQUIRE(idx.points().size() > 0);
+
+    std::stringstream idx_out;
+    idx.write(idx_out);
+    auto idx_data = idx_out.str();
+
+    SECTION("A window that claims to compress to 4 GiB") {
+        // The compressed size of the first window follows the 24-byte file header and the 21
+        // bytes of offsets, bits, and window size
+        std::fill_n(idx_data.begin() + 24 + 21, 4, '\xff');
+        std::istringstream in{idx_data};
+        CHECK_THROWS_WITH(neo::gzip_seek_index::read(in),
+                          Catch::Contains("Invalid access point"));
+    }
+
+    SECTION("An index that ends part-way through a window") {
+        idx_data.resize(24 + 25 + 10);
+        std::istringstream in{idx_data};
+        CHECK_THROWS_WITH(neo::gzip_seek_index::read(in), Catch::Contains("Unexpected end"));
+    }
+}
@@ -13,6 +13,11 @@
 static const auto ROOT_DIR_PATH
     = std::filesystem::path(__FILE__).append("../../..").lexically_normal();
 
+// inflate_decompressor is a class that users may forward-declare
+namespace neo {
+class inflate_decompressor;
+}  // namespace neo
+
 TEST_CASE("Compress some data") {
     std::string defl_str;
     defl_str.resize(50);
@@ -0,0 +1,375 @@
+#include "./one_shot.hpp"
+
+#include "./crc32.hpp"
+#include "./fast_inflate.hpp"
+
+#include <neo/assert.hpp>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <climits>
+#include <initializer_list>
+#include <istream>
+#include <stdexcept>
+
+using namespace neo;
+
+namespace {
+
+// ID1, ID2, CM, FLG, MTIME, XFL, and OS
+constexpr std::size_t gzip_header_size = 10;
+// CRC32 and ISIZE
+constexpr std::size_t gzip_trailer_size = 8;
+
+// DEFLATE cannot expand data by more than this factor, so a larger ISIZE is not believed
+constexpr std::size_t max_inflate_ratio = 1032;
+
+// The same header that gzip_compressor writes
+const std::byte gzip_header[gzip_header_size] = {
+    std::byte(0x1f),
+    std::byte(0x8b),
+    std::byte(0x08),
+    std::byte(0x00),
+    std::byte(0xde),
+    std::byte(0xad),
+    std::byte(0xbe),
+    std::byte(0xef),
+    std::byte(0x00),
+    std::byte(0xff),
+};
+
+std::uint32_t load_le32(const std::byte* p) noexcept {
+    return std::uint32_t(p[0]) | (std::uint32_t(p[1]) << 8) | (std::uint32_t(p[2]) << 16)
+        | (std::uint32_t(p[3]) << 24);
+}
+
+void store_le32(std::byte* p, std::uint32_t v) noexcept {
+    p[0] = std::byte(v);
+    p[1] = std::byte(v >> 8);
+    p[2] = std::byte(v >> 16);
+    p[3] = std::byte(v >> 24);
+}
+
+[[noreturn]] void throw_output_too_small() {
+    throw std::runtime_error("Output buffer is too small for the one-shot (de)compression result");
+}
+
+/**
+ * A zlib deflate stream that is kept for reuse by the calling thread. It is
+ * only re-initialized if the window size or memory level changes.
+ */
+class cached_deflate_stream {
+    ::z_stream      _strm{};
+    bool            _initialized = false;
+    deflate_options _opts;
+
+public:
+    cached_deflate_stream() = default;
+    ~cached_deflate_stream() {
+        if (_initialized) {
+            ::deflateEnd(&_strm);
+        }
+    }
+
+    cached_deflate_stream(const cached_deflate_stream&) = delete;
+    cached_deflate_stream& operator=(const cached_deflate_stream&) = delete;
+
+    ::z_stream& get(const deflate_options& opts) {
+        neo_assert(expects,
+                   opts.level >= Z_DEFAULT_COMPRESSION && opts.level <= 9,
+                   "Invalid deflate compression level",
+                   opts.level);
+        neo_assert(expects,
+                   opts.window_bits >= 9 && opts.window_bits <= 15,
+                   "Invalid deflate window size",
+                   opts.window_bits);
+        neo_assert(expects,
+                   opts.mem_level >= 1 && opts.mem_level <= 9,
+                   "Invalid deflate memory level",
+                   opts.mem_level);
+        if (_initialized && _opts.window_bits == opts.window_bits
+            && _opts.mem_level == opts.mem_level) {
+            ::deflateReset(&_strm);
+            if (_opts.level != opts.level || _opts.strategy != opts.strategy) {
+                // No data has been given since the reset, so this cannot fail for lack of space
+                auto rc = ::deflateParams(&_strm, opts.level, static_cast<int>(opts.strategy));
+                neo_assert(invariant, rc == Z_OK, "deflateParams() failed unexpectedly", rc);
+            }
+            _opts = opts;
+            return _strm;
+        }
+        if (_initialized) {
+            ::deflateEnd(&_strm);
+            _initialized = false;
+        }
+        _strm   = ::z_stream{};
+        auto rc = ::deflateInit2(&_strm,
+                                 opts.level,
+                                 Z_DEFLATED,
+                                 -opts.window_bits,
+                                 opts.mem_level,
+                                 static_cast<int>(opts.strategy));
+        if (rc == Z_MEM_ERROR) {
+            throw std::bad_alloc();
+        } else if (rc != Z_OK) {
+            throw std::runtime_error("Failed to initialize the DEFLATE compressor");
+        }
+        _initialized = true;
+        _opts        = opts;
+        return _strm;
+    }
+};
+
+::z_stream& thread_deflate_stream(const deflate_options& opts) {
+    thread_local cached_deflate_stream strm;
+    return strm.get(opts);
+}
+
+fast_inflate_decompressor& thread_inflater() {
+    thread_local fast_inflate_decompressor infl;
+    infl.reset();
+    return infl;
+}
+
+/**
+ * An output for decompression. If `growable` is set, the output is resized as
+ * needed. Otherwise, running out of space is an error.
+ */
+struct output_area {
+    mutable_buffer          buf;
+    std::vector<std::byte>* growable = nullptr;
+    std::size_t             n_written = 0;
+
+    mutable_buffer remaining() const noexcept { return buf + n_written; }
+
+    void grow() {
+        if (!growable) {
+            throw_output_too_small();
+        }
+        growable->resize(std::max(growable->size() * 2, std::size_t(1024)));
+        buf = mutable_buffer(growable->data(), growable->size());
+    }
+};
+
+/**
+ * Inflate the DEFLATE stream at the beginning of `in` into `out`. Returns the
+ * size of the DEFLATE stream.
+ */
+std::size_t inflate_into(output_area& out, const_buffer in) {
+    auto&      infl    = thread_inflater();
+    const auto in_size = in.size();
+    while (true) {
+        auto res = infl(out.remaining(), in);
+        out.n_written += res.bytes_written;
+        in += res.bytes_read;
+        if (res.done) {
+            return in_size - in.size();
+        }
+        if (out.remaining().empty()) {
+            out.grow();
+        } else {
+            throw std::runtime_error("Unexpected end of DEFLATE data");
+        }
+    }
+}
+
+/// Obtain the size of the gzip header at the beginning of `in`
+std::size_t gzip_header_length(const_buffer in) {
+    if (in.size() < gzip_header_size) {
+        throw std::runtime_error("Truncated gzip header");
+    }
+    if (in[0] != std::byte(0x1f) || in[1] != std::byte(0x8b)) {
+        throw std::runtime_error("Invalid gzip header (bad magic number)");
+    }
+    if (in[2] != std::byte(0x08)) {
+        throw std::runtime_error("Unsupported gzip compression method");
+    }
+    const auto  flags = std::uint8_t(in[3]);
+    std::size_t pos   = gzip_header_size;
+    auto        need  = [&](std::size_t n) {
+        if (in.size() - pos < n) {
+            throw std::runtime_error("Truncated gzip header");
+        }
+    };
+    if (flags & 0x04) {
+        // FEXTRA
+        need(2);
+        const auto xlen = std::size_t(in[pos]) | (std::size_t(in[pos + 1]) << 8);
+        pos += 2;
+        need(xlen);
+        pos += xlen;
+    }
+    // FNAME and FCOMMENT are nul-terminated
+    for (auto flag : {0x08, 0x10}) {
+        if (flags & flag) {
+            auto rest = in + pos;
+            auto nul  = std::find(rest.data(), rest.data() + rest.size(), std::byte(0));
+            need(std::size_t(nul - rest.data()) + 1);
+            pos += std::size_t(nul - rest.data()) + 1;
+        }
+    }
+    if (flags & 0x02) {
+        // FHCRC
+        need(2);
+        pos += 2;
+    }
+    return pos;
+}
+
+std::size_t
+gzip_decompress_into(output_area& out, const_buffer in, bool multi_member, bool verify) {
+    do {
+        const auto header_len = gzip_header_length(in);
+        in += header_len;
+        const auto member_begin = out.n_written;
+        in += inflate_into(out, in);
+        if (in.size() < gzip_trailer_size) {
+            throw std::runtime_error("Truncated gzip trailer");
+        }
+        if (verify) {
+            const auto member_size = out.n_written - member_begin;
+            const auto crc = crc32::calc(const_buffer(out.buf.data() + member_begin, member_size));
+            if (crc != load_le32(in.data())) {
+                throw std::runtime_error("gzip CRC-32 mismatch");
+            }
+            if (static_cast<std::uint32_t>(member_size) != load_le32(in.data() + 4)) {
+                throw std::runtime_error("gzip size mismatch");
+            }
+        }
+        in += gzip_trailer_size;
+    } while (multi_member && !in.empty());
+    return out.n_written;
+}
+
+}  // namespace
+
+std::size_t neo::deflate_bound(std::size_t in_size, const deflate_options& opts) {
+    auto& strm = thread_deflate_stream(opts);
+    return ::deflateBound(&strm, static_cast<::uLong>(in_size));
+}
+
+std::size_t neo::gzip_compress_bound(std::size_t in_size, const deflate_options& opts) {
+    return gzip_header_size + deflate_bound(in_size, opts) + gzip_trailer_size;
+}
+
+std::size_t neo::deflate_buffer(mutable_buffer out, const_buffer in, const deflate_options& opts) {
+    auto&      strm     = thread_deflate_stream(opts);
+    const auto out_size = out.size();
+    // zlib's counts are 32 bits wide, so very large buffers are given in pieces
+    constexpr std::size_t max_piece = UINT_MAX;
+    while (true) {
+        const auto in_piece  = std::min(in.size(), max_piece);
+        const auto out_piece = std::min(out.size(), max_piece);
+        strm.next_in         = const_cast<::Bytef*>(reinterpret_cast<const ::Bytef*>(in.data()));
+        strm.avail_in        = static_cast<::uInt>(in_piece);
+        strm.next_out        = reinterpret_cast<::Bytef*>(out.data());
+        strm.avail_out       = static_cast<::uInt>(out_piece);
+        auto rc = ::deflate(&strm, in_piece == in.size() ? Z_FINISH : Z_NO_FLUSH);
+        neo_assert(invariant,
+                   rc == Z_OK || rc == Z_STREAM_END || rc == Z_BUF_ERROR,
+                   "deflate() failed unexpectedly",
+                   rc);
+        in += in_piece - strm.avail_in;
+        out += out_piece - strm.avail_out;
+        if (rc == Z_STREAM_END) {
+            return out_size - out.size();
+        }
+        if (out.empty()) {
+            throw_output_too_small();
+        }
+    }
+}
+
+std::vector<std::byte> neo::deflate_buffer(const_buffer in, const deflate_options& opts) {
+    std::vector<std::byte> ret;
+    ret.resize(deflate_bound(in.size(), opts));
+    ret.resize(deflate_buffer(mutable_buffer(ret.data(), ret.size()), in, opts));
+    return ret;
+}
+
+std::size_t neo::inflate_buffer(mutable_buffer out, const_buffer in) {
+    output_area area{out};
+    inflate_into(area, in);
+    return area.n_written;
+}
+
+std::vector<std::byte> neo::inflate_buffer(const_buffer in) {
+    // A guess. Text typically compresses by a factor of three or four.
+    std::vector<std::byte> ret;
+    ret.resize(std::max(in.size() * 4, std::size_t(1024)));
+    output_area area{mutable_buffer(ret.data(), ret.size()), &ret};
+    inflate_into(area, in);
+    ret.resize(area.n_written);
+    return ret;
+}
+
+std::size_t
+neo::gzip_compress_buffer(mutable_buffer out, const_buffer in, const deflate_options& opts) {
+    if (out.size() < gzip_header_size + gzip_trailer_size) {
+        throw_output_too_small();
+    }
+    std::copy_n(gzip_header, gzip_header_size, out.data());
+    auto body     = mutable_buffer(out.data() + gzip_header_size,
+                               out.size() - gzip_header_size - gzip_trailer_size);
+    auto body_len = deflate_buffer(body, in, opts);
+    auto trailer  = out.data() + gzip_header_size + body_len;
+    store_le32(trailer, crc32::calc(in));
+    store_le32(trailer + 4, static_cast<std::uint32_t>(in.size()));
+    return gzip_header_size + body_len + gzip_trailer_size;
+}
+
+std::vector<std::byte> neo::gzip_compress_buffer(const_buffer in, const deflate_options& opts) {
+    std::vector<std::byte> ret;
+    ret.resize(gzip_compress_bound(in.size(), opts));
+    ret.resize(gzip_compress_buffer(mutable_buffer(ret.data(), ret.size()), in, opts));
+    return ret;
+}
+
+std::size_t neo::gzip_decompress_buffer(mutable_buffer                 out,
+                                        const_buffer                   in,
+                                        const gzip_decompress_options& opts) {
+    output_area area{out};
+    return gzip_decompress_into(area, in, opts.multi_member, opts.verify_checksum);
+}
+
+std::vector<std::byte> neo::gzip_decompress_buffer(const_buffer                   in,
+                                                   const gzip_decompress_options& opts) {
+    std::vector<std::byte> ret;
+    // For a single member the hint is usually exact. If not, the output grows as usual.
+    const auto size_hint = gzip_output_size_hint(in).value_or(0);
+    ret.resize(std::max(size_hint, std::size_t(1024)));
+    output_area area{mutable_buffer(ret.data(), ret.size()), &ret};
+    ret.resize(gzip_decompress_into(area, in, opts.multi_member, opts.verify_checksum));
+    return ret;
+}
+
+std::optional<std::size_t> neo::gzip_output_size_hint(const_buffer gz) {
+    if (gz.size() < gzip_header_size + gzip_trailer_size) {
+        return std::nullopt;
+    }
+    const std::size_t isize = load_le32(gz.data() + gz.size() - 4);
+    return std::min(isize, gz.size() * max_inflate_ratio);
+}
+
+std::optional<std::size_t> neo::gzip_output_size_hint(std::istream& gz) {
+    const auto pos = gz.tellg();
+    if (pos == std::istream::pos_type(-1)) {
+        return std::nullopt;
+    }
+    std::optional<std::size_t> ret;
+    gz.seekg(0, std::ios::end);
+    const auto end = gz.tellg();
+    if (end != std::istream::pos_type(-1)
+        && std::size_t(end - pos) >= gzip_header_size + gzip_trailer_size) {
+        std::byte isize[4];
+        gz.seekg(-4, std::ios::end);
+        if (gz.read(reinterpret_cast<char*>(isize), sizeof isize)) {
+            const auto in_size = std::size_t(end - pos);
+            ret = std::min(std::size_t(load_le32(isize)), in_size * max_inflate_ratio);
+        }
+    }
+    gz.clear();
+    gz.seekg(pos);
+    return ret;
+}
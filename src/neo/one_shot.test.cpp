@@ -0,0 +1,83 @@
+#include <neo/one_shot.hpp>
+
+#include <neo/gzip_io.hpp>
+
+#include <neo/dynbuf_io.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace {
+
+std::string make_text() {
+    std::string text;
+    for (auto i = 0; i < 2000; ++i) {
+        text += "Response " + std::to_string(i % 31) + " from a service that sends JSON bodies\n";
+    }
+    return text;
+}
+
+std::string as_string(const std::vector<std::byte>& v) {
+    return std::string(reinterpret_cast<const char*>(v.data()), v.size());
+}
+
+}  // namespace
+
+TEST_CASE("Deflate and inflate a whole buffer") {
+    const auto text  = make_text();
+    auto       level = GENERATE(0, 1, 9);
+
+    const auto opts = neo::deflate_options{.level = level};
+
+    auto compressed = neo::deflate_buffer(neo::const_buffer(text), opts);
+    CHECK(compressed.size() <= neo::deflate_bound(text.size(), opts));
+    auto plain = neo::inflate_buffer(neo::const_buffer(compressed.data(), compressed.size()));
+    CHECK(as_string(plain) == text);
+
+    // Decompress into a buffer of exactly the right size
+    std::string exact(text.size(), '\0');
+    auto n = neo::inflate_buffer(neo::mutable_buffer(exact),
+                                 neo::const_buffer(compressed.data(), compressed.size()));
+    CHECK(n == text.size());
+    CHECK(exact == text);
+
+    // A buffer that is too small is an error
+    std::string small(text.size() / 2, '\0');
+    CHECK_THROWS(neo::inflate_buffer(neo::mutable_buffer(small),
+                                     neo::const_buffer(compressed.data(), compressed.size())));
+}
+
+TEST_CASE("gzip a whole buffer") {
+    const auto text = make_text();
+
+    auto gzipped = neo::gzip_compress_buffer(neo::const_buffer(text));
+    CHECK(gzipped.size() <= neo::gzip_compress_bound(text.size()));
+
+    // The result can be read by the streaming decompressor
+    neo::string_dynbuf_io streamed;
+    neo::gzip_decompress(streamed, neo::const_buffer(gzipped.data(), gzipped.size()));
+    CHECK(streamed.string() == text);
+
+    auto plain = neo::gzip_decompress_buffer(neo::const_buffer(gzipped.data(), gzipped.size()));
+    CHECK(as_string(plain) == text);
+
+    // Corruption is detected by the CRC check
+    gzipped[gzipped.size() - 6] ^= std::byte(1);
+    CHECK_THROWS(neo::gzip_decompress_buffer(neo::const_buffer(gzipped.data(), gzipped.size())));
+}
+
+TEST_CASE("Decompress a gzip buffer from the streaming compressor") {
+    const auto            text = make_text();
+    neo::string_dynbuf_io gz_data;
+    neo::gzip_compress(gz_data, neo::const_buffer(text));
+    auto gzipped = std::string(gz_data.read_area_view());
+
+    // Two concatenated members
+    auto both  = gzipped + gzipped;
+    auto plain = neo::gzip_decompress_buffer(neo::const_buffer(both),
+                                             neo::gzip_decompress_options{.multi_member = true});
+    CHECK(as_string(plain) == text + text);
+
+    // Without multi_member, only the first member is decoded
+    plain = neo::gzip_decompress_buffer(neo::const_buffer(both));
+    CHECK(as_string(plain) == text);
+}
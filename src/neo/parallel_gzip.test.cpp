@@ -0,0 +1,153 @@
+#include <neo/parallel_gzip.hpp>
+
+#include <neo/bgzf.hpp>
+#include <neo/gzip.hpp>
+#include <neo/gzip_io.hpp>
+#include <neo/inflate.hpp>
+
+#include <neo/dynbuf_io.hpp>
+#include <neo/string_io.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace {
+
+std::string make_text() {
+    std::string text;
+    for (auto i = 0; i < 20000; ++i) {
+        text += "Line " + std::to_string(i % 97) + " of a build log that needs compressing\n";
+    }
+    return text;
+}
+
+}  // namespace
+
+TEST_CASE("Compress in parallel and decompress with gzip_decompressor") {
+    const auto text = make_text();
+
+    auto threads    = GENERATE(1u, 4u);
+    auto block_size = GENERATE(std::size_t(1000), std::size_t(64 * 1024));
+
+    neo::parallel_gzip_compressor comp{neo::parallel_gzip_options{
+        .thread_count = threads,
+        .block_size   = block_size,
+    }};
+    neo::dynbuf_io<std::string> gzipped;
+    auto res = neo::buffer_transform(comp, gzipped, neo::const_buffer(text));
+    res += neo::buffer_transform(comp, gzipped, neo::const_buffer(), neo::flush::finish);
+    gzipped.shrink_uncommitted();
+    CHECK(res.done);
+    CHECK(res.bytes_read == text.size());
+    CHECK(res.bytes_written == gzipped.storage().size());
+    // Priming each block with a dictionary keeps the ratio close to serial compression
+    CHECK(gzipped.storage().size() < text.size() / 4);
+
+    neo::gzip_decompressor<neo::inflate_decompressor> decomp;
+    neo::dynbuf_io<std::string>                       plain;
+    auto decomp_res = neo::buffer_transform(decomp, plain, neo::const_buffer(gzipped.storage()));
+    plain.shrink_uncommitted();
+    CHECK(decomp_res.done);
+    CHECK(plain.storage() == text);
+}
+
+TEST_CASE("Compress an empty stream in parallel") {
+    neo::parallel_gzip_compressor comp;
+    neo::dynbuf_io<std::string>   gzipped;
+    auto res = neo::buffer_transform(comp, gzipped, neo::const_buffer(), neo::flush::finish);
+    CHECK(res.done);
+
+    neo::string_dynbuf_io plain;
+    gzipped.shrink_uncommitted();
+    neo::gzip_decompress(plain, neo::const_buffer(gzipped.storage()));
+    CHECK(plain.string() == "");
+}
+
+TEST_CASE("Write through a parallel_gzip_sink") {
+    const auto            text = make_text();
+    neo::string_dynbuf_io gz_data;
+    neo::parallel_gzip_sink gz_out{gz_data, neo::parallel_gzip_options{.block_size = 4096}};
+    neo::buffer_copy(gz_out, neo::const_buffer(text));
+    gz_out.finish();
+
+    neo::string_dynbuf_io plain;
+    neo::gzip_decompress(plain, gz_data);
+    CHECK(plain.string() == text);
+}
+
+TEST_CASE("Decompress BGZF data in parallel") {
+    const auto            text = make_text();
+    neo::string_dynbuf_io bgzf_data;
+    neo::bgzf_sink        out{bgzf_data};
+    neo::buffer_copy(out, neo::const_buffer(text));
+    out.finish();
+
+    auto threads = GENERATE(1u, 4u);
+
+    neo::parallel_gzip_source gz_in{bgzf_data,
+                                    neo::parallel_gzip_decompress_options{.thread_count = threads}};
+    neo::string_dynbuf_io     plain;
+    neo::buffer_copy(plain, gz_in);
+    CHECK(plain.string() == text);
+}
+
+TEST_CASE("Decompress concatenated gzip members in parallel") {
+    const auto text = make_text();
+
+    std::string gzipped;
+    std::string expect;
+    for (auto i = 0; i < 8; ++i) {
+        auto part = text.substr(0, text.size() / (i + 1));
+        if (i % 2) {
+            // Stored blocks embed the gzip magic number in the compressed data, which must not be
+            // mistaken for the start of a member
+            part += "\x1f\x8b\x08";
+            part += '\0';
+        }
+        neo::string_dynbuf_io member;
+        neo::gzip_compress(member,
+                           neo::const_buffer(part),
+                           neo::deflate_options{.level = i % 2 ? 0 : 5});
+        gzipped += member.read_area_view();
+        expect += part;
+    }
+
+    neo::string_dynbuf_io gz_data;
+    neo::buffer_copy(gz_data, neo::const_buffer(gzipped));
+
+    neo::parallel_gzip_source gz_in{gz_data};
+    neo::string_dynbuf_io     plain;
+    neo::buffer_copy(plain, gz_in);
+    CHECK(plain.string() == expect);
+}
+
+TEST_CASE("Decompress a single large gzip member with parallel_gzip_source") {
+    const auto            text = make_text();
+    neo::string_dynbuf_io gz_data;
+    neo::gzip_compress(gz_data, neo::const_buffer(text));
+
+    // A small member limit forces the sequential fallback
+    auto max_member_size = GENERATE(std::size_t(1024), std::size_t(1024 * 1024));
+
+    neo::parallel_gzip_source gz_in{gz_data,
+                                    neo::parallel_gzip_decompress_options{
+                                        .max_member_size = max_member_size,
+                                    }};
+    neo::string_dynbuf_io     plain;
+    neo::buffer_copy(plain, gz_in);
+    CHECK(plain.string() == text);
+}
+
+TEST_CASE("Truncated input to parallel_gzip_source") {
+    const auto            text = make_text();
+    neo::string_dynbuf_io gz_data;
+    neo::gzip_compress(gz_data, neo::const_buffer(text));
+    auto truncated = std::string(gz_data.read_area_view());
+    truncated.resize(truncated.size() / 2);
+
+    neo::string_dynbuf_io truncated_data;
+    neo::buffer_copy(truncated_data, neo::const_buffer(truncated));
+
+    neo::parallel_gzip_source gz_in{truncated_data};
+    neo::string_dynbuf_io     plain;
+    CHECK_THROWS(neo::buffer_copy(plain, gz_in));
+}
@@ -1,9 +1,12 @@
 #include <neo/tar/ustar.hpp>
 
+#include <neo/tar/observer.hpp>
+
 #include <neo/as_buffer.hpp>
 #include <neo/iostream_io.hpp>
 #include <neo/platform.hpp>
 
+#include <algorithm>
 #include <fstream>
 
 namespace fs = std::filesystem;
@@ -53,9 +56,41 @@ auto get_file_unix_mtime(const fs::path& fpath) {
     return (win_mtime - unix_time_start) / win_ticks_per_second;
 }
 
+/// Copy the contents of the file into the current member of the archive
+void copy_file_data(detail::ustar_writer_base& out,
+                    const fs::path&            filepath,
+                    std::uint64_t /* size */,
+                    tar_member_event& event,
+                    tar_observer*     observer) {
+    std::ifstream infile;
+    infile.exceptions(infile.exceptions() | std::ios::badbit);
+    detail::observe_time(observer, event.open_time, [&] {
+        infile.open(filepath, std::ios::binary);
+    });
+
+    while (1) {
+        thread_local std::array<char, 1024 * 1024 * 4> buffer;
+        auto n_read = detail::observe_time(observer, event.read_time, [&] {
+            return buffer_ios_read(infile, neo::as_buffer(buffer));
+        });
+        if (n_read == 0) {
+            break;
+        }
+        detail::observe_time(observer, event.write_time, [&] {
+            out.write_member_data(neo::as_buffer(buffer, n_read));
+        });
+        event.data_bytes += n_read;
+    }
+
+    detail::observe_time(observer, event.close_time, [&] { infile.close(); });
+}
+
 }  // namespace
 #elif NEO_OS_IS_UNIX_LIKE
+#include <fcntl.h>
 #include <sys/stat.h>
+#include <unistd.h>
+
 namespace {
 
 auto get_file_unix_mtime(const fs::path& fpath) {
@@ -68,12 +103,98 @@ auto get_file_unix_mtime(const fs::path& fpath) {
     return status.st_mtime;
 }
 
+// The most file data to read into the archive's output at once
+constexpr std::uint64_t read_chunk_size = 1024 * 1024 * 4;
+
+[[noreturn]] void throw_file_error(const fs::path& fpath, const char* what) {
+    throw std::system_error(std::error_code(errno, std::system_category()),
+                            what + (" [" + fpath.string() + "]"));
+}
+
+/**
+ * Copy the contents of the file into the current member of the archive. This
+ * bypasses iostreams and read()s the file straight into the archive's output
+ * buffer, so the data is copied once, from the page cache. The file is not
+ * mapped into memory: Another process truncating it during the copy would
+ * raise SIGBUS, where read() reports the short file as an error.
+ */
+void copy_file_data(detail::ustar_writer_base& out,
+                    const fs::path&            filepath,
+                    std::uint64_t              size,
+                    tar_member_event&          event,
+                    tar_observer*              observer) {
+    struct fd_closer {
+        int fd;
+        ~fd_closer() {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+    };
+
+    const int fd = detail::observe_time(observer, event.open_time, [&] {
+        return ::open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+    });
+    if (fd < 0) {
+        throw_file_error(filepath, "Failed to open file to add to the archive");
+    }
+    fd_closer closer{fd};
+
+    struct ::stat status {};
+    if (::fstat(fd, &status) != 0) {
+        throw_file_error(filepath, "Failed to stat() file to add to the archive");
+    }
+    if (static_cast<std::uint64_t>(status.st_size) != size) {
+        throw std::runtime_error("File changed size while it was being archived ["s
+                                 + filepath.string() + "]");
+    }
+#ifdef POSIX_FADV_SEQUENTIAL
+    // We read the file once, front to back
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    while (event.data_bytes < size) {
+        const auto n_want = static_cast<std::size_t>(
+            std::min(read_chunk_size, size - event.data_bytes));
+        // The output may offer more room than we asked for
+        auto area = detail::observe_time(observer, event.write_time, [&] {
+            return out.prepare_member_data(n_want);
+        });
+        area = area.first(std::min(area.size(), n_want));
+        if (area.size() == 0) {
+            throw std::runtime_error("Failed to prepare room for member data in the archive ["s
+                                     + filepath.string() + "]");
+        }
+        auto n_read = detail::observe_time(observer, event.read_time, [&] {
+            return ::read(fd, area.data(), area.size());
+        });
+        if (n_read < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n_read < 0) {
+            throw_file_error(filepath, "Failed to read file to add to the archive");
+        }
+        if (n_read == 0) {
+            throw std::runtime_error("File changed size while it was being archived ["s
+                                     + filepath.string() + "]");
+        }
+        detail::observe_time(observer, event.write_time, [&] {
+            out.commit_member_data(static_cast<std::size_t>(n_read));
+        });
+        event.data_bytes += static_cast<std::uint64_t>(n_read);
+    }
+
+    closer.fd = -1;
+    detail::observe_time(observer, event.close_time, [&] { ::close(fd); });
+}
+
 }  // namespace
 #else
 #error "We're not sure how to compile for this platform. Please submit a GitHub issue."
 #endif
 
-void neo::detail::ustar_writer_base::add_file(std::string_view dest, const fs::path& filepath) {
+ustar_member_info neo::detail::make_ustar_member_info(std::string_view dest,
+                                                     const fs::path&  filepath) {
     fs::directory_entry info{filepath};
 
     ustar_member_info mem;
@@ -110,9 +231,7 @@ void neo::detail::ustar_writer_base::add_file(std::string_view dest, const fs::p
     if (info.is_directory()) {
         mem.mode     = 0b111'111'101;
         mem.typeflag = mem.directory;
-        write_member_header(mem);
-        finish_member();
-        return;
+        return mem;
     }
 
     if (info.is_symlink()) {
@@ -124,9 +243,7 @@ void neo::detail::ustar_writer_base::add_file(std::string_view dest, const fs::p
         }
         mem.set_linkname(target);
         mem.typeflag = mem.symlink;
-        write_member_header(mem);
-        finish_member();
-        return;
+        return mem;
     }
 
     if (!info.is_regular_file()) {
@@ -137,22 +254,32 @@ void neo::detail::ustar_writer_base::add_file(std::string_view dest, const fs::p
 
     mem.size     = info.file_size();
     mem.typeflag = mem.regular_file;
-    write_member_header(mem);
+    return mem;
+}
 
-    std::ifstream infile;
-    infile.exceptions(infile.exceptions() | std::ios::badbit);
-    infile.open(filepath, std::ios::binary);
+void neo::detail::ustar_writer_base::add_file(std::string_view dest,
+                                              const fs::path&  filepath,
+                                              tar_observer*    observer) {
+    add_member(make_ustar_member_info(dest, filepath), filepath, observer);
+}
 
-    while (1) {
-        thread_local std::array<char, 1024 * 1024 * 4> buffer;
-        auto n_read = buffer_ios_read(infile, neo::as_buffer(buffer));
-        if (n_read == 0) {
-            break;
-        }
-        write_member_data(neo::as_buffer(buffer, n_read));
+void neo::detail::ustar_writer_base::add_member(const ustar_member_info& mem,
+                                                const fs::path&          filepath,
+                                                tar_observer*            observer) {
+    write_member_header(mem);
+    if (observer) {
+        observer->on_member_header(mem);
+    }
+
+    tar_member_event event{.info = mem, .path = filepath};
+    if (mem.is_regular_file()) {
+        copy_file_data(*this, filepath, mem.size, event, observer);
     }
 
     finish_member();
+    if (observer) {
+        observer->on_member_done(event);
+    }
 }
 
 ustar_header_decoder::result ustar_header_decoder::operator()(const_buffer cb) {
@@ -13,14 +13,18 @@
 
 #include <array>
 #include <charconv>
+#include <concepts>
 #include <cstddef>
 #include <cstring>
 #include <filesystem>
+#include <iterator>
 #include <limits>
 #include <optional>
 
 namespace neo {
 
+class tar_observer;
+
 struct ustar_member_info {
     enum type_t : char {
         none,
@@ -124,9 +128,39 @@ public:
     virtual std::uint64_t write_member_data(const_buffer data)               = 0;
     virtual void          finish_member()                                    = 0;
 
-    void add_file(std::string_view dest, const std::filesystem::path&);
+    /**
+     * Obtain a buffer of the output, of up to `n` bytes, into which member data
+     * can be written directly. The data becomes part of the member when it is
+     * given to commit_member_data().
+     */
+    virtual mutable_buffer prepare_member_data(std::size_t n) = 0;
+    /// Commit `n` bytes of member data that were written to prepare_member_data()
+    virtual void commit_member_data(std::size_t n) = 0;
+
+    /**
+     * Add the file, directory, or symlink at the given path as a member named
+     * `dest`. If `observer` is given, it receives the events for the member.
+     */
+    void add_file(std::string_view             dest,
+                  const std::filesystem::path& filepath,
+                  tar_observer*                observer = nullptr);
+
+    /**
+     * Write a member with the given header. If it is a regular file, the member
+     * data is read from `filepath`.
+     */
+    void add_member(const ustar_member_info&     info,
+                    const std::filesystem::path& filepath,
+                    tar_observer*                observer = nullptr);
 };
 
+/**
+ * Create the header for a member named `dest` from the file, directory, or
+ * symlink at the given path.
+ */
+ustar_member_info make_ustar_member_info(std::string_view             dest,
+                                         const std::filesystem::path& filepath);
+
 }  // namespace detail
 
 class ustar_header_decoder {
@@ -305,6 +339,21 @@ public:
         return n_written;
     }
 
+    mutable_buffer prepare_member_data(std::size_t n) final {
+        auto&& area = output().prepare(n);
+        if constexpr (std::convertible_to<decltype(area), mutable_buffer>) {
+            return mutable_buffer(area);
+        } else {
+            auto it = std::begin(area);
+            return it == std::end(area) ? mutable_buffer() : mutable_buffer(*it);
+        }
+    }
+
+    void commit_member_data(std::size_t n) final {
+        output().commit(n);
+        _member_data_written += n;
+    }
+
     template <buffer_input In>
     std::uint64_t write_member_data(In&& in) {
         auto n_written = buffer_copy(output(), in);
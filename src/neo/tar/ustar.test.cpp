@@ -114,3 +114,28 @@ TEST_CASE("Add files to an archive from the filesystem") {
     CHECK(mem2.size == mem.size);
     CHECK(std::string_view(reader.all_data()) == content);
 }
+
+TEST_CASE("Archived file data matches the files on disk") {
+    // A small file is copied with one read(), and a large file with several
+    auto size     = GENERATE(std::size_t(1000), std::size_t(1024 * 1024 * 9 + 17));
+    auto filepath = std::filesystem::temp_directory_path()
+        / ("neo-ustar-test-" + std::to_string(size) + ".txt");
+    std::string expected;
+    for (auto i = 0; expected.size() < size; ++i) {
+        expected += "Line " + std::to_string(i) + " of a file to archive\n";
+    }
+    expected.resize(size);
+    std::ofstream{filepath, std::ios::binary} << expected;
+
+    std::string    out_str;
+    neo::dynbuf_io io{out_str};
+
+    neo::ustar_writer writer{io};
+    writer.add_file("file", filepath);
+    std::filesystem::remove(filepath);
+
+    neo::ustar_reader reader{io};
+    const auto        mem = reader.next_member().value();
+    CHECK(mem.size == expected.size());
+    CHECK(std::string_view(reader.all_data()) == expected);
+}
@@ -4,6 +4,9 @@
 #include "../gzip.hpp"
 #include "../gzip_io.hpp"
 #include "../inflate.hpp"
+#include "../parallel_gzip.hpp"
+#include "../zstd_io.hpp"
+#include "../detail/thread_pool.hpp"
 #include "./ustar.hpp"
 
 #include <neo/as_buffer.hpp>
@@ -11,8 +14,15 @@
 #include <neo/transform_io.hpp>
 #include <neo/ufmt.hpp>
 
+#include <algorithm>
+#include <deque>
 #include <fstream>
+#include <future>
+#include <memory>
+#include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 #if !NEO_OS_IS_WINDOWS
 #include <sys/stat.h>
@@ -46,50 +56,364 @@ void restore_permissions(const fs::path&          file,
 
 }  // namespace
 
-void neo::compress_directory_targz(const fs::path& directory, const fs::path& targz_dest) {
-    // Open the file for writing:
-    std::ofstream out;
-    out.exceptions(out.exceptions() | std::ios::badbit | std::ios::failbit);
-    out.open(targz_dest, std::ios::binary);
+namespace {
 
-    // Compression pipeline:
-    gzip_sink    gz_out{iostream_io{out}};
-    ustar_writer tar_writer{gz_out};
+/**
+ * Running totals for a tar pipeline, reported to the observer (if there is one)
+ * as progress.
+ */
+class progress_tracker {
+    tar_observer* _observer;
+    tar_progress  _progress;
+    std::uint64_t _next_report;
 
-    auto abs_path = fs::canonical(directory);
-    for (auto item : fs::recursive_directory_iterator(abs_path)) {
-        auto relpath = item.path().lexically_relative(abs_path);
-        tar_writer.add_file(relpath.generic_string(), item.path());
+public:
+    explicit progress_tracker(tar_observer* obs) noexcept
+        : _observer(obs)
+        , _next_report(obs ? obs->progress_interval : 0) {}
+
+    tar_observer* observer() const noexcept { return _observer; }
+
+    void add_compressed(std::uint64_t n) noexcept { _progress.compressed_bytes += n; }
+
+    void add_uncompressed(std::uint64_t n) {
+        _progress.uncompressed_bytes += n;
+        if (_observer && _progress.uncompressed_bytes >= _next_report) {
+            report();
+        }
     }
 
-    tar_writer.finish();
-    gz_out.finish();
+    void member_done() noexcept { ++_progress.members_done; }
+
+    void report() {
+        if (_observer) {
+            _observer->on_progress(_progress);
+            _next_report = _progress.uncompressed_bytes + _observer->progress_interval;
+        }
+    }
+};
+
+/// A buffer_sink that reports the number of bytes committed through it
+template <buffer_sink Sink, typename OnCommit>
+class counting_sink {
+    [[no_unique_address]] wrap_refs_t<Sink> _sink;
+    OnCommit                                _on_commit;
+
+public:
+    counting_sink(Sink&& s, OnCommit fn)
+        : _sink(NEO_FWD(s))
+        , _on_commit(fn) {}
+
+    NEO_DECL_UNREF_GETTER(sink, _sink);
+
+    decltype(auto) prepare(std::size_t n) { return sink().prepare(n); }
+
+    void commit(std::size_t n) {
+        sink().commit(n);
+        _on_commit(n);
+    }
+};
+
+template <typename S, typename F>
+counting_sink(S&&, F) -> counting_sink<S, F>;
+
+/// A buffer_source that reports the number of bytes consumed from it
+template <buffer_source Source, typename OnConsume>
+class counting_source {
+    [[no_unique_address]] wrap_refs_t<Source> _source;
+    OnConsume                                 _on_consume;
+
+public:
+    counting_source(Source&& s, OnConsume fn)
+        : _source(NEO_FWD(s))
+        , _on_consume(fn) {}
+
+    NEO_DECL_UNREF_GETTER(source, _source);
+
+    decltype(auto) next(std::size_t n) { return source().next(n); }
+
+    void consume(std::size_t n) {
+        source().consume(n);
+        _on_consume(n);
+    }
+};
+
+template <typename S, typename F>
+counting_source(S&&, F) -> counting_source<S, F>;
+
+/// An archive member that has been prepared by a reader thread
+struct prefetched_member {
+    fs::path          path;
+    ustar_member_info info{};
+    /// The member data, if the file was small enough to read ahead of the writer
+    std::optional<std::vector<std::byte>> data{};
+    tar_observer::duration                open_time{};
+    tar_observer::duration                read_time{};
+    tar_observer::duration                close_time{};
+};
+
+/**
+ * Create the header for the given file, and read its data if it is a regular
+ * file of at most `max_size` bytes. This runs on a reader thread: The observer
+ * is only used to decide whether to time the work, and is never called.
+ */
+prefetched_member prefetch_member(const std::string& dest,
+                                  fs::path           filepath,
+                                  std::size_t        max_size,
+                                  tar_observer*      observer) {
+    prefetched_member ret{.path = std::move(filepath)};
+    ret.info = detail::make_ustar_member_info(dest, ret.path);
+    if (!ret.info.is_regular_file() || ret.info.size > max_size) {
+        return ret;
+    }
+
+    std::ifstream infile;
+    infile.exceptions(infile.exceptions() | std::ios::badbit);
+    detail::observe_time(observer, ret.open_time, [&] {
+        infile.open(ret.path, std::ios::binary);
+    });
+    auto&      data   = ret.data.emplace(static_cast<std::size_t>(ret.info.size));
+    const auto n_read = detail::observe_time(observer, ret.read_time, [&] {
+        return buffer_ios_read(infile, as_buffer(data));
+    });
+    detail::observe_time(observer, ret.close_time, [&] { infile.close(); });
+    if (n_read != data.size()) {
+        throw std::runtime_error(ufmt("File [{}] changed size while it was being archived",
+                                      ret.path.string()));
+    }
+    return ret;
 }
 
-/// XXX: Does not yet restore mtime/ownership
-void neo::expand_directory_targz(const expand_options& opts, const fs::path& targz_source) {
-    std::ifstream in;
-    in.exceptions(in.exceptions() | std::ios::badbit);
-    in.open(targz_source, std::ios::binary);
+/// Write a member that was prepared by prefetch_member()
+template <typename TarWriter>
+void write_prefetched_member(TarWriter&         tar_writer,
+                             prefetched_member& mem,
+                             tar_observer*      observer) {
+    if (!mem.data) {
+        // Directories, links, and large files are written without any read-ahead
+        tar_writer.add_member(mem.info, mem.path, observer);
+        return;
+    }
 
-    if (opts.input_name.empty()) {
-        auto opts2       = opts;
-        auto in_name     = targz_source.string();
-        opts2.input_name = in_name;
-        expand_directory_targz(opts2, in);
+    tar_writer.write_member_header(mem.info);
+    if (observer) {
+        observer->on_member_header(mem.info);
+    }
+    tar_member_event event{
+        .info       = mem.info,
+        .path       = mem.path,
+        .data_bytes = mem.data->size(),
+        .open_time  = mem.open_time,
+        .read_time  = mem.read_time,
+        .close_time = mem.close_time,
+    };
+    detail::observe_time(observer, event.write_time, [&] {
+        tar_writer.write_member_data(const_buffer(as_buffer(*mem.data)));
+    });
+    tar_writer.finish_member();
+    if (observer) {
+        observer->on_member_done(event);
+    }
+}
+
+template <typename CompressSink>
+void archive_directory(const fs::path&         directory,
+                       CompressSink&           compressed_out,
+                       progress_tracker&       progress,
+                       const compress_options& opts) {
+    ustar_writer tar_writer{
+        counting_sink{compressed_out, [&](std::size_t n) { progress.add_uncompressed(n); }}};
+
+    auto abs_path = fs::canonical(directory);
+    if (opts.read_threads == 0) {
+        for (auto item : fs::recursive_directory_iterator(abs_path)) {
+            auto relpath = item.path().lexically_relative(abs_path);
+            tar_writer.add_file(relpath.generic_string(), item.path(), progress.observer());
+            progress.member_done();
+        }
     } else {
-        expand_directory_targz(opts, in);
+        // Readers open and read files in directory order, and the writer takes the results in the
+        // same order, so the archive is identical to one written without any readers.
+        detail::thread_pool pool{opts.read_threads};
+        // Keep enough files in-flight to hide the latency of opening them
+        const std::size_t max_in_flight = pool.size() * 16;
+        const std::size_t max_prefetch  = opts.read_ahead_bytes / max_in_flight;
+        const auto        observer      = progress.observer();
+
+        std::deque<std::future<prefetched_member>> in_flight;
+        auto                                       write_front = [&] {
+            auto mem = in_flight.front().get();
+            in_flight.pop_front();
+            write_prefetched_member(tar_writer, mem, observer);
+            progress.member_done();
+        };
+
+        for (auto item : fs::recursive_directory_iterator(abs_path)) {
+            auto relpath = item.path().lexically_relative(abs_path).generic_string();
+            auto job     = [relpath, path = item.path(), max_prefetch, observer] {
+                return prefetch_member(relpath, path, max_prefetch, observer);
+            };
+            in_flight.push_back(pool.submit(std::move(job)));
+            if (in_flight.size() >= max_in_flight) {
+                write_front();
+            }
+        }
+        while (!in_flight.empty()) {
+            write_front();
+        }
     }
+
+    tar_writer.finish();
+    compressed_out.finish();
+    progress.report();
 }
 
-void neo::expand_directory_targz(const expand_options& opts, std::istream& in) {
-    iostream_io  file_in{in};
-    gzip_source  gz_in{file_in};
-    ustar_reader tar_reader{gz_in};
+/**
+ * Create the file for an archive member, fill it by calling `write_data` with a
+ * sink for the file, then restore the file's permissions.
+ */
+template <typename WriteData>
+void extract_file(const fs::path&          file_dest,
+                  const ustar_member_info& meminfo,
+                  std::string_view         input_name,
+                  const fs::path&          partpath,
+                  tar_member_event&        event,
+                  tar_observer*            observer,
+                  WriteData&&              write_data) {
+    std::ofstream ofile;
+    ofile.exceptions(ofile.exceptions() | std::ios::badbit | std::ios::failbit);
+    errno = 0;
+    try {
+        detail::observe_time(observer, event.open_time, [&] {
+            ofile.open(file_dest, std::ios::binary);
+        });
+        neo::iostream_io data_sink{ofile};
+        write_data(data_sink);
+    } catch (const std::system_error& e) {
+        throw std::system_error(std::error_code(errno, std::generic_category()),
+                                neo::ufmt("Failure while extractive archive member to [{}]: {}",
+                                          file_dest.string(),
+                                          e.what()));
+    }
+    detail::observe_time(observer, event.close_time, [&] { ofile.close(); });
+    if constexpr (!neo::os_is_windows) {
+        detail::observe_time(observer, event.metadata_time, [&] {
+            restore_permissions(file_dest, meminfo, input_name, partpath);
+        });
+    }
+}
+
+/// A regular file member that has been read from the archive and is written by a writer thread
+struct pending_file {
+    ustar_member_info      info;
+    fs::path               path;
+    fs::path               partpath;
+    std::vector<std::byte> data;
+    tar_member_event       event{.info = info, .path = path};
+};
+
+/**
+ * Writes extracted files on a pool of threads, while the calling thread goes
+ * on decoding the archive. Observer events are delivered on the calling
+ * thread when the files are collected.
+ */
+class file_writer_pool {
+    struct in_flight_file {
+        std::shared_ptr<pending_file> file;
+        std::future<void>             done;
+    };
+
+    detail::thread_pool        _pool;
+    std::size_t                _max_in_flight;
+    std::size_t                _max_file_size;
+    std::deque<in_flight_file> _in_flight;
+
+public:
+    file_writer_pool(unsigned n_threads, std::size_t max_bytes)
+        : _pool(n_threads)
+        // Keep enough files in-flight to keep all of the writers busy
+        , _max_in_flight(_pool.size() * 16)
+        , _max_file_size(max_bytes / _max_in_flight) {}
+
+    ~file_writer_pool() {
+        // Don't let a writer outlive the data that it refers to
+        for (auto& f : _in_flight) {
+            f.done.wait();
+        }
+    }
 
-    auto& destination = opts.destination_directory;
+    /// Whether a file of the given size should be given to the pool
+    bool accepts(std::uint64_t size) const noexcept { return size <= _max_file_size; }
+
+    /// Whether any in-flight file will be written to the given path
+    bool is_pending(const fs::path& path) const noexcept {
+        return std::any_of(_in_flight.begin(), _in_flight.end(), [&](auto& f) {
+            return f.file->path == path;
+        });
+    }
+
+    void submit(std::shared_ptr<pending_file> file,
+                std::string_view              input_name,
+                progress_tracker&             progress) {
+        if (_in_flight.size() >= _max_in_flight) {
+            collect_front(progress);
+        }
+        auto job = [file, input_name, observer = progress.observer()] {
+            extract_file(file->path,
+                         file->info,
+                         input_name,
+                         file->partpath,
+                         file->event,
+                         observer,
+                         [&](auto& data_sink) {
+                             detail::observe_time(observer, file->event.write_time, [&] {
+                                 buffer_copy(data_sink, as_buffer(file->data));
+                             });
+                         });
+        };
+        auto done = _pool.submit(std::move(job));
+        _in_flight.push_back({std::move(file), std::move(done)});
+    }
+
+    /// Wait for the oldest in-flight file, and report it as done
+    void collect_front(progress_tracker& progress) {
+        auto front = std::move(_in_flight.front());
+        _in_flight.pop_front();
+        front.done.get();
+        if (progress.observer()) {
+            progress.observer()->on_member_done(front.file->event);
+        }
+        progress.member_done();
+    }
+
+    void collect_all(progress_tracker& progress) {
+        while (!_in_flight.empty()) {
+            collect_front(progress);
+        }
+    }
+};
+
+/// XXX: Does not yet restore mtime/ownership
+template <typename Source>
+void expand_archive(const expand_options& opts,
+                    Source&&              decompressed_in,
+                    progress_tracker&     progress) {
+    ustar_reader tar_reader{
+        counting_source{decompressed_in, [&](std::size_t n) { progress.add_uncompressed(n); }}};
+
+    auto&      destination = opts.destination_directory;
+    const auto observer    = progress.observer();
+
+    std::optional<file_writer_pool> writers;
+    if (opts.write_threads != 0) {
+        writers.emplace(opts.write_threads, opts.write_behind_bytes);
+    }
 
     for (const auto& meminfo : tar_reader) {
+        if (observer) {
+            observer->on_member_header(meminfo);
+        }
+
         fs::path filepath = meminfo.filename_str();
         if (!meminfo.prefix_str().empty()) {
             filepath = meminfo.prefix_str() / filepath;
@@ -139,31 +463,75 @@ void neo::expand_directory_targz(const expand_options& opts, std::istream& in) {
                                          std::divides{});
         auto file_dest     = (destination / stripped_path).lexically_normal();
 
+        if (writers) {
+            // Links may refer to any earlier member, and a member may replace an earlier one, so
+            // those must wait for the files that are still being written.
+            if (meminfo.is_symlink() || meminfo.is_link() || writers->is_pending(file_dest)) {
+                writers->collect_all(progress);
+            }
+            if (meminfo.is_file() && writers->accepts(meminfo.size)) {
+                auto file      = std::make_shared<pending_file>();
+                file->info     = meminfo;
+                file->path     = file_dest;
+                file->partpath = norm;
+                file->data.resize(static_cast<std::size_t>(meminfo.size));
+                auto dest = as_buffer(file->data);
+                while (dest) {
+                    // Decompression happens as the data is read
+                    auto part = detail::observe_time(observer, file->event.read_time, [&] {
+                        return tar_reader.next(dest.size());
+                    });
+                    const auto n = buffer_copy(dest, part);
+                    if (n == 0) {
+                        throw std::runtime_error(
+                            ufmt("Archive [{}] ended in the middle of the data for member [{}]",
+                                 opts.input_name,
+                                 filepath.string()));
+                    }
+                    tar_reader.consume(n);
+                    dest += n;
+                }
+                file->event.data_bytes = file->data.size();
+                writers->submit(std::move(file), opts.input_name, progress);
+                continue;
+            }
+        }
+
+        tar_member_event event{.info = meminfo, .path = file_dest};
         if (meminfo.is_directory()) {
-            fs::create_directory(file_dest);
+            detail::observe_time(observer, event.metadata_time, [&] {
+                fs::create_directory(file_dest);
+            });
+            if (observer) {
+                observer->on_directory_created(file_dest, event.metadata_time);
+            }
         } else if (meminfo.is_symlink()) {
-            fs::create_symlink(meminfo.linkname_str(), file_dest);
+            detail::observe_time(observer, event.metadata_time, [&] {
+                fs::create_symlink(meminfo.linkname_str(), file_dest);
+            });
         } else if (meminfo.is_link()) {
-            fs::create_hard_link(meminfo.linkname_str(), file_dest);
+            detail::observe_time(observer, event.metadata_time, [&] {
+                fs::create_hard_link(meminfo.linkname_str(), file_dest);
+            });
         } else if (meminfo.is_file()) {
-            std::ofstream ofile;
-            ofile.exceptions(ofile.exceptions() | std::ios::badbit | std::ios::failbit);
-            errno = 0;
-            try {
-                ofile.open(file_dest, std::ios::binary);
-                neo::iostream_io data_sink{ofile};
-                buffer_copy(data_sink, tar_reader.all_data());
-            } catch (const std::system_error& e) {
-                throw std::
-                    system_error(std::error_code(errno, std::generic_category()),
-                                 neo::ufmt("Failure while extractive archive member to [{}]: {}",
-                                           file_dest.string(),
-                                           e.what()));
-            }
-            ofile.close();
-            if constexpr (!neo::os_is_windows) {
-                restore_permissions(file_dest, meminfo, opts.input_name, norm);
-            }
+            auto copy_data = [&](auto& data_sink) {
+                while (true) {
+                    // Decompression happens as the data is read
+                    auto part = detail::observe_time(observer, event.read_time, [&] {
+                        return tar_reader.next(1024 * 1024);
+                    });
+                    const auto n = buffer_size(part);
+                    if (n == 0) {
+                        break;
+                    }
+                    detail::observe_time(observer, event.write_time, [&] {
+                        buffer_copy(data_sink, part);
+                    });
+                    tar_reader.consume(n);
+                    event.data_bytes += n;
+                }
+            };
+            extract_file(file_dest, meminfo, opts.input_name, norm, event, observer, copy_data);
         } else if (meminfo.typeflag == ustar_member_info::type_t::pax_extended_record
                    || meminfo.typeflag == ustar_member_info::type_t::pax_global_record) {
             // TODO: We don't handle pax headers anything special yet.
@@ -175,5 +543,103 @@ void neo::expand_directory_targz(const expand_options& opts, std::istream& in) {
                           filepath.string(),
                           char(meminfo.typeflag)));
         }
+
+        if (observer) {
+            observer->on_member_done(event);
+        }
+        progress.member_done();
+    }
+    if (writers) {
+        writers->collect_all(progress);
     }
+    progress.report();
+}
+
+/// Open the file, and name it in the options if the application did not give a name
+template <typename Func>
+void with_input_file(const expand_options& opts, const fs::path& file, Func&& fn) {
+    std::ifstream in;
+    in.exceptions(in.exceptions() | std::ios::badbit);
+    in.open(file, std::ios::binary);
+
+    if (opts.input_name.empty()) {
+        auto opts2       = opts;
+        auto in_name     = file.string();
+        opts2.input_name = in_name;
+        fn(opts2, in);
+    } else {
+        fn(opts, in);
+    }
+}
+
+}  // namespace
+
+void neo::compress_directory_targz(const fs::path&         directory,
+                                   const fs::path&         targz_dest,
+                                   const compress_options& opts) {
+    // Open the file for writing:
+    std::ofstream out;
+    out.exceptions(out.exceptions() | std::ios::badbit | std::ios::failbit);
+    out.open(targz_dest, std::ios::binary);
+
+    progress_tracker progress{opts.observer};
+    auto             file_out
+        = counting_sink{iostream_io{out}, [&](std::size_t n) { progress.add_compressed(n); }};
+
+    // Compression pipeline:
+    if (opts.thread_count == 1) {
+        gzip_sink gz_out{std::move(file_out), opts.deflate};
+        archive_directory(directory, gz_out, progress, opts);
+    } else {
+        parallel_gzip_sink gz_out{std::move(file_out),
+                                  parallel_gzip_options{
+                                      .deflate      = opts.deflate,
+                                      .thread_count = opts.thread_count,
+                                  }};
+        archive_directory(directory, gz_out, progress, opts);
+    }
+}
+
+void neo::expand_directory_targz(const expand_options& opts, const fs::path& targz_source) {
+    with_input_file(opts, targz_source, [](const expand_options& named, std::istream& in) {
+        expand_directory_targz(named, in);
+    });
+}
+
+void neo::expand_directory_targz(const expand_options& opts, std::istream& in) {
+    progress_tracker progress{opts.observer};
+    gzip_source      gz_in{
+        counting_source{iostream_io{in}, [&](std::size_t n) { progress.add_compressed(n); }}};
+    expand_archive(opts, gz_in, progress);
+}
+
+void neo::compress_directory_tarzst(const fs::path&         directory,
+                                    const fs::path&         tarzst_dest,
+                                    const compress_options& opts) {
+    std::ofstream out;
+    out.exceptions(out.exceptions() | std::ios::badbit | std::ios::failbit);
+    out.open(tarzst_dest, std::ios::binary);
+
+    progress_tracker progress{opts.observer};
+    auto             file_out
+        = counting_sink{iostream_io{out}, [&](std::size_t n) { progress.add_compressed(n); }};
+
+    // zstd does its own multithreading, as given in the options
+    zstd_sink zst_out{std::move(file_out), opts.zstd};
+    archive_directory(directory, zst_out, progress, opts);
+}
+
+void neo::expand_directory_tarzst(const expand_options& opts, const fs::path& tarzst_source) {
+    with_input_file(opts, tarzst_source, [](const expand_options& named, std::istream& in) {
+        expand_directory_tarzst(named, in);
+    });
+}
+
+void neo::expand_directory_tarzst(const expand_options& opts, std::istream& in) {
+    progress_tracker progress{opts.observer};
+    // zstd permits a file of several concatenated frames
+    zstd_source zst_in{counting_source{iostream_io{in},
+                                       [&](std::size_t n) { progress.add_compressed(n); }},
+                       zstd_decompress_options{.multi_frame = true}};
+    expand_archive(opts, zst_in, progress);
 }
@@ -1,18 +1,81 @@
 #pragma once
 
+#include "../deflate.hpp"
+#include "../zstd.hpp"
+#include "./observer.hpp"
+
+#include <cstddef>
 #include <filesystem>
 #include <iosfwd>
 #include <string_view>
 
 namespace neo {
 
+struct compress_options {
+    /// Parameters for the DEFLATE compressor
+    deflate_options deflate = {};
+    /// Parameters for the Zstandard compressor, used by compress_directory_tarzst()
+    zstd_options zstd = {};
+    /**
+     * The number of threads to use for DEFLATE compression. If one, compression
+     * is done on the calling thread. If zero, uses the number of hardware
+     * threads. Zstandard compression uses `zstd.thread_count` instead.
+     */
+    unsigned thread_count = 1;
+    /**
+     * The number of threads that open and read files ahead of the archive
+     * writer. If zero, files are read on the calling thread as they are
+     * written. The archive is the same either way.
+     */
+    unsigned read_threads = 0;
+    /**
+     * The most file data to hold in memory ahead of the archive writer when
+     * `read_threads` is non-zero. Files that are too large to be read ahead are
+     * read by the writer.
+     */
+    std::size_t read_ahead_bytes = 1024 * 1024 * 64;
+    /// An optional observer that receives the events of the pipeline
+    tar_observer* observer = nullptr;
+};
+
 void compress_directory_targz(const std::filesystem::path& directory,
-                              const std::filesystem::path& targz_destination);
+                              const std::filesystem::path& targz_destination,
+                              const compress_options&      opts);
+
+inline void compress_directory_targz(const std::filesystem::path& directory,
+                                     const std::filesystem::path& targz_destination,
+                                     const deflate_options&       opts) {
+    return compress_directory_targz(directory,
+                                    targz_destination,
+                                    compress_options{.deflate = opts});
+}
+
+inline void compress_directory_targz(const std::filesystem::path& directory,
+                                     const std::filesystem::path& targz_destination) {
+    return compress_directory_targz(directory, targz_destination, compress_options());
+}
 
 struct expand_options {
     std::filesystem::path destination_directory;
     std::string_view      input_name;
     unsigned              strip_components = 0;
+    /**
+     * The number of threads that create and write the extracted files. If
+     * zero, files are written on the calling thread as they are decoded. The
+     * decoding is always done on the calling thread.
+     */
+    unsigned write_threads = 0;
+    /**
+     * The most file data to hold in memory for the writer threads when
+     * `write_threads` is non-zero. Files that are too large to be handed off
+     * are written by the calling thread.
+     */
+    std::size_t write_behind_bytes = 1024 * 1024 * 64;
+    /**
+     * An optional observer that receives the events of the pipeline. With
+     * `write_threads`, members may be reported done out of archive order.
+     */
+    tar_observer* observer = nullptr;
 };
 
 void expand_directory_targz(const expand_options& opts, std::istream& input);
@@ -29,4 +92,35 @@ inline void expand_directory_targz(const std::filesystem::path& destination,
         targz_input);
 }
 
+void compress_directory_tarzst(const std::filesystem::path& directory,
+                               const std::filesystem::path& tarzst_destination,
+                               const compress_options&      opts);
+
+inline void compress_directory_tarzst(const std::filesystem::path& directory,
+                                      const std::filesystem::path& tarzst_destination,
+                                      const zstd_options&          opts) {
+    return compress_directory_tarzst(directory,
+                                     tarzst_destination,
+                                     compress_options{.zstd = opts});
+}
+
+inline void compress_directory_tarzst(const std::filesystem::path& directory,
+                                      const std::filesystem::path& tarzst_destination) {
+    return compress_directory_tarzst(directory, tarzst_destination, compress_options());
+}
+
+void expand_directory_tarzst(const expand_options& opts, std::istream& input);
+
+void expand_directory_tarzst(const expand_options& opts, const std::filesystem::path& tarzst_input);
+
+inline void expand_directory_tarzst(const std::filesystem::path& destination,
+                                    const std::filesystem::path& tarzst_input) {
+    return expand_directory_tarzst(
+        expand_options{
+            .destination_directory = destination,
+            .input_name            = tarzst_input.string(),
+        },
+        tarzst_input);
+}
+
 }  // namespace neo
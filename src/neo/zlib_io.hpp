@@ -0,0 +1,100 @@
+#pragma once
+
+#include "./deflate.hpp"
+#include "./inflate.hpp"
+#include "./zlib.hpp"
+
+#include <neo/buffer_sink.hpp>
+#include <neo/buffer_source.hpp>
+#include <neo/transform_io.hpp>
+
+namespace neo {
+
+/**
+ * @brief Adapt a buffer_sink with zlib-format compression.
+ *
+ * @tparam Sink The underlying buffer sink (A file, socket, etc.)
+ */
+template <buffer_sink Sink>
+class zlib_sink : public buffer_transform_sink<Sink, zlib_compressor<deflate_compressor>> {
+public:
+    explicit zlib_sink(Sink&& out)
+        : zlib_sink::buffer_transform_sink{NEO_FWD(out), {}} {}
+
+    zlib_sink(Sink&& out, const deflate_options& opts)
+        : zlib_sink::buffer_transform_sink{NEO_FWD(out),
+                                           zlib_compressor{deflate_compressor{opts}}} {}
+
+    /**
+     * @brief Flush all data written so far through to the underlying sink, so
+     * that it can be decoded by a reader without waiting for more data.
+     *
+     * @returns The number of bytes written to the underlying sink.
+     */
+    std::size_t flush(neo::flush mode = neo::flush::sync) {
+        return buffer_transform(this->transformer(), this->sink(), const_buffer(), mode)
+            .bytes_written;
+    }
+
+    std::size_t finish() {
+        return buffer_transform(this->transformer(),
+                                this->sink(),
+                                const_buffer(),
+                                neo::flush::finish)
+            .bytes_written;
+    }
+};
+
+template <buffer_sink S>
+explicit zlib_sink(S &&) -> zlib_sink<S>;
+
+template <buffer_sink S>
+zlib_sink(S&&, const deflate_options&) -> zlib_sink<S>;
+
+/**
+ * @brief Adapt a buffer_source with zlib-format decompression.
+ *
+ * @tparam Source The underlying buffer source (A file, socket, etc.)
+ */
+template <buffer_source Source>
+class zlib_source
+    : public buffer_transform_source<Source, zlib_decompressor<inflate_decompressor>> {
+public:
+    explicit zlib_source(Source&& in, const zlib_decompress_options& opts = {})
+        : zlib_source::buffer_transform_source{NEO_FWD(in),
+                                               zlib_decompressor<inflate_decompressor>{opts}} {}
+};
+
+template <buffer_source S>
+explicit zlib_source(S &&) -> zlib_source<S>;
+
+template <buffer_source S>
+zlib_source(S&&, const zlib_decompress_options&) -> zlib_source<S>;
+
+/**
+ * @brief Compress the given input and write it as a zlib stream to the given output.
+ *
+ * @returns the number of bytes written to the output.
+ */
+template <buffer_output Out, buffer_input In>
+std::size_t zlib_compress(Out&& out, In&& in, const deflate_options& opts = {}) {
+    zlib_sink z_out{ensure_buffer_sink(out), opts};
+    auto      n = buffer_copy(z_out, in);
+    n += z_out.finish();
+    return n;
+}
+
+/**
+ * @brief Decompress the given zlib-format input, and write the decompressed data to the given
+ * output.
+ *
+ * @returns The number of bytes written to the output.
+ */
+template <buffer_output Out, buffer_input In>
+std::size_t zlib_decompress(Out&& out, In&& in, const zlib_decompress_options& opts = {}) {
+    zlib_source z_in{ensure_buffer_source(in), opts};
+    auto        n = buffer_copy(out, z_in);
+    return n;
+}
+
+}  // namespace neo